@@ -23,17 +23,35 @@
 #ifndef _DoCAN
 #define _DoCAN
 
-#include <windows.h>
 #include <iostream>
 #include <stdio.h>
 #include <stdint.h>
+#include <string.h>
 #include <cstdio>
 #include <iomanip>
-#include "DriverPCAN.hpp"
+#include "DriverCAN.hpp"
+#include "FrameRing.hpp"
+#if defined(DoCAN_OnSocketCAN)
+  #include "DriverSocketCAN.hpp"
+  using DoCANDriver = DriverSocketCAN;
+#elif defined(DoCAN_OnLoopback)
+  #include "DriverLoopback.hpp"
+  using DoCANDriver = DriverLoopback;
+#else
+  #include "DriverPCAN.hpp"
+  using DoCANDriver = DriverPCAN;
+#endif
 #include "UDS.hpp"
 #include <chrono>
-
-using Clock = std::chrono::steady_clock;
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#ifdef __linux__
+  #include <time.h>
+  #include <errno.h>
+  #include <sys/prctl.h>
+#endif
 
 #define DoCAN_ERR_FRAMEOK                 0
 #define DoCAN_ERR_FRAMEISSUE              1
@@ -42,12 +60,34 @@ using Clock = std::chrono::steady_clock;
 #define DoCAN_ERR_WRONGFRAMECOUNTER       4
 #define DoCAN_ERR_DRIVERFAILER            5
 #define DoCAN_ERR_INTERNALISSUE           6
+#define DoCAN_ERR_TIMEOUT                 7
+#define DoCAN_ERR_ABORTED                 8
+#define DoCAN_ERR_WAITLIMIT               9
 
 #define DoCAN_RX_WORKING                  0
 #define DoCAN_RX_IDLE                     1
 #define DoCAN_RX_COMPLETE                 2
 #define DoCAN_RX_ERROR                    3
 
+#define DoCAN_TX_WORKING                  0
+#define DoCAN_TX_IDLE                     1
+#define DoCAN_TX_COMPLETE                 2
+#define DoCAN_TX_ERROR                    3
+
+#define DoCAN_KBPS_DEFAULT                500     // Bit Rate Start Opens the Driver With
+#define DoCAN_N_BS                        1000000
+#define DoCAN_N_AS                        1000000
+#define DoCAN_N_WFTMAX                    10
+#define DoCAN_TX_BATCH                    64
+#define DoCAN_TX_RETRY                    100
+
+#define DoCAN_TIMER_MARGIN                100
+#define DoCAN_TIMER_MARGIN_MIN            20
+#define DoCAN_TIMER_MARGIN_MAX            500
+
+#define DoCAN_RING_DEPTH                  1024
+#define DoCAN_READER_POLL                 10000
+
 
 
 /* ==================================================================================================== */
@@ -60,15 +100,15 @@ class ISO_DoCAN {
 
   protected :
 
-    std::chrono::_V2::steady_clock::time_point StartTime;
-    DriverPCAN PCAN;
-
-    struct DoCANMESSAGE {
-      uint32_t ID;
-      uint8_t LEN;
-      uint8_t TYPE;
-      uint8_t DATA[8];
-    }; DoCANMESSAGE MESSAGE;
+    static inline uint64_t (*VirtualNow)(void) = nullptr;
+    static inline void (*VirtualWait)(uint64_t Time) = nullptr;
+    std::unique_ptr<DoCANDriver> DRIVER;       // Built-In Backend, Built by Start Only When None Was Injected
+    DriverCAN * CAN;
+    FrameRing<DoCAN_RING_DEPTH> RING;
+    std::thread READER;
+    std::atomic<uint8_t> READING;
+    std::atomic<uint64_t> READ;
+    std::atomic<uint8_t> ABORT;
 
     enum DoCANStatus {
       DoCAN_Idle = 0,
@@ -92,8 +132,13 @@ class ISO_DoCAN {
       uint16_t * LEN;
       uint32_t * ID;
       uint16_t LENGTH;
+      const char * BITRATE_FD;                  // CAN FD Bit Rate of the Driver, nullptr For Classic CAN
+      uint8_t TX_DL;                            // Transmit Frame Length of FF and CF, 8 on Classic CAN
+      uint8_t FLAGS;                            // DriverCAN_FD / DriverCAN_BRS of Every Frame Sent
       uint64_t P2;
       uint64_t P2_Star;
+      uint64_t N_BS;
+      uint64_t N_AS;
       uint8_t ERRORCODE;
       uint8_t INIT;
     }; DoCANCONFIGURATION CONFIG;
@@ -105,7 +150,8 @@ class ISO_DoCAN {
       uint64_t STMIN;
       uint8_t BLOCKS;
       uint8_t TXFLAG;
-
+      uint16_t WFT;                             // FC.WAIT Received Since the FF or the Last CTS
+      uint16_t WFT_MAX;                         // N_WFTmax, More FC.WAIT in a Row Fail the Transfer
     }; DoCANSETTINGTX SETTINGS_TX;
 
     struct DoCANSETTINGRX {
@@ -117,52 +163,108 @@ class ISO_DoCAN {
       uint16_t COUNTER;
       uint8_t BLOCKCOUNTER;
       uint16_t INDEX;
+      uint8_t DL;                               // RX_DL, Frame Length of the First Frame
+      uint8_t * DATA;                           // Destination of the Receive Running Now
+      uint16_t SIZE;
+      uint16_t * LEN;
       uint8_t RXFLAG;
     }; DoCANSETTINGRX SETTINGS_RX;
 
     void FrameTX_FC (uint8_t FS);
 
-    void FrameRX_FC (void);
-    void FrameRX_SF (void);
-    void FrameRX_FF (void);
-    void FrameRX_CF (void);
-    void DoCAN_RX (void);
+    void FrameRX_FC (const DriverCAN::FRAME &Frame);
+    void FrameRX_SF (const DriverCAN::FRAME &Frame);
+    void FrameRX_FF (const DriverCAN::FRAME &Frame);
+    void FrameRX_CF (const DriverCAN::FRAME &Frame);
+    void DoCAN_RX (const DriverCAN::FRAME &Frame);
+    void ReaderLoop (void);
+    const DriverCAN::FRAME * ReadFrame (DriverCAN::FRAME &Spare, uint64_t Timeout);
+    uint8_t Await (uint8_t Mode, uint8_t Time);
 
 
     
-    void DoCAN_TX (void);
+    uint8_t DoCAN_TX (const uint8_t * Data, uint16_t LEN);
+
+  public :
+
+    struct DoCANTIMER {
+      uint64_t WAITS;                           // Precision Waits Done
+      uint64_t SLEEPS;                          // Waits That Slept in the OS Before Spinning
+      uint64_t LATE;                            // Average OS Wake Up Lateness in MicroSeconds
+      uint64_t MARGIN;                          // Time Left to Spin After the OS Sleep in MicroSeconds
+      uint64_t SPIN_TOTAL;                      // MicroSeconds Spent Spinning
+      uint64_t OVERSHOOT_TOTAL;                 // MicroSeconds Past the Deadline, Summed
+      uint64_t OVERSHOOT_MAX;                   // MicroSeconds Past the Deadline, Worst
+    };
+
+    struct DoCANREADER {
+      uint8_t RUNNING;                          // Reader Thread Feeding the Ring
+      uint64_t FRAMES;                          // Frames Read From the Driver
+      uint64_t DROPPED;                         // Frames Lost to a Full Ring
+      uint32_t QUEUED;                          // Frames Waiting in the Ring Now
+      uint32_t PEAK;                            // Most Frames Ever Waiting in the Ring
+    };
+
+  protected :
+
+    DoCANTIMER TIMER;
+    std::mutex TIMER_LOCK;
 
   public :
 
     ISO_DoCAN (void) {
-      StartTime = Clock::now();
+      CAN = nullptr;
+      READING = 0; READ = 0; ABORT = 0;
       cout << "\nDoCAN Driver Loaded";
       CONFIG.PADDING = 0x00; CONFIG.STMIN = 0x00; CONFIG.BLOCKS = 0x00; CONFIG.LENGTH = 4095;
+      CONFIG.DATA = nullptr; CONFIG.LEN = nullptr; CONFIG.ID = nullptr;
+      SETTINGS_RX.DATA = nullptr; SETTINGS_RX.SIZE = 0; SETTINGS_RX.LEN = nullptr;
+      CONFIG.BITRATE_FD = nullptr; CONFIG.TX_DL = DriverCAN_LENGTH_CLASSIC; CONFIG.FLAGS = DriverCAN_CLASSIC;
       SETTINGS_RX.RXFLAG = 1; SETTINGS_TX.TXFLAG = 1;
       SETTINGS_RX.INDEX = 0; SETTINGS_RX.BLOCKCOUNTER = 0; SETTINGS_RX.COUNTER = 0; SETTINGS_RX.FRAMES = 0;
-      SETTINGS_RX.MODE = 0;
+      SETTINGS_RX.MODE = 0; SETTINGS_RX.DL = DriverCAN_LENGTH_CLASSIC;
       CONFIG.ERRORCODE = 0;
+      CONFIG.N_BS = DoCAN_N_BS; CONFIG.N_AS = DoCAN_N_AS;
+      TIMER = {}; TIMER.MARGIN = DoCAN_TIMER_MARGIN;
+      SETTINGS_TX.BLOCKS = 0; SETTINGS_TX.STMIN = 0; SETTINGS_TX.STATUS = DoCAN_Idle;
+      SETTINGS_TX.WFT = 0; SETTINGS_TX.WFT_MAX = DoCAN_N_WFTMAX;
       SETTINGS_RX.STATUS = DoCAN_Idle;
       CONFIG.INIT = 0x00;
     }
     ~ISO_DoCAN (void) {
+      StopReader();
       cout << "\nDoCAN Driver Unloaded";
     }
 
     void SetCANID (uint32_t ID_TX, uint32_t ID_RX, uint32_t ID_FN);
     void SetBuffer (uint32_t * ID, uint16_t * Len, uint8_t * Data);
     void SetTiming (uint64_t P2, uint64_t P2_Star);
+    void SetWaitLimit (uint16_t N_WFTmax);
     void SetUDSParameter (uint8_t Padding, uint32_t STMin, uint8_t Block, uint16_t Length);
+    void SetDriver (DriverCAN * Driver);
+    uint8_t SetFD (const char * BitRate, uint8_t TX_DL = DriverCAN_LENGTH_FD, uint8_t BRS = 1);
     void Start (void);
+    uint8_t SetBaudrate (uint16_t KBPS);
+    uint8_t StartReader (void);
+    void StopReader (void);
+    DoCANREADER ReaderStats (void);
 
+    static void SetVirtualClock (uint64_t (*Now)(void), void (*Wait)(uint64_t Time));
     uint64_t Clock (uint8_t Mode = 0);
     uint64_t MicroClock (void);
     uint64_t MilliClock (void);
     void Delay (uint64_t Time, uint8_t Mode = 0);
     void MilliDelay (uint64_t Time);
     void MicroDelay (uint64_t Time);
+    void WaitUntil (uint64_t Deadline);
+    DoCANTIMER TimerStats (void);
+    uint8_t ErrorCode (void) { return CONFIG.ERRORCODE; }
 
     uint8_t Receive (uint8_t Mode = 0, uint8_t Time = 0);
+    uint8_t Receive (uint8_t * Data, uint16_t Size, uint16_t &Length, uint8_t Time = 0);
+    uint8_t Transmit (uint8_t Mode = 0);
+    uint8_t Transmit (const uint8_t * Data, uint16_t Length, uint8_t Mode = 0);
+    void Abort (uint8_t Set = 1);
 
     
 
@@ -175,19 +277,26 @@ class ISO_DoCAN {
  * @name        FrameRX_FC
  * @class       ISO_DoCAN (Private)
  * @brief       Receive Flow Control Frame
- * @param []    Nothing
+ * @param [Frame]     Received Frame, Decoded Where It Lies
  * @return      Nothing
  */
 /* ---------------------------------------------------------------------------------------------------- */
-void ISO_DoCAN::FrameRX_FC (void) {
+void ISO_DoCAN::FrameRX_FC (const DriverCAN::FRAME &Frame) {
   if ((SETTINGS_RX.STATUS == DoCAN_Wait)) {
-    uint8_t FS = MESSAGE.DATA[0] & 0x0F;
+    uint8_t FS = Frame.DATA[0] & 0x0F;
     switch (FS) {
         case 0 : { // FS : Continue To Send (CTS)
+          SETTINGS_TX.WFT = 0;
           SETTINGS_RX.STATUS = DoCAN_Transmit;
           break;
         }
         case 1 : { // FS = Wait (WT)
+          if (++SETTINGS_TX.WFT > SETTINGS_TX.WFT_MAX) {
+            CONFIG.ERRORCODE = DoCAN_ERR_WAITLIMIT;
+            SETTINGS_RX.STATUS = DoCAN_Idle;
+            SETTINGS_RX.RXFLAG = DoCAN_RX_ERROR;
+            return;
+          }
           SETTINGS_RX.STATUS = DoCAN_Wait;
           SETTINGS_RX.TIME = MicroClock();
           return;
@@ -205,20 +314,18 @@ void ISO_DoCAN::FrameRX_FC (void) {
           return;
         }
     }
-    CONFIG.BLOCKS = MESSAGE.DATA[1];
-    if ( MESSAGE.DATA[2] <= 0x7F ) {
-      SETTINGS_TX.STMIN = MESSAGE.DATA[2] * 1000;
-      SETTINGS_TX.TIME = MicroClock();
-      SETTINGS_RX.RXFLAG = DoCAN_RX_COMPLETE;
-    } else if (( MESSAGE.DATA[2] <= 0xF9 ) && ( MESSAGE.DATA[2] >= 0xF1 )) {
-      SETTINGS_TX.STMIN = (MESSAGE.DATA[2] & 0x0F) * 100;
-      SETTINGS_TX.TIME = MicroClock();
-      SETTINGS_RX.RXFLAG = DoCAN_RX_COMPLETE;
+    SETTINGS_TX.BLOCKS = Frame.DATA[1];
+    if ( Frame.DATA[2] <= 0x7F ) {
+      SETTINGS_TX.STMIN = Frame.DATA[2] * 1000;
+    } else if (( Frame.DATA[2] <= 0xF9 ) && ( Frame.DATA[2] >= 0xF1 )) {
+      SETTINGS_TX.STMIN = (Frame.DATA[2] & 0x0F) * 100;
     } else {
-      CONFIG.ERRORCODE = DoCAN_ERR_FRAMEISSUE;
-      SETTINGS_RX.STATUS = DoCAN_Idle;
-      SETTINGS_RX.RXFLAG = DoCAN_RX_ERROR;
-    } return;
+      SETTINGS_TX.STMIN = 0x7F * 1000;        // Reserved STmin Is Taken as 127 ms (ISO 15765-2)
+    }
+    SETTINGS_TX.TIME = MicroClock();
+    SETTINGS_RX.STATUS = DoCAN_Idle;
+    SETTINGS_RX.RXFLAG = DoCAN_RX_COMPLETE;
+    return;
   }
   else {
     CONFIG.ERRORCODE = DoCAN_ERR_FRAMEISSUE;
@@ -233,20 +340,25 @@ void ISO_DoCAN::FrameRX_FC (void) {
 /**
  * @name        FrameRX_SF
  * @class       ISO_DoCAN (Private)
- * @brief       Receive Single Frame
- * @param []    Nothing
+ * @brief       Receive Single Frame, on CAN FD Frames Above 8 Bytes SF_DL May Follow an Escape Byte
+ * @param [Frame]     Received Frame, Decoded Where It Lies
  * @return      Nothing
  */
 /* ---------------------------------------------------------------------------------------------------- */
-void ISO_DoCAN::FrameRX_SF (void) {
+void ISO_DoCAN::FrameRX_SF (const DriverCAN::FRAME &Frame) {
   if (SETTINGS_RX.STATUS == DoCAN_Receive) {
-    uint8_t LEN = MESSAGE.DATA[0] & 0x0F;
-    if ( LEN <= 7 ) {
-      *CONFIG.LEN = LEN;
-      *CONFIG.ID = MESSAGE.ID;
-      for (uint8_t I = 0; I < LEN; I++) {
-        CONFIG.DATA[I] = MESSAGE.DATA[ I + 1 ];
+    uint8_t LEN = Frame.DATA[0] & 0x0F;
+    uint8_t PCI = 1;
+    if ( (LEN == 0) && (Frame.LEN > DriverCAN_LENGTH_CLASSIC) ) {
+      LEN = Frame.DATA[1];
+      PCI = 2;
+    }
+    if ( ((LEN + PCI) <= Frame.LEN) && (LEN <= SETTINGS_RX.SIZE) ) {
+      *SETTINGS_RX.LEN = LEN;
+      if (CONFIG.ID) {
+        *CONFIG.ID = Frame.ID;
       }
+      memcpy(SETTINGS_RX.DATA, &Frame.DATA[PCI], LEN);
       SETTINGS_RX.TIME = MicroClock();
       SETTINGS_RX.RXFLAG = DoCAN_RX_COMPLETE;
       SETTINGS_RX.STATUS = DoCAN_Idle;
@@ -271,28 +383,42 @@ void ISO_DoCAN::FrameRX_SF (void) {
 /**
  * @name        FrameRX_FF
  * @class       ISO_DoCAN (Private)
- * @brief       Receive First Frame
- * @param []    Nothing
+ * @brief       Receive First Frame, a 12 Bit FF_DL of Zero Escapes to a 32 Bit FF_DL
+ * @param [Frame]     Received Frame, Decoded Where It Lies
  * @return      Nothing
+ *
+ * The Frame Length of the First Frame is RX_DL, Every Consecutive Frame Then Carries RX_DL - 1 Bytes.
  */
 /* ---------------------------------------------------------------------------------------------------- */
-void ISO_DoCAN::FrameRX_FF (void) {
+void ISO_DoCAN::FrameRX_FF (const DriverCAN::FRAME &Frame) {
   if (SETTINGS_RX.STATUS == DoCAN_Receive) {
-    uint16_t LEN = 0;
-    LEN = (uint16_t)( ((MESSAGE.DATA[0] & 0x0F) << 8) | MESSAGE.DATA[1] );
-    if ( (LEN > 7) && (LEN <= CONFIG.LENGTH) ) {
-      *CONFIG.LEN = LEN;
-      *CONFIG.ID = MESSAGE.ID;
-      SETTINGS_RX.LENGTH = LEN;
-      LEN = LEN - 6;
-      if ( (LEN % 7) == 0 ) {
-        SETTINGS_RX.FRAMES = (LEN / 7);
+    uint32_t LEN = 0;
+    uint8_t PCI = 2;
+    LEN = (uint32_t)( ((Frame.DATA[0] & 0x0F) << 8) | Frame.DATA[1] );
+    if ( LEN == 0 ) {
+      LEN = ((uint32_t)Frame.DATA[2] << 24) | ((uint32_t)Frame.DATA[3] << 16) |
+          ((uint32_t)Frame.DATA[4] << 8) | Frame.DATA[5];
+      PCI = 6;
+    }
+    uint8_t FIRST = Frame.LEN - PCI;
+    if ( (LEN > 7) && (LEN > FIRST) && (LEN <= SETTINGS_RX.SIZE) ) {
+      *SETTINGS_RX.LEN = (uint16_t)LEN;
+      if (CONFIG.ID) {
+        *CONFIG.ID = Frame.ID;
+      }
+      memcpy(SETTINGS_RX.DATA, &Frame.DATA[PCI], FIRST);
+      SETTINGS_RX.LENGTH = (uint16_t)LEN;
+      SETTINGS_RX.DL = Frame.LEN;
+      LEN = LEN - FIRST;
+      uint8_t CF = SETTINGS_RX.DL - 1;
+      if ( (LEN % CF) == 0 ) {
+        SETTINGS_RX.FRAMES = (uint16_t)(LEN / CF);
       } else {
-        SETTINGS_RX.FRAMES = (LEN / 7) + 1;
+        SETTINGS_RX.FRAMES = (uint16_t)(LEN / CF) + 1;
       }
 
-      SETTINGS_RX.BLOCKCOUNTER = 0;
-      SETTINGS_RX.INDEX = 6;
+      SETTINGS_RX.BLOCKCOUNTER = 1;
+      SETTINGS_RX.INDEX = FIRST;
       FrameTX_FC (0);
       if ( CONFIG.ERRORCODE == DoCAN_ERR_WRONGCANID ) {
         SETTINGS_RX.STATUS = DoCAN_Idle;
@@ -323,28 +449,28 @@ void ISO_DoCAN::FrameRX_FF (void) {
  * @name        FrameRX_CF
  * @class       ISO_DoCAN (Private)
  * @brief       Receive Consecutive Frame
- * @param []    Nothing
+ * @param [Frame]     Received Frame, Decoded Where It Lies
  * @return      Nothing
  */
 /* ---------------------------------------------------------------------------------------------------- */
-void ISO_DoCAN::FrameRX_CF (void) {
+void ISO_DoCAN::FrameRX_CF (const DriverCAN::FRAME &Frame) {
   if (SETTINGS_RX.STATUS == DoCAN_Receive) {
-    if ( (MESSAGE.DATA[0] & 0x0F) == SETTINGS_RX.BLOCKCOUNTER ) {
+    if ( (Frame.DATA[0] & 0x0F) == SETTINGS_RX.BLOCKCOUNTER ) {
       SETTINGS_RX.BLOCKCOUNTER = (SETTINGS_RX.BLOCKCOUNTER + 1) % 16;
-      for (uint8_t I = 1; I < 8; I++) {
-        CONFIG.DATA[SETTINGS_RX.INDEX] = MESSAGE.DATA[I];
-        SETTINGS_RX.INDEX++;
-        if (SETTINGS_RX.INDEX == SETTINGS_RX.LENGTH) {
-          break;
-        }
+      SETTINGS_RX.TIME = MicroClock();
+      uint16_t Take = SETTINGS_RX.LENGTH - SETTINGS_RX.INDEX;
+      if (Take > (uint16_t)(Frame.LEN - 1)) {
+        Take = Frame.LEN - 1;
       }
+      memcpy(&SETTINGS_RX.DATA[SETTINGS_RX.INDEX], &Frame.DATA[1], Take);
+      SETTINGS_RX.INDEX += Take;
       if (SETTINGS_RX.INDEX == SETTINGS_RX.LENGTH) {
         SETTINGS_RX.RXFLAG = DoCAN_RX_COMPLETE;
         SETTINGS_RX.STATUS = DoCAN_Idle;
       }
       SETTINGS_RX.FRAMES--;
       SETTINGS_RX.COUNTER--;
-      if ( SETTINGS_RX.COUNTER == 0 ) {
+      if ( (SETTINGS_RX.COUNTER == 0) && (SETTINGS_RX.FRAMES != 0) ) {
         FrameTX_FC (0);
         if ( CONFIG.ERRORCODE == DoCAN_ERR_WRONGCANID ) {
           SETTINGS_RX.STATUS = DoCAN_Idle;
@@ -420,7 +546,7 @@ void ISO_DoCAN::FrameTX_FC (uint8_t FS) {
     Data[5] = CONFIG.PADDING;
     Data[6] = CONFIG.PADDING;
     Data[7] = CONFIG.PADDING;
-    PCAN.Write (CanID, Data);
+    CAN->WriteData (CanID, Data, 8, DriverCAN_STANDARD, CONFIG.FLAGS);
   }
   else {
     uint8_t Data[8];
@@ -432,7 +558,7 @@ void ISO_DoCAN::FrameTX_FC (uint8_t FS) {
     Data[5] = CONFIG.PADDING;
     Data[6] = CONFIG.PADDING;
     Data[7] = CONFIG.PADDING;
-    PCAN.Write (CanID, Data);
+    CAN->WriteData (CanID, Data, 8, DriverCAN_STANDARD, CONFIG.FLAGS);
   }
 }
 /* ==================================================================================================== */
@@ -442,11 +568,11 @@ void ISO_DoCAN::FrameTX_FC (uint8_t FS) {
  * @name        DoCAN_RX
  * @class       ISO_DoCAN (Private)
  * @brief       Process Receive DoCAN Messages
- * @param []    Nothing
+ * @param [Frame]     Received Frame, Decoded Where It Lies
  * @return      Nothing
  */
 /* ---------------------------------------------------------------------------------------------------- */
-void ISO_DoCAN::DoCAN_RX (void) {
+void ISO_DoCAN::DoCAN_RX (const DriverCAN::FRAME &Frame) {
   if ( SETTINGS_RX.RXFLAG != DoCAN_RX_WORKING ) {
     SETTINGS_RX.STATUS = DoCAN_Idle;
     return;
@@ -457,29 +583,29 @@ void ISO_DoCAN::DoCAN_RX (void) {
       return;
     }
     else {
-      if ( MESSAGE.ID != CONFIG.CANID_RX ) {
+      if ( Frame.ID != CONFIG.CANID_RX ) {
         CONFIG.ERRORCODE = DoCAN_ERR_WRONGCANID;
         SETTINGS_RX.STATUS = DoCAN_Idle;
         return;
       }
       else {
         uint8_t PCI = 0;
-        PCI = (MESSAGE.DATA[0] & 0xF0) >> 4;
+        PCI = (Frame.DATA[0] & 0xF0) >> 4;
         switch (PCI) {
           case 0x00 : { // Receiving SF
-            FrameRX_SF();
+            FrameRX_SF(Frame);
             return;
           }
           case 0x01 : { // Receiving FF
-            FrameRX_FF();
+            FrameRX_FF(Frame);
             return;
           }
           case 0x02 : { // Receiving CF
-            FrameRX_CF();
+            FrameRX_CF(Frame);
             return;
           }
           case 0x03 : { // Receiving FC
-            FrameRX_FC();
+            FrameRX_FC(Frame);
             return;
           }
           default : {
@@ -497,36 +623,361 @@ void ISO_DoCAN::DoCAN_RX (void) {
 
 /* ==================================================================================================== */
 /**
- * @name        Receive
+ * @name        ReaderLoop
+ * @class       ISO_DoCAN (Private)
+ * @brief       Reader Thread : Block in the Driver, Timestamp Each Frame and Push It Into the Ring
+ * @param []    Nothing
+ * @return      Nothing
+ *
+ * Backends Stamp Frames on DriverCAN::Clock, Which MicroClock Also Reads, so a Frame a Backend Left
+ * at Zero Gets MicroClock at Arrival. This Thread Only Touches CAN
+ * Reads, RING Pushes and READ, Everything Else Stays With the Thread Calling Receive. The Driver
+ * Reads Straight Into the Next Free Slot, Only a Full Ring Goes Through a Spare Frame.
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+void ISO_DoCAN::ReaderLoop (void) {
+  while (READING.load(std::memory_order_relaxed)) {
+    DriverCAN::FRAME Spare;
+    DriverCAN::FRAME * Slot = RING.Claim();
+    DriverCAN::FRAME &Frame = (Slot) ? *Slot : Spare;
+    uint8_t Status = CAN->ReadFrame(Frame, DoCAN_READER_POLL);
+    if (Status == DriverCAN_OK) {
+      if (Frame.TIME == 0) {
+        Frame.TIME = MicroClock();
+      }
+      READ.fetch_add(1, std::memory_order_relaxed);
+      if (Slot) {
+        RING.Publish();
+      } else {
+        RING.Push(Frame);                       // Counted as Dropped Unless Room Was Made Meanwhile
+      }
+    }
+    else if (Status == DriverCAN_ERROR) {
+      std::this_thread::sleep_for(std::chrono::microseconds(DoCAN_READER_POLL));
+    }
+  }
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        ReadFrame
+ * @class       ISO_DoCAN (Private)
+ * @brief       Next Received Frame : In Its Ring Slot While the Reader Runs, Else Read From the Driver
+ * @param [Spare]     Frame the Driver Reads Into When the Reader is Not Running
+ * @param [Timeout]   Longest Wait in MicroSeconds, Zero Polls Once
+ * @return      Frame, nullptr When None Arrived. A Ring Slot Must Be Given Back With RING.Release
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+const DriverCAN::FRAME * ISO_DoCAN::ReadFrame (DriverCAN::FRAME &Spare, uint64_t Timeout) {
+  if (READING.load(std::memory_order_relaxed) || RING.Size()) {
+    return RING.Peek((READING.load(std::memory_order_relaxed)) ? Timeout : 0);
+  }
+  uint64_t Wait = (Timeout > DoCAN_READER_POLL) ? DoCAN_READER_POLL : Timeout;  // Abort Seen Between Polls
+  return (CAN->ReadFrame(Spare, Wait) == DriverCAN_OK) ? &Spare : nullptr;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        DoCAN_TX
+ * @class       ISO_DoCAN (Private)
+ * @brief       Transmit UDS Buffer Segmented : First Frame, Then Consecutive Frames per Flow Control
+ * @param [Data]      Request, Copied Straight Into the Driver Frames
+ * @param [LEN]       Request Length
+ * @return      DoCAN Transmit Status (Enum)
+ *
+ * Every Block Waits for a Flow Control Within N_Bs, FC.WAIT Restarts N_Bs and FC.OVFLW Ends the Transfer.
+ * More Than N_WFTmax FC.WAIT in a Row Ends It With DoCAN_ERR_WAITLIMIT.
+ * With STmin Zero a Block Goes to the Driver in Batches, Otherwise One Frame per STmin. Frames Are
+ * TX_DL Long, the Last Consecutive Frame Padded Only Up To the Next Valid Length. On CAN FD Messages
+ * Above 4095 Bytes Use the Escaped 32 Bit FF_DL.
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t ISO_DoCAN::DoCAN_TX (const uint8_t * Data, uint16_t LEN) {
+  uint8_t DL = CONFIG.TX_DL;
+  if ((LEN > 4095) && !CONFIG.BITRATE_FD) {
+    CONFIG.ERRORCODE = DoCAN_ERR_FRAMEOVERFLOW;
+    SETTINGS_TX.TXFLAG = DoCAN_TX_ERROR;
+    return SETTINGS_TX.TXFLAG;
+  }
+  SETTINGS_RX.MODE = DoCAN_PHY;
+  SETTINGS_TX.MODE = DoCAN_PHY;
+  SETTINGS_TX.STATUS = DoCAN_Transmit;
+  SETTINGS_TX.TXFLAG = DoCAN_TX_WORKING;
+
+  DriverCAN::FRAME Frames[DoCAN_TX_BATCH];
+  DriverCAN::FRAME &First = Frames[0];
+  uint8_t PCI = 2;
+  First.ID = CONFIG.CANID_TX;
+  First.LEN = DL;
+  First.TYPE = DriverCAN_STANDARD;
+  First.FLAGS = CONFIG.FLAGS;
+  First.TIME = 0;
+  if (LEN <= 4095) {
+    First.DATA[0] = 0x10 | ((LEN >> 8) & 0x0F);
+    First.DATA[1] = LEN & 0xFF;
+  } else {
+    First.DATA[0] = 0x10; First.DATA[1] = 0x00;
+    First.DATA[2] = 0x00; First.DATA[3] = 0x00; First.DATA[4] = (LEN >> 8) & 0xFF; First.DATA[5] = LEN & 0xFF;
+    PCI = 6;
+  }
+  memcpy(&First.DATA[PCI], Data, DL - PCI);
+  uint16_t INDEX = DL - PCI;
+  uint8_t SN = 1;
+  uint16_t RUN = 1;
+  SETTINGS_TX.WFT = 0;
+  uint8_t FAILED = CAN->WriteFrame(First);
+
+  while (!FAILED && (INDEX < LEN)) {
+    if (Receive(1) != DoCAN_RX_COMPLETE) {
+      if (SETTINGS_RX.RXFLAG == DoCAN_RX_WORKING) {
+        CONFIG.ERRORCODE = DoCAN_ERR_TIMEOUT;
+      }
+      SETTINGS_TX.STATUS = DoCAN_Idle;
+      SETTINGS_TX.TXFLAG = DoCAN_TX_ERROR;
+      return SETTINGS_TX.TXFLAG;
+    }
+    uint16_t BLOCK = 0;
+    while (!FAILED && !ABORT.load(std::memory_order_relaxed) && (INDEX < LEN) && ((SETTINGS_TX.BLOCKS == 0) || (BLOCK < SETTINGS_TX.BLOCKS))) {
+      RUN = 0;
+      do {
+        DriverCAN::FRAME &Frame = Frames[RUN];
+        uint8_t Take = ((LEN - INDEX) > (DL - 1)) ? (DL - 1) : (uint8_t)(LEN - INDEX);
+        Frame.ID = CONFIG.CANID_TX;
+        Frame.LEN = DriverCAN::PaddedLength(Take + 1);
+        Frame.TYPE = DriverCAN_STANDARD;
+        Frame.FLAGS = CONFIG.FLAGS;
+        Frame.TIME = 0;
+        Frame.DATA[0] = 0x20 | (SN & 0x0F);
+        memcpy(&Frame.DATA[1], &Data[INDEX], Take);
+        memset(&Frame.DATA[1 + Take], CONFIG.PADDING, Frame.LEN - 1 - Take);
+        INDEX += Take;
+        SN++;
+        RUN++;
+        BLOCK++;
+      } while ((SETTINGS_TX.STMIN == 0) && (RUN < DoCAN_TX_BATCH) && (INDEX < LEN) &&
+          ((SETTINGS_TX.BLOCKS == 0) || (BLOCK < SETTINGS_TX.BLOCKS)));
+
+      if (SETTINGS_TX.STMIN && (BLOCK > 1)) {
+        WaitUntil(SETTINGS_TX.TIME + SETTINGS_TX.STMIN);
+      }
+      uint64_t Entry = MicroClock();
+      uint16_t Done = CAN->WriteBatch(Frames, RUN);
+      while (Done < RUN) {                      // Driver Queue Full, Retry Until N_As
+        if ((MicroClock() - Entry) > CONFIG.N_AS) {
+          FAILED = 1;
+          break;
+        }
+        MicroDelay(DoCAN_TX_RETRY);
+        Done += CAN->WriteBatch(&Frames[Done], RUN - Done);
+      }
+      SETTINGS_TX.TIME = MicroClock();
+    }
+  }
+
+  SETTINGS_TX.STATUS = DoCAN_Idle;
+  if (FAILED) {
+    CONFIG.ERRORCODE = DoCAN_ERR_DRIVERFAILER;
+    SETTINGS_TX.TXFLAG = DoCAN_TX_ERROR;
+    return SETTINGS_TX.TXFLAG;
+  }
+  SETTINGS_TX.TXFLAG = DoCAN_TX_COMPLETE;
+  return SETTINGS_TX.TXFLAG;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Receive (Overloaded)
  * @class       ISO_DoCAN (Public)
- * @brief       Receive DoCAN Frame
- * @param [Mode]    Mode Where 0 is for Normal Messages and 1 is for Flow Control
- * @param [Mode]    Timeout Where 0 is for P2* and 1 is for P2
+ * @brief       Receive DoCAN Frame Into the SetBuffer Buffer
+ * @param [Mode]    Mode Where 0 is for Normal Messages and 1 is for Flow Control (Timeout N_Bs)
+ * @param [Time]    Timeout Where 0 is for P2* and 1 is for P2
  * @return      DoCAN Receive Status (Enum)
  */
 /* ---------------------------------------------------------------------------------------------------- */
 uint8_t ISO_DoCAN::Receive (uint8_t Mode, uint8_t Time) {
+  if (Mode == 0) {
+    SETTINGS_RX.DATA = CONFIG.DATA;
+    SETTINGS_RX.SIZE = CONFIG.LENGTH;
+    SETTINGS_RX.LEN = CONFIG.LEN;
+  }
+  return Await(Mode, Time);
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Receive (Overloaded)
+ * @class       ISO_DoCAN (Public)
+ * @brief       Receive a Message Straight Into a Buffer Given for This Request Only
+ * @param [Data]      Destination, Payload Bytes Are Copied From the Driver Frame Into It Once
+ * @param [Size]      Destination Size, a Longer First Frame is Answered With FC.OVFLW
+ * @param [Length]    Received Length
+ * @param [Time]      Timeout Where 0 is for P2* and 1 is for P2
+ * @return      DoCAN Receive Status (Enum)
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t ISO_DoCAN::Receive (uint8_t * Data, uint16_t Size, uint16_t &Length, uint8_t Time) {
+  SETTINGS_RX.DATA = Data;
+  SETTINGS_RX.SIZE = Size;
+  SETTINGS_RX.LEN = &Length;
+  return Await(0, Time);
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Await
+ * @class       ISO_DoCAN (Private)
+ * @brief       Receive DoCAN Frames, Sleeping in the Driver Until a Frame or the P2 / P2* Deadline
+ * @param [Mode]    Mode Where 0 is for Normal Messages and 1 is for Flow Control (Timeout N_Bs)
+ * @param [Time]    Timeout Where 0 is for P2* and 1 is for P2
+ * @return      DoCAN Receive Status (Enum)
+ *
+ * Ring Frames Are Decoded in Their Slot, Only Payload Bytes Move, Once, Into SETTINGS_RX.DATA.
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t ISO_DoCAN::Await (uint8_t Mode, uint8_t Time) {
+  if (CAN == nullptr) {
+    CONFIG.ERRORCODE = DoCAN_ERR_DRIVERFAILER;
+    SETTINGS_RX.RXFLAG = DoCAN_RX_ERROR;
+    return SETTINGS_RX.RXFLAG;
+  }
+  if ((Mode == 0) && ((SETTINGS_RX.DATA == nullptr) || (SETTINGS_RX.LEN == nullptr))) {
+    CONFIG.ERRORCODE = DoCAN_ERR_INTERNALISSUE;
+    SETTINGS_RX.RXFLAG = DoCAN_RX_ERROR;
+    return SETTINGS_RX.RXFLAG;
+  }
   SETTINGS_RX.TIME = MicroClock();
   SETTINGS_RX.RXFLAG = DoCAN_RX_WORKING;
   SETTINGS_RX.STATUS = ((Mode) ? DoCAN_Wait : DoCAN_Receive);
-  uint64_t TIMEOUT = (Time) ? CONFIG.P2 : CONFIG.P2_STAR;
+  uint64_t TIMEOUT = (Mode) ? CONFIG.N_BS : ((Time) ? CONFIG.P2 : CONFIG.P2_Star);
+  uint64_t ELAPSED = 0;
 
   do {
-    if (PCAN.Read(PCAN.MESSAGE) == PCAN_ERROR_OK) {
-      if (PCAN.MESSAGE.LEN == 8) {
-        MESSAGE.TYPE = PCAN.MESSAGE.TYPE;
-        MESSAGE.LEN = PCAN.MESSAGE.LEN;
-        MESSAGE.ID = PCAN.MESSAGE.ID;
-        for (int I = 0; I < 8; I++) {
-          MESSAGE.DATA[I] = PCAN.MESSAGE.DATA[I];
-        }
-        DoCAN_RX();
+    if (ABORT.load(std::memory_order_relaxed)) {
+      CONFIG.ERRORCODE = DoCAN_ERR_ABORTED;
+      SETTINGS_RX.STATUS = DoCAN_Idle;
+      SETTINGS_RX.RXFLAG = DoCAN_RX_ERROR;
+      break;
+    }
+    DriverCAN::FRAME Spare;
+    uint64_t Wait = (VirtualNow) ? 0 : (TIMEOUT - ELAPSED + 1);  // Virtual Time Only Moves While Polled
+    const DriverCAN::FRAME * Frame = ReadFrame(Spare, Wait);
+    if (Frame) {
+      if ((Frame->LEN == 8) || (CONFIG.BITRATE_FD && (Frame->LEN > 8))) {
+        DoCAN_RX(*Frame);
+      }
+      if (Frame != &Spare) {
+        RING.Release();
       }
     }
-  } while ((SETTINGS_RX.RXFLAG == DoCAN_RX_WORKING) && ((MicroClock() - SETTINGS_RX.TIME) <= TIMEOUT));
+    ELAPSED = MicroClock() - SETTINGS_RX.TIME;
+  } while ((SETTINGS_RX.RXFLAG == DoCAN_RX_WORKING) && (ELAPSED <= TIMEOUT));
   return SETTINGS_RX.RXFLAG;
 }
 /* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Transmit (Overloaded)
+ * @class       ISO_DoCAN (Public)
+ * @brief       Transmit the SetBuffer Buffer
+ * @param [Mode]    Addressing Where 0 is for Physical and 1 is for Functional (Single Frame Only)
+ * @return      DoCAN Transmit Status (Enum)
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t ISO_DoCAN::Transmit (uint8_t Mode) {
+  if ((CONFIG.DATA == nullptr) || (CONFIG.LEN == nullptr)) {
+    CONFIG.ERRORCODE = DoCAN_ERR_INTERNALISSUE;
+    SETTINGS_TX.TXFLAG = DoCAN_TX_ERROR;
+    return SETTINGS_TX.TXFLAG;
+  }
+  return Transmit(CONFIG.DATA, *CONFIG.LEN, Mode);
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Transmit (Overloaded)
+ * @class       ISO_DoCAN (Public)
+ * @brief       Transmit a Request as DoCAN Single Frame, or Segmented When Longer Than 7 Bytes
+ *              (TX_DL - 2 on CAN FD, Where SF_DL Above 7 Follows an Escape Byte)
+ * @param [Data]      Request, Copied Straight Into the Driver Frames
+ * @param [LEN]       Request Length
+ * @param [Mode]      Addressing Where 0 is for Physical and 1 is for Functional (Single Frame Only)
+ * @return      DoCAN Transmit Status (Enum)
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t ISO_DoCAN::Transmit (const uint8_t * Data, uint16_t LEN, uint8_t Mode) {
+  uint32_t CanID = (Mode == DoCAN_FUN) ? CONFIG.CANID_FN : CONFIG.CANID_TX;
+  uint16_t SF = (CONFIG.TX_DL > DriverCAN_LENGTH_CLASSIC) ? (CONFIG.TX_DL - 2) : 7;
+  if (CAN == nullptr) {
+    CONFIG.ERRORCODE = DoCAN_ERR_DRIVERFAILER;
+    SETTINGS_TX.TXFLAG = DoCAN_TX_ERROR;
+    return SETTINGS_TX.TXFLAG;
+  }
+  if ((LEN > SF) && (Mode == DoCAN_PHY)) {
+    return DoCAN_TX(Data, LEN);
+  }
+  if ((LEN == 0) || (LEN > SF)) {
+    CONFIG.ERRORCODE = DoCAN_ERR_FRAMEOVERFLOW;
+    SETTINGS_TX.TXFLAG = DoCAN_TX_ERROR;
+    return SETTINGS_TX.TXFLAG;
+  }
+  DriverCAN::FRAME Frame;
+  uint8_t PCI = 1;
+  if (LEN <= 7) {
+    Frame.DATA[0] = (uint8_t)LEN;
+  } else {
+    Frame.DATA[0] = 0x00;
+    Frame.DATA[1] = (uint8_t)LEN;
+    PCI = 2;
+  }
+  Frame.ID = CanID;
+  Frame.LEN = DriverCAN::PaddedLength(LEN + PCI);
+  Frame.TYPE = DriverCAN_STANDARD;
+  Frame.FLAGS = CONFIG.FLAGS;
+  Frame.TIME = 0;
+  memcpy(&Frame.DATA[PCI], Data, LEN);
+  memset(&Frame.DATA[PCI + LEN], CONFIG.PADDING, Frame.LEN - PCI - LEN);
+  SETTINGS_RX.MODE = Mode;
+  if (CAN->WriteFrame (Frame)) {
+    CONFIG.ERRORCODE = DoCAN_ERR_DRIVERFAILER;
+    SETTINGS_TX.TXFLAG = DoCAN_TX_ERROR;
+    return SETTINGS_TX.TXFLAG;
+  }
+  SETTINGS_TX.TIME = MicroClock();
+  SETTINGS_TX.TXFLAG = DoCAN_TX_COMPLETE;
+  return SETTINGS_TX.TXFLAG;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Abort
+ * @class       ISO_DoCAN (Public)
+ * @brief       Cancel the Receive or Segmented Transmit Running on Another Thread (DoCAN_ERR_ABORTED)
+ * @param [Set]     1 to Abort, 0 to Clear the Flag Before the Next Transfer
+ * @return      Nothing
+ *
+ * The Flag Stays Set Until Cleared, so Every Transfer Started Meanwhile Fails at Once. A Receive
+ * Sleeping on the Frame Ring, or in a Driver That Can Be Interrupted (DriverMux::Port), Wakes
+ * Immediately, One Reading Any Other Driver Directly Within DoCAN_READER_POLL.
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+void ISO_DoCAN::Abort (uint8_t Set) {
+  ABORT = Set;
+  if (Set) {
+    RING.Interrupt();
+    if (CAN) {
+      CAN->Interrupt();
+    }
+  }
+}
+/* ==================================================================================================== */
  
 
 
@@ -568,7 +1019,7 @@ void ISO_DoCAN::SetCANID (uint32_t ID_TX, uint32_t ID_RX, uint32_t ID_FN) {
 /**
  * @name        SetBuffer
  * @class       ISO_DoCAN (Public)
- * @brief       Start DoCAN and CAN Drivers
+ * @brief       Default Buffer of Transmit (Mode) and Receive (Mode), Not Needed When Every Request Brings Its Own
  * @param [ID]        UDS Data CAN ID Variable Address
  * @param [Len]       UDS Data Length Variable Address
  * @param [Data]      UDS Data Buffer Start Address
@@ -598,6 +1049,20 @@ void ISO_DoCAN::SetTiming (uint64_t P2, uint64_t P2_Star) {
 }
 /* ==================================================================================================== */
 
+/* ==================================================================================================== */
+/**
+ * @name        SetWaitLimit
+ * @class       ISO_DoCAN (Public)
+ * @brief       Most FC.WAIT Accepted in a Row While Transmitting (N_WFTmax)
+ * @param [N_WFTmax]    FC.WAIT Limit, Defaults to DoCAN_N_WFTMAX, Zero Fails on the First FC.WAIT
+ * @return      Nothing
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+void ISO_DoCAN::SetWaitLimit (uint16_t N_WFTmax) {
+  SETTINGS_TX.WFT_MAX = N_WFTmax;
+}
+/* ==================================================================================================== */
+
 /* ==================================================================================================== */
 /**
  * @name        SetUDSParameter
@@ -630,29 +1095,75 @@ void ISO_DoCAN::SetUDSParameter (uint8_t Padding, uint32_t STMin, uint8_t Block,
 }
 /* ==================================================================================================== */
 
+/* ==================================================================================================== */
+/**
+ * @name        SetDriver
+ * @class       ISO_DoCAN (Public)
+ * @brief       Run DoCAN on Another CAN Backend, Call Before Start, nullptr Restores the Built In One
+ * @param [Driver]    DriverCAN Backend, Owned by the Caller
+ * @return      Nothing
+ *
+ * The Built In Backend is Only Constructed by Start, so an Instance Given a Driver Here Never Builds It.
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+void ISO_DoCAN::SetDriver (DriverCAN * Driver) {
+  StopReader();
+  CAN = (Driver) ? Driver : DRIVER.get();
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        SetFD
+ * @class       ISO_DoCAN (Public)
+ * @brief       Run DoCAN on CAN FD (ISO 15765-2:2016), Call Before Start, nullptr Goes Back to Classic CAN
+ * @param [BitRate]   CAN FD Bit Rate Handed to DriverCAN::OpenFD
+ * @param [TX_DL]     Transmit Frame Length : 8, 12, 16, 20, 24, 32, 48 or 64
+ * @param [BRS]       1 to Switch to the Data Bit Rate in Every Frame Sent
+ * @return      Zero on Success, 1 When TX_DL is Not a Valid Frame Length
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t ISO_DoCAN::SetFD (const char * BitRate, uint8_t TX_DL, uint8_t BRS) {
+  if (BitRate == nullptr) {
+    CONFIG.BITRATE_FD = nullptr;
+    CONFIG.TX_DL = DriverCAN_LENGTH_CLASSIC;
+    CONFIG.FLAGS = DriverCAN_CLASSIC;
+    return 0;
+  }
+  if ((TX_DL < DriverCAN_LENGTH_CLASSIC) || (DriverCAN::PaddedLength(TX_DL) != TX_DL)) {
+    return 1;
+  }
+  CONFIG.BITRATE_FD = BitRate;
+  CONFIG.TX_DL = TX_DL;
+  CONFIG.FLAGS = DriverCAN_FD | ((BRS) ? DriverCAN_BRS : 0);
+  return 0;
+}
+/* ==================================================================================================== */
+
 /* ==================================================================================================== */
 /**
  * @name        Start
  * @class       ISO_DoCAN (Public)
- * @brief       Start DoCAN and CAN Drivers
+ * @brief       Start DoCAN and CAN Drivers, Then the Reader Thread Unless on the Virtual Clock
  * @param []    Nothing
  * @return      Nothing
  */
 /* ---------------------------------------------------------------------------------------------------- */
 void ISO_DoCAN::Start (void) {
-  TPCANStatus Status;
-  Status = PCAN.Initialize();
-  if (PCAN_ERROR_OK != Status) {
-    CONFIG.ERRORCODE = DoCAN_ERR_DRIVERFAILER;
-    return;
+  StopReader();
+  if (CAN == nullptr) {
+    if (!DRIVER) {
+      DRIVER = std::make_unique<DoCANDriver>();
+    }
+    CAN = DRIVER.get();
   }
-  Status = PCAN.Filter(CONFIG.CANID_RX);
-  if (PCAN_ERROR_OK != Status) {
+  uint8_t Status = (CONFIG.BITRATE_FD) ? CAN->OpenFD(CONFIG.BITRATE_FD) : CAN->Open(DoCAN_KBPS_DEFAULT);
+  if (Status != DriverCAN_OK) {
     CONFIG.ERRORCODE = DoCAN_ERR_DRIVERFAILER;
     return;
   }
-  if (CONFIG.DATA == nullptr || CONFIG.LEN == nullptr || CONFIG.ID == nullptr) {
-    CONFIG.ERRORCODE = DoCAN_ERR_INTERNALISSUE;
+  if (CAN->SetFilter(CONFIG.CANID_RX, CONFIG.CANID_RX) != DriverCAN_OK) {
+    CONFIG.ERRORCODE = DoCAN_ERR_DRIVERFAILER;
     return;
   }
   CONFIG.ERRORCODE = 0;
@@ -664,7 +1175,124 @@ void ISO_DoCAN::Start (void) {
     SETTINGS_RX.BLOCKCOUNTER = 0;
     SETTINGS_RX.COUNTER = 0;
     SETTINGS_RX.FRAMES = 0;
+    SETTINGS_RX.DL = DriverCAN_LENGTH_CLASSIC;
   CONFIG.INIT = 1;
+  if (!VirtualNow) {
+    StartReader();
+  }
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        SetBaudrate
+ * @class       ISO_DoCAN (Public)
+ * @brief       Reprogram CAN Bit Timing (LinkControl Transition), Always to Classic CAN Frames
+ * @param [KBPS]    Speed in KBPS
+ * @return      Zero on Success
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t ISO_DoCAN::SetBaudrate (uint16_t KBPS) {
+  uint8_t Reading = READING;
+  StopReader();                                 // The Driver is Not Reopened Under a Reading Thread
+  if (CAN == nullptr) {
+    CONFIG.ERRORCODE = DoCAN_ERR_DRIVERFAILER;
+    return 1;
+  }
+  CAN->Close();
+  SetFD(nullptr);
+  if (CAN->Open(KBPS) != DriverCAN_OK) {
+    CONFIG.ERRORCODE = DoCAN_ERR_DRIVERFAILER;
+    return 1;
+  }
+  if (CAN->SetFilter(CONFIG.CANID_RX, CONFIG.CANID_RX) != DriverCAN_OK) {
+    CONFIG.ERRORCODE = DoCAN_ERR_DRIVERFAILER;
+    return 1;
+  }
+  if (Reading) {
+    StartReader();
+  }
+  return 0;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        StartReader
+ * @class       ISO_DoCAN (Public)
+ * @brief       Start the Thread That Drains the Driver Into the Frame Ring, Receive Then Reads the Ring
+ * @param []    Nothing
+ * @return      Zero When Running, 1 on the Virtual Clock (Virtual Time Only Moves While Polled) or
+ *              When the Driver Already Queues Frames In Process (DriverMux::Port)
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t ISO_DoCAN::StartReader (void) {
+  if (VirtualNow || (CAN == nullptr) || CAN->Buffered()) {
+    return 1;
+  }
+  if (READING) {
+    return 0;
+  }
+  RING.Clear();
+  READING = 1;
+  READER = std::thread(&ISO_DoCAN::ReaderLoop, this);
+  return 0;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        StopReader
+ * @class       ISO_DoCAN (Public)
+ * @brief       Stop the Reader Thread, Receive Goes Back to Reading the Driver, Queued Frames Are Kept
+ * @param []    Nothing
+ * @return      Nothing
+ *
+ * Returns Within One DoCAN_READER_POLL, the Longest the Thread Blocks in the Driver.
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+void ISO_DoCAN::StopReader (void) {
+  READING = 0;
+  if (READER.joinable()) {
+    READER.join();
+  }
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        ReaderStats
+ * @class       ISO_DoCAN (Public)
+ * @brief       Reader Thread and Frame Ring Counters
+ * @param []    Nothing
+ * @return      DoCANREADER Snapshot
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+ISO_DoCAN::DoCANREADER ISO_DoCAN::ReaderStats (void) {
+  DoCANREADER Stats;
+  Stats.RUNNING = READING;
+  Stats.FRAMES = READ;
+  Stats.DROPPED = RING.Dropped();
+  Stats.QUEUED = RING.Size();
+  Stats.PEAK = RING.Peak();
+  return Stats;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        SetVirtualClock
+ * @class       ISO_DoCAN (Public)
+ * @brief       Replace the Steady Clock of Every DoCAN Instance (Simulation), nullptr Restores It
+ * @param [Now]       Virtual Time in MicroSeconds
+ * @param [Wait]      Advance Virtual Time by MicroSeconds
+ * @return      Nothing
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+void ISO_DoCAN::SetVirtualClock (uint64_t (*Now)(void), void (*Wait)(uint64_t Time)) {
+  VirtualNow = Now;
+  VirtualWait = Wait;
+  DriverCAN::SetClock(Now);
 }
 /* ==================================================================================================== */
 
@@ -696,7 +1324,7 @@ uint64_t ISO_DoCAN::Clock (uint8_t Mode) {
  */
 /* ---------------------------------------------------------------------------------------------------- */
 uint64_t ISO_DoCAN::MicroClock (void) {
-  return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - StartTime).count();
+  return DriverCAN::Clock();
 }
 /* ==================================================================================================== */
 
@@ -710,7 +1338,7 @@ uint64_t ISO_DoCAN::MicroClock (void) {
  */
 /* ---------------------------------------------------------------------------------------------------- */
 uint64_t ISO_DoCAN::MilliClock (void) {
-  return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - StartTime).count();
+  return DriverCAN::Clock() / 1000;
 }
 /* ==================================================================================================== */
 
@@ -743,9 +1371,7 @@ void ISO_DoCAN::Delay (uint64_t Time, uint8_t Mode) {
  */
 /* ---------------------------------------------------------------------------------------------------- */
 void ISO_DoCAN::MicroDelay (uint64_t Time) {
-  uint64_t Entry = MicroClock();
-  uint64_t Exit = MicroClock();
-  while ((Exit - Entry) < Time) { Exit = MicroClock(); }
+  WaitUntil(MicroClock() + Time);
 }
 /* ==================================================================================================== */
 
@@ -759,9 +1385,89 @@ void ISO_DoCAN::MicroDelay (uint64_t Time) {
  */
 /* ---------------------------------------------------------------------------------------------------- */
 void ISO_DoCAN::MilliDelay (uint64_t Time) {
-  uint64_t Entry = MilliClock();
-  uint64_t Exit = MilliClock();
-  while ((Exit - Entry) < Time) { Exit = MilliClock(); }
+  WaitUntil(MicroClock() + (Time * 1000));
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        TimerStats
+ * @class       ISO_DoCAN (Public)
+ * @brief       Copy of the Precision Wait Statistics, Safe While Other Threads Wait
+ * @return      DoCANTIMER
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+ISO_DoCAN::DoCANTIMER ISO_DoCAN::TimerStats (void) {
+  std::lock_guard<std::mutex> Lock(TIMER_LOCK);
+  return TIMER;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        WaitUntil
+ * @class       ISO_DoCAN (Public)
+ * @brief       Precision Wait : OS Sleep Until MARGIN Before the Deadline, Then Spin the Rest
+ * @param [Deadline]    MicroClock Time to Return At
+ * @return      Nothing
+ *
+ * MARGIN Follows the Measured OS Wake Up Lateness (Twice the Average Plus MARGIN_MIN), so a Quiet
+ * Host Spins a Few Tens of MicroSeconds per Wait. MARGIN_MAX Caps the Spin on a Loaded Host, Which
+ * Then Overshoots a Little Rather Than Pin a Core. On Linux the First Wait of Each Thread Sets That
+ * Thread's Timer Slack to 1 ns, so Threads That Never Wait Keep Their Own Slack.
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+void ISO_DoCAN::WaitUntil (uint64_t Deadline) {
+  uint64_t Now = MicroClock();
+  if (Deadline <= Now) {
+    return;
+  }
+  if (VirtualWait) {
+    VirtualWait(Deadline - Now);
+    return;
+  }
+#ifdef __linux__
+  static thread_local uint8_t SLACK = 0;
+  if (!SLACK) {
+    prctl(PR_SET_TIMERSLACK, 1UL);
+    SLACK = 1;
+  }
+#endif
+  uint64_t Margin;
+  {
+    std::lock_guard<std::mutex> Lock(TIMER_LOCK);
+    TIMER.WAITS++;
+    Margin = TIMER.MARGIN;
+  }
+  if (Deadline > (Now + Margin)) {
+    uint64_t Wake = Deadline - Margin;
+    auto Target = DriverCAN::Epoch() + std::chrono::microseconds(Wake);
+#ifdef __linux__
+    auto Epoch = std::chrono::duration_cast<std::chrono::nanoseconds>(Target.time_since_epoch()).count();
+    struct timespec Sleep = { (time_t)(Epoch / 1000000000LL), (long)(Epoch % 1000000000LL) };
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &Sleep, NULL) == EINTR) {}
+#else
+    std::this_thread::sleep_until(Target);
+#endif
+    Now = MicroClock();
+    uint64_t Late = (Now > Wake) ? (Now - Wake) : 0;
+    std::lock_guard<std::mutex> Lock(TIMER_LOCK);
+    TIMER.SLEEPS++;
+    TIMER.LATE = ((TIMER.LATE * 7) + Late) / 8;
+    TIMER.MARGIN = (TIMER.LATE * 2) + DoCAN_TIMER_MARGIN_MIN;
+    if (TIMER.MARGIN > DoCAN_TIMER_MARGIN_MAX) {
+      TIMER.MARGIN = DoCAN_TIMER_MARGIN_MAX;
+    }
+  }
+  uint64_t Spin = Now;
+  while (Now < Deadline) { Now = MicroClock(); }
+  uint64_t Over = Now - Deadline;
+  std::lock_guard<std::mutex> Lock(TIMER_LOCK);
+  TIMER.SPIN_TOTAL += (Now > Spin) ? (Now - Spin) : 0;
+  TIMER.OVERSHOOT_TOTAL += Over;
+  if (Over > TIMER.OVERSHOOT_MAX) {
+    TIMER.OVERSHOOT_MAX = Over;
+  }
 }
 /* ==================================================================================================== */
 
@@ -0,0 +1,247 @@
+/* ==================================================================================================== */
+/*
+*  DriverCAN.h
+*  CAN Device Interface
+*    ISO: 11898 Part 1 - Controller Area Network (CAN)
+*  Version: v1.0:0
+*  Developed By: Alakshendra Singh
+*  For Reporting Any Issue Don't Contact Me. Fix Yourself
+*/
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @file        DriverCAN.h
+ * @author      Alakshendra Singh
+ * @brief       CAN Device Interface, Implemented by Every Backend ISO_DoCAN Can Run On
+ * @version     1.0
+ *
+ * Backends : DriverPCAN (PCAN-Basic), DriverSocketCAN (Linux SocketCAN), DriverLoopback (In Process),
+ *            DriverMux::Port (One Connection on a Shared Device)
+ *
+ * @copyright   Copyright (c) 2025
+ */
+/* ==================================================================================================== */
+
+#ifndef _DriverCAN
+#define _DriverCAN
+
+#include <stdint.h>
+#include <string.h>
+#include <chrono>
+
+#define DriverCAN_OK                      0
+#define DriverCAN_EMPTY                   1
+#define DriverCAN_ERROR                   2
+
+#define DriverCAN_STANDARD                0
+#define DriverCAN_EXTENDED                1
+
+#define DriverCAN_CLASSIC                 0x00
+#define DriverCAN_FD                      0x01
+#define DriverCAN_BRS                     0x02
+
+#define DriverCAN_LENGTH_CLASSIC          8
+#define DriverCAN_LENGTH_FD               64
+
+
+
+/* ==================================================================================================== */
+/**
+ * @class       DriverCAN
+ * @brief       Abstract CAN Device : Open, Filter, Read With Timeout, Write, Batch Write
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+class DriverCAN {
+  public:
+
+    struct FRAME {
+      uint32_t ID;
+      uint8_t LEN;                              // Data Length in Bytes (Not the DLC), Up To 8 or 64 on FD
+      uint8_t TYPE;
+      uint8_t FLAGS;                            // DriverCAN_FD, DriverCAN_BRS
+      uint8_t DATA[DriverCAN_LENGTH_FD];
+      uint64_t TIME;                            // Receive Time in MicroSeconds on DriverCAN::Clock
+      uint64_t HWTIME;                          // Raw Device Timestamp in MicroSeconds, Zero When It Has None
+    };
+
+    virtual ~DriverCAN (void) {}
+
+    virtual uint8_t Open (uint16_t KBPS) = 0;
+    virtual uint8_t OpenFD (const char * BitRate) { (void)BitRate; return DriverCAN_ERROR; }
+    virtual uint8_t Close (void) = 0;
+    virtual uint8_t SetFilter (uint32_t Low, uint32_t High, uint8_t Type = DriverCAN_STANDARD) = 0;
+    virtual uint8_t ReadFrame (FRAME &Frame, uint64_t Timeout = 0) = 0;
+    virtual uint8_t WriteFrame (const FRAME &Frame) = 0;
+    virtual uint16_t WriteBatch (const FRAME * Frames, uint16_t Count);
+    virtual uint8_t Buffered (void) { return 0; }   // Frames Already Queued In Process, No Reader Thread Needed
+    virtual void Interrupt (void) {}                // End a ReadFrame Sleeping on Another Thread, When the Backend Can
+
+    uint8_t WriteData (uint32_t ID, const uint8_t * Data, uint8_t Length = 8,
+        uint8_t Type = DriverCAN_STANDARD, uint8_t Flags = DriverCAN_CLASSIC);
+
+    static uint8_t DLCToLength (uint8_t DLC);
+    static uint8_t LengthToDLC (uint8_t Length);
+    static uint8_t PaddedLength (uint8_t Length);
+
+    static uint64_t Clock (void);
+    static void SetClock (uint64_t (*Now)(void));
+    static std::chrono::steady_clock::time_point Epoch (void);
+
+  private:
+
+    static inline uint64_t (*VirtualNow)(void) = nullptr;
+};
+/* ==================================================================================================== */
+
+
+/* ==================================================================================================== */
+/**
+ * @name        WriteBatch
+ * @class       DriverCAN (Public)
+ * @brief       Write Frames in Order, Backends With a Batch Call Override This
+ * @param [Frames]    Frames to Write
+ * @param [Count]     Number of Frames
+ * @return      Number of Frames Written Before the First Failure
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint16_t DriverCAN::WriteBatch (const FRAME * Frames, uint16_t Count) {
+  uint16_t Sent = 0;
+  while ((Sent < Count) && (WriteFrame(Frames[Sent]) == DriverCAN_OK)) {
+    Sent++;
+  }
+  return Sent;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Epoch
+ * @class       DriverCAN (Public)
+ * @brief       Steady Clock Time of the First Clock Reading in the Process
+ * @param []    Nothing
+ * @return      Steady Clock Time Point
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+std::chrono::steady_clock::time_point DriverCAN::Epoch (void) {
+  static const std::chrono::steady_clock::time_point Start =
+      std::chrono::steady_clock::now() - std::chrono::microseconds(1);   // Clock Never Reads Zero, Zero Means Unstamped
+  return Start;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Clock
+ * @class       DriverCAN (Public)
+ * @brief       Common Timebase of Every Backend and ISO_DoCAN, MicroSeconds Since Epoch
+ * @param []    Nothing
+ * @return      Time in MicroSeconds
+ *
+ * Every Backend Stamps FRAME::TIME on This Clock, so Stamps From Different Backends Compare. The
+ * Device's Own Timestamp, When It Has One, Goes Unconverted Into FRAME::HWTIME.
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint64_t DriverCAN::Clock (void) {
+  if (VirtualNow) {
+    return VirtualNow();
+  }
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - Epoch()).count();
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        SetClock
+ * @class       DriverCAN (Public)
+ * @brief       Replace the Steady Clock With a Virtual One (Simulation), nullptr Restores It
+ * @param [Now]       Virtual Time in MicroSeconds
+ * @return      Nothing
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+void DriverCAN::SetClock (uint64_t (*Now)(void)) {
+  VirtualNow = Now;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        WriteData
+ * @class       DriverCAN (Public)
+ * @brief       Write Data on CAN with Raw Configuration
+ * @param [ID]        CAN ID
+ * @param [Data]      Data Array Pointer
+ * @param [Length]    Frame Data Length
+ * @param [Type]      Standard or Extended CAN ID
+ * @param [Flags]     DriverCAN_FD / DriverCAN_BRS, Lengths Above 8 Are Always Sent as FD
+ * @return      DriverCAN Status
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t DriverCAN::WriteData (uint32_t ID, const uint8_t * Data, uint8_t Length, uint8_t Type, uint8_t Flags) {
+  FRAME Frame;
+  Frame.ID = ID;
+  Frame.LEN = (Length > DriverCAN_LENGTH_FD) ? DriverCAN_LENGTH_FD : Length;
+  Frame.TYPE = Type;
+  Frame.FLAGS = (Frame.LEN > DriverCAN_LENGTH_CLASSIC) ? (Flags | DriverCAN_FD) : Flags;
+  Frame.TIME = 0; Frame.HWTIME = 0;
+  memcpy(Frame.DATA, Data, Frame.LEN);
+  memset(&Frame.DATA[Frame.LEN], 0x00, DriverCAN_LENGTH_FD - Frame.LEN);
+  return WriteFrame(Frame);
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        DLCToLength
+ * @class       DriverCAN (Public)
+ * @brief       Data Length of a DLC, 9 to 15 Map to 12, 16, 20, 24, 32, 48, 64 (ISO 11898-1 FD)
+ * @param [DLC]       Data Length Code 0 to 15
+ * @return      Length in Bytes
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t DriverCAN::DLCToLength (uint8_t DLC) {
+  static const uint8_t Length[16] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 20, 24, 32, 48, 64 };
+  return Length[DLC & 0x0F];
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        LengthToDLC
+ * @class       DriverCAN (Public)
+ * @brief       Smallest DLC Carrying a Length
+ * @param [Length]    Length in Bytes, Up To 64
+ * @return      Data Length Code 0 to 15
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t DriverCAN::LengthToDLC (uint8_t Length) {
+  uint8_t DLC = 0;
+  while ((DLC < 15) && (DLCToLength(DLC) < Length)) {
+    DLC++;
+  }
+  return DLC;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        PaddedLength
+ * @class       DriverCAN (Public)
+ * @brief       Frame Length a Padded ISO-TP Frame Uses for a Payload : 8, Else the Next FD Length
+ * @param [Length]    Bytes of PCI and Data
+ * @return      Frame Length in Bytes
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t DriverCAN::PaddedLength (uint8_t Length) {
+  return (Length <= DriverCAN_LENGTH_CLASSIC) ? DriverCAN_LENGTH_CLASSIC : DLCToLength(LengthToDLC(Length));
+}
+/* ==================================================================================================== */
+
+
+/* ==================================================================================================== */
+/**
+ * @end       End of File DriverCAN.h
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+#endif  // _DriverCAN
+/* ==================================================================================================== */
@@ -0,0 +1,267 @@
+/* ==================================================================================================== */
+/*
+*  DriverLoopback.h
+*  In Process Loopback CAN Driver
+*    ISO: 11898 Part 1 - Controller Area Network (CAN)
+*  Version: v1.0:0
+*  Developed By: Alakshendra Singh
+*  For Reporting Any Issue Don't Contact Me. Fix Yourself
+*/
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @file        DriverLoopback.h
+ * @author      Alakshendra Singh
+ * @brief       In Process Loopback Driver, DriverCAN Backend Without Any Hardware
+ * @version     1.0
+ *
+ * Two Connected Endpoints Are a Bus With Two Nodes, Each Write Lands in the Other One's Queue.
+ * An Endpoint With No Peer Hears Its Own Frames. Frames Outside the Receiver's Filter Are Dropped.
+ *
+ * @copyright   Copyright (c) 2025
+ */
+/* ==================================================================================================== */
+
+#ifndef _DriverLoopback
+#define _DriverLoopback
+
+#include <iostream>
+#include <stdint.h>
+#include <deque>
+#include <mutex>
+#include <chrono>
+#include <condition_variable>
+#include "DriverCAN.hpp"
+
+using namespace std;
+
+#define DriverLoopback_DEPTH              1024
+
+
+
+/* ==================================================================================================== */
+/**
+ * @class       DriverLoopback
+ * @brief       Loopback Driver For CAN According To ISO 11898-1
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+class DriverLoopback : public DriverCAN {
+  private:
+    DriverLoopback * PEER;
+    std::deque<FRAME> RX;
+    std::mutex LOCK;
+    std::condition_variable READY;
+    uint8_t OPEN;
+    uint8_t FD;                                 // Opened With OpenFD, Accepts FD Frames
+    uint16_t KBPS;
+    uint32_t FILTER_LOW;
+    uint32_t FILTER_HIGH;
+    uint8_t FILTER_TYPE;
+    uint64_t DROPPED;
+
+    void Deliver (const FRAME &Frame);
+
+  public:
+
+    DriverLoopback (void) {
+      PEER = nullptr; OPEN = 0; FD = 0; KBPS = 500; DROPPED = 0;
+      FILTER_LOW = 0; FILTER_HIGH = 0x1FFFFFFF; FILTER_TYPE = DriverCAN_STANDARD;
+      cout << "\nLoopback CAN Driver Loaded";
+    }
+    ~DriverLoopback (void) {
+      if (PEER) {
+        PEER->PEER = nullptr;
+      }
+      cout << "\nLoopback CAN Driver Unloaded";
+    }
+
+    void Connect (DriverLoopback &Peer);
+    uint64_t Dropped (void) { return DROPPED; }
+
+    uint8_t Open (uint16_t KBPS) override;
+    uint8_t OpenFD (const char * BitRate) override;
+    uint8_t Close (void) override;
+    uint8_t SetFilter (uint32_t Low, uint32_t High, uint8_t Type = DriverCAN_STANDARD) override;
+    uint8_t ReadFrame (FRAME &Frame, uint64_t Timeout = 0) override;
+    uint8_t WriteFrame (const FRAME &Frame) override;
+};
+/* ==================================================================================================== */
+
+
+/* ==================================================================================================== */
+/**
+ * @name        Deliver
+ * @class       DriverLoopback (Private)
+ * @brief       Queue a Frame Written by the Peer, When Open, Inside the Filter and Not Full
+ * @param [Frame]     Frame on the Bus
+ * @return      Nothing
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+void DriverLoopback::Deliver (const FRAME &Frame) {
+  {
+    std::lock_guard<std::mutex> Guard(LOCK);
+    if (!OPEN || (Frame.TYPE != FILTER_TYPE) || (Frame.ID < FILTER_LOW) || (Frame.ID > FILTER_HIGH)) {
+      return;
+    }
+    if ((Frame.FLAGS & DriverCAN_FD) && !FD) {
+      DROPPED++;                                // A Classic Controller Cannot Take an FD Frame
+      return;
+    }
+    if (RX.size() >= DriverLoopback_DEPTH) {
+      DROPPED++;
+      return;
+    }
+    RX.push_back(Frame);
+    RX.back().TIME = Clock();
+    RX.back().HWTIME = 0;
+  }
+  READY.notify_one();
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Connect
+ * @class       DriverLoopback (Public)
+ * @brief       Join Two Endpoints Into One Bus
+ * @param [Peer]      Other Endpoint
+ * @return      Nothing
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+void DriverLoopback::Connect (DriverLoopback &Peer) {
+  PEER = &Peer;
+  Peer.PEER = this;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Open
+ * @class       DriverLoopback (Public)
+ * @brief       Start Receiving, Anything Queued Before Is Dropped
+ * @param [KBPS]    Speed in KBPS, Recorded Only
+ * @return      DriverCAN Status
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t DriverLoopback::Open (uint16_t KBPS) {
+  std::lock_guard<std::mutex> Guard(LOCK);
+  this->KBPS = KBPS;
+  RX.clear();
+  OPEN = 1;
+  FD = 0;
+  return DriverCAN_OK;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        OpenFD
+ * @class       DriverLoopback (Public)
+ * @brief       Start Receiving Classic and FD Frames, Anything Queued Before Is Dropped
+ * @param [BitRate]   FD Bit Rate String, Ignored
+ * @return      DriverCAN Status
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t DriverLoopback::OpenFD (const char * BitRate) {
+  (void)BitRate;
+  std::lock_guard<std::mutex> Guard(LOCK);
+  RX.clear();
+  OPEN = 1;
+  FD = 1;
+  return DriverCAN_OK;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Close
+ * @class       DriverLoopback (Public)
+ * @brief       Stop Receiving
+ * @param []    Nothing
+ * @return      DriverCAN Status
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t DriverLoopback::Close (void) {
+  {
+    std::lock_guard<std::mutex> Guard(LOCK);
+    RX.clear();
+    OPEN = 0;
+  }
+  READY.notify_all();
+  return DriverCAN_OK;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        SetFilter
+ * @class       DriverLoopback (Public)
+ * @brief       Range Filter Applied to Frames From the Peer
+ * @param [Low]       CAN ID Lower Limit
+ * @param [High]      CAN ID Upper Limit
+ * @param [Type]      Standard or Extended CAN ID
+ * @return      DriverCAN Status
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t DriverLoopback::SetFilter (uint32_t Low, uint32_t High, uint8_t Type) {
+  std::lock_guard<std::mutex> Guard(LOCK);
+  FILTER_LOW = Low; FILTER_HIGH = High; FILTER_TYPE = Type;
+  RX.clear();
+  return DriverCAN_OK;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        ReadFrame
+ * @class       DriverLoopback (Public)
+ * @brief       Read One Frame, Waiting on the Queue Until It Arrives or the Timeout Passes
+ * @param [Frame]     Received Frame
+ * @param [Timeout]   Longest Wait in MicroSeconds, Zero Polls Once
+ * @return      DriverCAN Status
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t DriverLoopback::ReadFrame (FRAME &Frame, uint64_t Timeout) {
+  std::unique_lock<std::mutex> Guard(LOCK);
+  if (!OPEN) {
+    return DriverCAN_ERROR;
+  }
+  if (RX.empty() && Timeout) {
+    READY.wait_for(Guard, std::chrono::microseconds(Timeout), [this] { return !RX.empty() || !OPEN; });
+  }
+  if (RX.empty()) {
+    return DriverCAN_EMPTY;
+  }
+  Frame = RX.front();
+  RX.pop_front();
+  return DriverCAN_OK;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        WriteFrame
+ * @class       DriverLoopback (Public)
+ * @brief       Put a Frame on the Loopback Bus
+ * @param [Frame]     Frame to Write
+ * @return      DriverCAN Status
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t DriverLoopback::WriteFrame (const FRAME &Frame) {
+  if (!OPEN || ((Frame.FLAGS & DriverCAN_FD) && !FD)) {
+    return DriverCAN_ERROR;
+  }
+  (PEER ? PEER : this)->Deliver(Frame);
+  return DriverCAN_OK;
+}
+/* ==================================================================================================== */
+
+
+/* ==================================================================================================== */
+/**
+ * @end       End of File DriverLoopback.h
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+#endif  // _DriverLoopback
+/* ==================================================================================================== */
@@ -0,0 +1,410 @@
+/* ==================================================================================================== */
+/*
+*  DriverMux.h
+*  CAN Device Multiplexer
+*    ISO: 11898 Part 1 - Controller Area Network (CAN)
+*  Version: v1.0:0
+*  Developed By: Alakshendra Singh
+*  For Reporting Any Issue Don't Contact Me. Fix Yourself
+*/
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @file        DriverMux.h
+ * @author      Alakshendra Singh
+ * @brief       One CAN Device Shared by Many ISO_DoCAN Connections, Demultiplexed on Receive ID
+ * @version     1.0
+ *
+ * Every Port is a DriverCAN of Its Own. One Reader Thread Drains the Device and Pushes Each Frame
+ * Into the Ring of Every Open Port Whose Filter Takes It, Writes From All Ports Are Serialized.
+ * The Device Filter is the Range Given at Construction, Port Filters Are Applied in Software so a
+ * Port Changing Its Filter Never Flushes Frames Queued for Another One.
+ *
+ * @copyright   Copyright (c) 2025
+ */
+/* ==================================================================================================== */
+
+#ifndef _DriverMux
+#define _DriverMux
+
+#include <iostream>
+#include <stdint.h>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <memory>
+#include <string>
+#include "DriverCAN.hpp"
+#include "FrameRing.hpp"
+
+using namespace std;
+
+#define DriverMux_PORTS                   32
+#define DriverMux_DEPTH                   1024
+#define DriverMux_POLL                    10000
+
+
+
+/* ==================================================================================================== */
+/**
+ * @class       DriverMux
+ * @brief       CAN Device Multiplexer, Hands Out Up To DriverMux_PORTS Ports
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+class DriverMux {
+  public:
+
+    class Port : public DriverCAN {
+      friend class DriverMux;
+
+      private:
+        DriverMux * MUX;
+        FrameRing<DriverMux_DEPTH> RX;
+        std::atomic<uint8_t> OPEN;
+        uint32_t FILTER_LOW;
+        uint32_t FILTER_HIGH;
+        uint8_t FILTER_TYPE;
+
+      public:
+
+        Port (DriverMux * Mux) {
+          MUX = Mux; OPEN = 0;
+          FILTER_LOW = 0; FILTER_HIGH = 0x1FFFFFFF; FILTER_TYPE = DriverCAN_STANDARD;
+        }
+
+        uint64_t Dropped (void) { return RX.Dropped(); }
+
+        uint8_t Open (uint16_t KBPS) override;
+        uint8_t OpenFD (const char * BitRate) override;
+        uint8_t Close (void) override;
+        uint8_t SetFilter (uint32_t Low, uint32_t High, uint8_t Type = DriverCAN_STANDARD) override;
+        uint8_t ReadFrame (FRAME &Frame, uint64_t Timeout = 0) override;
+        uint8_t WriteFrame (const FRAME &Frame) override;
+        uint16_t WriteBatch (const FRAME * Frames, uint16_t Count) override;
+        uint8_t Buffered (void) override { return 1; }
+        void Interrupt (void) override { RX.Interrupt(); }
+    };
+
+  private:
+    DriverCAN * DEVICE;
+    std::unique_ptr<Port> PORTS[DriverMux_PORTS];
+    uint8_t COUNT;
+    uint32_t LOW;
+    uint32_t HIGH;
+    uint8_t TYPE;
+    uint16_t KBPS;
+    std::string BITRATE;                        // FD Bit Rate the Device Was Opened With, Empty For Classic
+    uint8_t USERS;
+    std::mutex STATE;                           // Device Open State, Speed, Users and Reader Thread
+    std::mutex LOCK;                            // Port Table and Filters, Taken by the Reader per Frame
+    std::mutex WRITE;                           // One Writer on the Device at a Time
+    std::thread READER;
+    std::atomic<uint8_t> READING;
+    std::atomic<uint64_t> UNCLAIMED;
+
+    void ReaderLoop (void);
+    uint8_t Acquire (uint16_t KBPS, const char * BitRate = nullptr);
+    void Release (void);
+    void StopReader (void);
+
+  public:
+
+    DriverMux (DriverCAN &Device, uint32_t Low = 0x000, uint32_t High = 0x7FF, uint8_t Type = DriverCAN_STANDARD) {
+      DEVICE = &Device; COUNT = 0; LOW = Low; HIGH = High; TYPE = Type; KBPS = 0; USERS = 0;
+      READING = 0; UNCLAIMED = 0;
+      cout << "\nCAN Multiplexer Loaded";
+    }
+    ~DriverMux (void) {
+      std::lock_guard<std::mutex> Guard(STATE);
+      StopReader();
+      if (USERS) {
+        DEVICE->Close();
+      }
+      cout << "\nCAN Multiplexer Unloaded";
+    }
+
+    Port * NewPort (void);
+    uint64_t Unclaimed (void) { return UNCLAIMED; }
+};
+/* ==================================================================================================== */
+
+
+/* ==================================================================================================== */
+/**
+ * @name        ReaderLoop
+ * @class       DriverMux (Private)
+ * @brief       Reader Thread : Block in the Device and Hand Each Frame to the Ports Whose Filter Takes It
+ * @param []    Nothing
+ * @return      Nothing
+ *
+ * Each Port Ring Has This Thread as Its Only Producer, Frames No Port Takes Are Counted as UNCLAIMED.
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+void DriverMux::ReaderLoop (void) {
+  while (READING.load(std::memory_order_relaxed)) {
+    DriverCAN::FRAME Frame;
+    uint8_t Status = DEVICE->ReadFrame(Frame, DriverMux_POLL);
+    if (Status == DriverCAN_ERROR) {
+      std::this_thread::sleep_for(std::chrono::microseconds(DriverMux_POLL));
+      continue;
+    }
+    if (Status != DriverCAN_OK) {
+      continue;
+    }
+    if (Frame.TIME == 0) {
+      Frame.TIME = DriverCAN::Clock();          // Device Left It Without a Timestamp
+    }
+    uint8_t Claimed = 0;
+    std::lock_guard<std::mutex> Guard(LOCK);
+    for (uint8_t I = 0; I < COUNT; I++) {
+      Port &Target = *PORTS[I];
+      if (Target.OPEN && (Frame.TYPE == Target.FILTER_TYPE) &&
+          (Frame.ID >= Target.FILTER_LOW) && (Frame.ID <= Target.FILTER_HIGH)) {
+        Target.RX.Push(Frame);
+        Claimed = 1;
+      }
+    }
+    if (!Claimed) {
+      UNCLAIMED.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Acquire
+ * @class       DriverMux (Private)
+ * @brief       Open the Device for One More Port, Reopening It if the Speed Changes (Caller Holds STATE)
+ * @param [KBPS]      Speed in KBPS, the Bus Has One Speed so It Applies to Every Port
+ * @param [BitRate]   FD Bit Rate String, nullptr Opens the Device For Classic CAN
+ * @return      DriverCAN Status
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t DriverMux::Acquire (uint16_t KBPS, const char * BitRate) {
+  std::string Rate = BitRate ? BitRate : "";
+  if (USERS && (KBPS == this->KBPS) && (Rate == BITRATE)) {
+    USERS++;
+    return DriverCAN_OK;
+  }
+  StopReader();                                 // The Device is Not Reopened Under the Reader
+  if (USERS) {
+    DEVICE->Close();
+  }
+  uint8_t Status = BitRate ? DEVICE->OpenFD(BitRate) : DEVICE->Open(KBPS);
+  if ((Status != DriverCAN_OK) || (DEVICE->SetFilter(LOW, HIGH, TYPE) != DriverCAN_OK)) {
+    DEVICE->Close();
+    USERS = 0;
+    return DriverCAN_ERROR;
+  }
+  this->KBPS = KBPS;
+  BITRATE = Rate;
+  USERS++;
+  READING = 1;
+  READER = std::thread(&DriverMux::ReaderLoop, this);
+  return DriverCAN_OK;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Release
+ * @class       DriverMux (Private)
+ * @brief       One Port Less on the Device, the Last One Closes It (Caller Holds STATE)
+ * @param []    Nothing
+ * @return      Nothing
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+void DriverMux::Release (void) {
+  if (USERS && (--USERS == 0)) {
+    StopReader();
+    DEVICE->Close();
+  }
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        StopReader
+ * @class       DriverMux (Private)
+ * @brief       Stop the Reader Thread, Returns Within One DriverMux_POLL (Caller Holds STATE, Not LOCK)
+ * @param []    Nothing
+ * @return      Nothing
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+void DriverMux::StopReader (void) {
+  READING = 0;
+  if (READER.joinable()) {
+    READER.join();
+  }
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        NewPort
+ * @class       DriverMux (Public)
+ * @brief       New Port on the Device, Owned by the Multiplexer
+ * @param []    Nothing
+ * @return      Port, nullptr When All DriverMux_PORTS Are Taken
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+DriverMux::Port * DriverMux::NewPort (void) {
+  std::lock_guard<std::mutex> Guard(LOCK);
+  if (COUNT >= DriverMux_PORTS) {
+    return nullptr;
+  }
+  PORTS[COUNT].reset(new Port(this));
+  return PORTS[COUNT++].get();
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Open
+ * @class       DriverMux::Port (Public)
+ * @brief       Start Receiving on This Port, the Device is Opened by the First Port
+ * @param [KBPS]    Speed in KBPS
+ * @return      DriverCAN Status
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t DriverMux::Port::Open (uint16_t KBPS) {
+  std::lock_guard<std::mutex> Guard(MUX->STATE);
+  if (OPEN.exchange(0)) {
+    MUX->Release();
+  }
+  if (MUX->Acquire(KBPS) != DriverCAN_OK) {
+    return DriverCAN_ERROR;
+  }
+  RX.Clear();
+  OPEN = 1;
+  return DriverCAN_OK;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        OpenFD
+ * @class       DriverMux::Port (Public)
+ * @brief       Start Receiving on This Port With the Device in CAN FD, Reopened if Classic Before
+ * @param [BitRate]   FD Bit Rate String of the Device
+ * @return      DriverCAN Status
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t DriverMux::Port::OpenFD (const char * BitRate) {
+  std::lock_guard<std::mutex> Guard(MUX->STATE);
+  if (OPEN.exchange(0)) {
+    MUX->Release();
+  }
+  if (MUX->Acquire(0, BitRate) != DriverCAN_OK) {
+    return DriverCAN_ERROR;
+  }
+  RX.Clear();
+  OPEN = 1;
+  return DriverCAN_OK;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Close
+ * @class       DriverMux::Port (Public)
+ * @brief       Stop Receiving on This Port, the Device is Closed With the Last Port
+ * @param []    Nothing
+ * @return      DriverCAN Status
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t DriverMux::Port::Close (void) {
+  std::lock_guard<std::mutex> Guard(MUX->STATE);
+  if (OPEN.exchange(0)) {
+    MUX->Release();
+  }
+  RX.Interrupt();
+  return DriverCAN_OK;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        SetFilter
+ * @class       DriverMux::Port (Public)
+ * @brief       Range Filter of This Port, Frames Already Queued Are Dropped
+ * @param [Low]       CAN ID Lower Limit
+ * @param [High]      CAN ID Upper Limit
+ * @param [Type]      Standard or Extended CAN ID
+ * @return      DriverCAN Status
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t DriverMux::Port::SetFilter (uint32_t Low, uint32_t High, uint8_t Type) {
+  std::lock_guard<std::mutex> Guard(MUX->LOCK);
+  FILTER_LOW = Low; FILTER_HIGH = High; FILTER_TYPE = Type;
+  RX.Clear();
+  return DriverCAN_OK;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        ReadFrame
+ * @class       DriverMux::Port (Public)
+ * @brief       Read One Frame From This Port's Ring, Waiting Until It Arrives or the Timeout Passes
+ * @param [Frame]     Received Frame
+ * @param [Timeout]   Longest Wait in MicroSeconds, Zero Polls Once
+ * @return      DriverCAN Status
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t DriverMux::Port::ReadFrame (FRAME &Frame, uint64_t Timeout) {
+  if (!OPEN && !RX.Size()) {
+    return DriverCAN_ERROR;
+  }
+  return RX.Pop(Frame, Timeout);
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        WriteFrame
+ * @class       DriverMux::Port (Public)
+ * @brief       Write a Frame on the Shared Device
+ * @param [Frame]     Frame to Write
+ * @return      DriverCAN Status
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t DriverMux::Port::WriteFrame (const FRAME &Frame) {
+  if (!OPEN) {
+    return DriverCAN_ERROR;
+  }
+  std::lock_guard<std::mutex> Guard(MUX->WRITE);
+  return MUX->DEVICE->WriteFrame(Frame);
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        WriteBatch
+ * @class       DriverMux::Port (Public)
+ * @brief       Write Frames on the Shared Device in One Device Batch, Kept Together on the Bus
+ * @param [Frames]    Frames to Write
+ * @param [Count]     Number of Frames
+ * @return      Number of Frames Written Before the First Failure
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint16_t DriverMux::Port::WriteBatch (const FRAME * Frames, uint16_t Count) {
+  if (!OPEN) {
+    return 0;
+  }
+  std::lock_guard<std::mutex> Guard(MUX->WRITE);
+  return MUX->DEVICE->WriteBatch(Frames, Count);
+}
+/* ==================================================================================================== */
+
+
+/* ==================================================================================================== */
+/**
+ * @end       End of File DriverMux.h
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+#endif  // _DriverMux
+/* ==================================================================================================== */
@@ -16,6 +16,9 @@
  * @brief       PCAN Driver Operation
  * @version     1.0
  *
+ * One DriverPCAN per Channel (PCAN_USBBUS1 to PCAN_USBBUS16), Each With Its Own Receive Event, so
+ * Every Bus Keeps Its Own Traffic and Its Own Reader Thread in ISO_DoCAN or DriverMux.
+ *
  * @copyright   Copyright (c) 2025
  */
 /* ==================================================================================================== */
@@ -27,51 +30,107 @@
 #include <iostream>
 #include <stdio.h>
 #include <stdint.h>
+#include <string.h>
 #include <cstdio>
 #include <iomanip>
-#include "..\PCANBasic.h"
+#include <chrono>
+#include "../PCANBasic.h"
+#include "DriverCAN.hpp"
 
 using namespace std;
 
+// 80 MHz Clock : 500 kbit/s Arbitration (80 tq), 2 or 4 Mbit/s Data Phase, Sample Points 80 %
+#define DriverPCAN_FD_500K_2M  "f_clock_mhz=80, nom_brp=2, nom_tseg1=63, nom_tseg2=16, nom_sjw=16, " \
+                               "data_brp=2, data_tseg1=15, data_tseg2=4, data_sjw=4"
+#define DriverPCAN_FD_500K_4M  "f_clock_mhz=80, nom_brp=2, nom_tseg1=63, nom_tseg2=16, nom_sjw=16, " \
+                               "data_brp=2, data_tseg1=7, data_tseg2=2, data_sjw=2"
+
 /* ==================================================================================================== */
 /**
  * @class       DriverPCAN
- * @brief       PCAN Driver For CAN According To ISO 11898-1
+ * @brief       PCAN Driver For CAN According To ISO 11898-1, DriverCAN Backend
  */
 /* ---------------------------------------------------------------------------------------------------- */
-class DriverPCAN {
+class DriverPCAN : public DriverCAN {
   private:
+    TPCANHandle CHANNEL;
+    uint8_t FD;                                 // Channel Initialized With CAN_InitializeFD
+#ifdef _WIN32
+    HANDLE EVENT;
+#endif
+
+    void WaitEvent (uint64_t Timeout);
+    uint8_t ReadFrameFD (FRAME &Frame, uint64_t Timeout);
+    uint8_t WriteFrameFD (const FRAME &Frame);
 
   public:
-    TPCANMsg MESSAGE;
 
-    DriverPCAN (void) {
-      cout << "\nPeak System's PCAN Driver Loaded";
+    DriverPCAN (TPCANHandle Channel = PCAN_USBBUS1) {
+      CHANNEL = Channel;
+      FD = 0;
+#ifdef _WIN32
+      EVENT = CreateEvent(NULL, FALSE, FALSE, NULL);
+#endif
+      cout << "\nPeak System's PCAN Driver Loaded On Channel 0x" << hex << CHANNEL << dec;
     }
     ~DriverPCAN (void) {
+#ifdef _WIN32
+      if (EVENT) {
+        CloseHandle(EVENT);
+      }
+#endif
       cout << "\nPeak System's PCAN Driver Unloaded";
     }
 
+    static TPCANHandle USBChannel (uint8_t Bus);
+    TPCANHandle Channel (void) { return CHANNEL; }
+
     TPCANStatus Initialize (uint16_t KBPS);
     TPCANStatus Initialize (void);
     TPCANStatus Uninitialize (void);
 
     uint8_t Write (DWORD CanID, BYTE Data[], BYTE Length = 8, TPCANMessageType Type =
         PCAN_MESSAGE_STANDARD);
-    uint8_t Write (TPCANMsg MSG);
+    uint8_t Write (const TPCANMsg &MSG);
 
     TPCANStatus Read (TPCANMsg &MSG, TPCANTimestamp &Time);
     TPCANStatus Read (TPCANMsg &MSG);
 
-    void Show (TPCANMsg MSG, TPCANTimestamp Time);
-    void Show (TPCANMsg MSG);
+    void Show (const TPCANMsg &MSG, const TPCANTimestamp &Time);
+    void Show (const TPCANMsg &MSG);
 
     TPCANStatus Filter (DWORD CanID1, DWORD CanID2, TPCANMessageType Type);
     TPCANStatus Filter (DWORD CanID, TPCANMessageType Type = PCAN_MESSAGE_STANDARD);
+
+    uint8_t Open (uint16_t KBPS) override;
+    uint8_t OpenFD (const char * BitRate) override;
+    uint8_t Close (void) override;
+    uint8_t SetFilter (uint32_t Low, uint32_t High, uint8_t Type = DriverCAN_STANDARD) override;
+    uint8_t ReadFrame (FRAME &Frame, uint64_t Timeout = 0) override;
+    uint8_t WriteFrame (const FRAME &Frame) override;
 };
 /* ==================================================================================================== */
 
 
+/* ==================================================================================================== */
+/**
+ * @name        USBChannel
+ * @class       DriverPCAN (Public)
+ * @brief       PCAN-USB Channel Handle of a Bus Number
+ * @param [Bus]     Bus Number, 1 to 16
+ * @return      PCAN Channel Handle, PCAN_NONEBUS Outside 1 to 16
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+TPCANHandle DriverPCAN::USBChannel (uint8_t Bus) {
+  static const TPCANHandle Channels[16] = {
+    PCAN_USBBUS1, PCAN_USBBUS2, PCAN_USBBUS3, PCAN_USBBUS4, PCAN_USBBUS5, PCAN_USBBUS6,
+    PCAN_USBBUS7, PCAN_USBBUS8, PCAN_USBBUS9, PCAN_USBBUS10, PCAN_USBBUS11, PCAN_USBBUS12,
+    PCAN_USBBUS13, PCAN_USBBUS14, PCAN_USBBUS15, PCAN_USBBUS16
+  };
+  return ((Bus >= 1) && (Bus <= 16)) ? Channels[Bus - 1] : (TPCANHandle)PCAN_NONEBUS;
+}
+/* ==================================================================================================== */
+
 /* ==================================================================================================== */
 /**
  * @name        Initialize (Overloaded)
@@ -84,13 +143,16 @@ class DriverPCAN {
 TPCANStatus DriverPCAN::Initialize (uint16_t KBPS) {
   TPCANStatus Status;
   TPCANBaudrate Speed = PCAN_BAUD_500K;
-  cout << "\nDriver For Single Channel Peak System's PCAN Tool";
+  cout << "\nDriver For Peak System's PCAN Tool, Channel 0x" << hex << CHANNEL << dec;
   if (KBPS == 500) {
     Speed = PCAN_BAUD_500K;
     cout << "\nPCAN Speed Set To 500KBPS";
   } else if (KBPS == 250) {
     Speed = PCAN_BAUD_250K;
     cout << "\nPCAN Speed Set To 250KBPS";
+  } else if (KBPS == 125) {
+    Speed = PCAN_BAUD_125K;
+    cout << "\nPCAN Speed Set To 125KBPS";
   } else if (KBPS == 1000) {
     Speed = PCAN_BAUD_1M;
     cout << "\nPCAN Speed Set To 1MBPS";
@@ -100,7 +162,7 @@ TPCANStatus DriverPCAN::Initialize (uint16_t KBPS) {
   }
 
   do {
-    Status = CAN_Initialize(PCAN_USBBUS1, Speed);
+    Status = CAN_Initialize(CHANNEL, Speed);
     if (Status != PCAN_ERROR_OK) {
       cout << "\nPCAN Initialization Failed! \nConnect Device Properly";
       Sleep(5000);
@@ -124,7 +186,7 @@ TPCANStatus DriverPCAN::Initialize (uint16_t KBPS) {
 TPCANStatus DriverPCAN::Initialize (void) {
   TPCANStatus Status;
   do {
-    Status = CAN_Initialize(PCAN_USBBUS1, PCAN_BAUD_500K);
+    Status = CAN_Initialize(CHANNEL, PCAN_BAUD_500K);
     if (Status != PCAN_ERROR_OK) {
       cout << "\nPCAN Initialization Failed! \nConnect Device Properly";
       Sleep(5000);
@@ -147,7 +209,8 @@ TPCANStatus DriverPCAN::Initialize (void) {
 /* ---------------------------------------------------------------------------------------------------- */
 TPCANStatus DriverPCAN::Uninitialize (void) {
   TPCANStatus Status;
-  Status = CAN_Uninitialize(PCAN_USBBUS1);
+  Status = CAN_Uninitialize(CHANNEL);
+  FD = 0;
   cout << "\nPCAN Uninitialized\nSafe To Disconnect";
   return Status;
 }
@@ -176,7 +239,7 @@ uint8_t DriverPCAN::Write (DWORD CanID, BYTE Data[], BYTE Length, TPCANMessageTy
   TPCANStatus Status;
   BYTE I = 0;
   do {
-    Status = CAN_Write(PCAN_USBBUS1, &MSG);
+    Status = CAN_Write(CHANNEL, &MSG);
     I++;
   } while ((Status != PCAN_ERROR_OK) && ( I < 5));
   return ((Status != PCAN_ERROR_OK) ? 1 : 0);
@@ -192,11 +255,11 @@ uint8_t DriverPCAN::Write (DWORD CanID, BYTE Data[], BYTE Length, TPCANMessageTy
  * @return      Status of PCAN
  */
 /* ---------------------------------------------------------------------------------------------------- */
-uint8_t DriverPCAN::Write (TPCANMsg MSG) {
+uint8_t DriverPCAN::Write (const TPCANMsg &MSG) {
   TPCANStatus Status;
   BYTE I = 0;
   do {
-    Status = CAN_Write(PCAN_USBBUS1, &MSG);
+    Status = CAN_Write(CHANNEL, const_cast<TPCANMsg *>(&MSG));   // PCAN-Basic Only Reads It
     I++;
   } while ((Status != PCAN_ERROR_OK) && ( I < 5));
   return ((Status != PCAN_ERROR_OK) ? 1 : 0);
@@ -215,7 +278,7 @@ uint8_t DriverPCAN::Write (TPCANMsg MSG) {
 /* ---------------------------------------------------------------------------------------------------- */
 TPCANStatus DriverPCAN::Read (TPCANMsg &MSG, TPCANTimestamp &Time) {
   TPCANStatus Status;
-  Status = CAN_Read(PCAN_USBBUS1, &MSG, &Time);
+  Status = CAN_Read(CHANNEL, &MSG, &Time);
   return Status;
 }
 /* ==================================================================================================== */
@@ -232,7 +295,7 @@ TPCANStatus DriverPCAN::Read (TPCANMsg &MSG, TPCANTimestamp &Time) {
 TPCANStatus DriverPCAN::Read (TPCANMsg &MSG) {
   TPCANTimestamp Time;
   TPCANStatus Status;
-  Status = CAN_Read(PCAN_USBBUS1, &MSG, &Time);
+  Status = CAN_Read(CHANNEL, &MSG, &Time);
   return Status;
 }
 /* ==================================================================================================== */
@@ -247,7 +310,7 @@ TPCANStatus DriverPCAN::Read (TPCANMsg &MSG) {
  * @return      Nothing
  */
 /* ---------------------------------------------------------------------------------------------------- */
-void DriverPCAN::Show (TPCANMsg MSG, TPCANTimestamp Time) {
+void DriverPCAN::Show (const TPCANMsg &MSG, const TPCANTimestamp &Time) {
   uint64_t uSec = 0;
   uSec = Time.micros + (1000ULL * Time.millis) + (0x100000000ULL * 1000ULL * Time.millis_overflow);
   cout << std::hex << std::uppercase << std::setw(16) << std::setfill('0') << "\nTime (us) : " << uSec;
@@ -269,7 +332,7 @@ void DriverPCAN::Show (TPCANMsg MSG, TPCANTimestamp Time) {
  * @return      Nothing
  */
 /* ---------------------------------------------------------------------------------------------------- */
-void DriverPCAN::Show (TPCANMsg MSG) {
+void DriverPCAN::Show (const TPCANMsg &MSG) {
   cout << "\nCAN : ";
   cout << std::hex << std::uppercase << std::setw(3) << std::setfill('0') << MSG.ID;
   cout << std::dec;
@@ -297,11 +360,11 @@ void DriverPCAN::Show (TPCANMsg MSG) {
 /* ---------------------------------------------------------------------------------------------------- */
 TPCANStatus DriverPCAN::Filter (DWORD CanID1, DWORD CanID2, TPCANMessageType Type) {
   TPCANStatus Status;
-  Status = CAN_FilterMessages(PCAN_USBBUS1, CanID1, CanID2, Type);
+  Status = CAN_FilterMessages(CHANNEL, CanID1, CanID2, Type);
   if (PCAN_ERROR_OK != Status) {
     return Status;
   }
-  Status = CAN_Reset(PCAN_USBBUS1);
+  Status = CAN_Reset(CHANNEL);
   return Status;
 }
 /* ==================================================================================================== */
@@ -318,15 +381,263 @@ TPCANStatus DriverPCAN::Filter (DWORD CanID1, DWORD CanID2, TPCANMessageType Typ
 /* ---------------------------------------------------------------------------------------------------- */
 TPCANStatus DriverPCAN::Filter (DWORD CanID, TPCANMessageType Type) {
   TPCANStatus Status;
-  Status = CAN_FilterMessages(PCAN_USBBUS1, CanID, CanID, Type);
+  Status = CAN_FilterMessages(CHANNEL, CanID, CanID, Type);
   if (PCAN_ERROR_OK != Status) {
     return Status;
   }
-  Status = CAN_Reset(PCAN_USBBUS1);
+  Status = CAN_Reset(CHANNEL);
   return Status;
 }
 /* ==================================================================================================== */
 
+/* ==================================================================================================== */
+/**
+ * @name        WaitEvent
+ * @class       DriverPCAN (Private)
+ * @brief       Sleep Until the Driver Signals a Received Frame, Without the Event a MilliSecond Nap
+ * @param [Timeout]   Longest Wait in MicroSeconds
+ * @return      Nothing
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+void DriverPCAN::WaitEvent (uint64_t Timeout) {
+#ifdef _WIN32
+  if (EVENT) {
+    WaitForSingleObject(EVENT, (DWORD)((Timeout + 999) / 1000));
+    return;
+  }
+#endif
+  (void)Timeout;
+  Sleep(1);
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Open
+ * @class       DriverPCAN (Public)
+ * @brief       DriverCAN Open, Same as Initialize
+ * @param [KBPS]    Speed in KBPS
+ * @return      DriverCAN Status
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t DriverPCAN::Open (uint16_t KBPS) {
+  if (Initialize(KBPS) != PCAN_ERROR_OK) {
+    return DriverCAN_ERROR;
+  }
+#ifdef _WIN32
+  if (EVENT) {
+    CAN_SetValue(CHANNEL, PCAN_RECEIVE_EVENT, &EVENT, sizeof(EVENT));
+  }
+#endif
+  return DriverCAN_OK;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        OpenFD
+ * @class       DriverPCAN (Public)
+ * @brief       DriverCAN Open For CAN FD, Frames Then Go Through CAN_ReadFD and CAN_WriteFD
+ * @param [BitRate]   PCAN-Basic FD Bit Rate String, e.g. DriverPCAN_FD_500K_2M
+ * @return      DriverCAN Status
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t DriverPCAN::OpenFD (const char * BitRate) {
+  cout << "\nDriver For Peak System's PCAN Tool, Channel 0x" << hex << CHANNEL << dec << " (CAN FD)";
+  if (CAN_InitializeFD(CHANNEL, (TPCANBitrateFD)BitRate) != PCAN_ERROR_OK) {
+    cout << "\nPCAN FD Initialization Failed";
+    return DriverCAN_ERROR;
+  }
+  cout << "\nPCAN FD Initialized Successfully\nPCAN Ready For Use";
+  FD = 1;
+#ifdef _WIN32
+  if (EVENT) {
+    CAN_SetValue(CHANNEL, PCAN_RECEIVE_EVENT, &EVENT, sizeof(EVENT));
+  }
+#endif
+  return DriverCAN_OK;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Close
+ * @class       DriverPCAN (Public)
+ * @brief       DriverCAN Close, Same as Uninitialize
+ * @param []    Nothing
+ * @return      DriverCAN Status
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t DriverPCAN::Close (void) {
+#ifdef _WIN32
+  HANDLE None = NULL;
+  CAN_SetValue(CHANNEL, PCAN_RECEIVE_EVENT, &None, sizeof(None));
+#endif
+  return (Uninitialize() == PCAN_ERROR_OK) ? DriverCAN_OK : DriverCAN_ERROR;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        SetFilter
+ * @class       DriverPCAN (Public)
+ * @brief       DriverCAN Filter, Range Filter at Hardware Level
+ * @param [Low]       CAN ID Lower Limit
+ * @param [High]      CAN ID Upper Limit
+ * @param [Type]      Standard or Extended CAN ID
+ * @return      DriverCAN Status
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t DriverPCAN::SetFilter (uint32_t Low, uint32_t High, uint8_t Type) {
+  TPCANMessageType Mode = (Type == DriverCAN_EXTENDED) ? PCAN_MESSAGE_EXTENDED : PCAN_MESSAGE_STANDARD;
+  return (Filter((DWORD)Low, (DWORD)High, Mode) == PCAN_ERROR_OK) ? DriverCAN_OK : DriverCAN_ERROR;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        ReadFrame
+ * @class       DriverPCAN (Public)
+ * @brief       DriverCAN Read, Sleeping on the PCAN Receive Event Until a Frame or the Timeout
+ * @param [Frame]     Received Frame, PCAN Hardware Timestamp in HWTIME
+ * @param [Timeout]   Longest Wait in MicroSeconds, Zero Polls Once
+ * @return      DriverCAN Status
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t DriverPCAN::ReadFrame (FRAME &Frame, uint64_t Timeout) {
+  if (FD) {
+    return ReadFrameFD(Frame, Timeout);
+  }
+  TPCANMsg MSG;
+  TPCANTimestamp Time;
+  TPCANStatus Status = Read(MSG, Time);
+  if ((Status == PCAN_ERROR_QRCVEMPTY) && Timeout) {
+    auto Exit = std::chrono::steady_clock::now() + std::chrono::microseconds(Timeout);
+    do {
+      uint64_t Left = std::chrono::duration_cast<std::chrono::microseconds>(
+          Exit - std::chrono::steady_clock::now()).count();
+      WaitEvent(Left);
+      Status = Read(MSG, Time);
+    } while ((Status == PCAN_ERROR_QRCVEMPTY) && (std::chrono::steady_clock::now() < Exit));
+  }
+  if (Status == PCAN_ERROR_QRCVEMPTY) {
+    return DriverCAN_EMPTY;
+  }
+  if (Status != PCAN_ERROR_OK) {
+    return DriverCAN_ERROR;
+  }
+  Frame.ID = MSG.ID;
+  Frame.LEN = (MSG.LEN > 8) ? 8 : MSG.LEN;
+  Frame.TYPE = (MSG.MSGTYPE & PCAN_MESSAGE_EXTENDED) ? DriverCAN_EXTENDED : DriverCAN_STANDARD;
+  Frame.FLAGS = DriverCAN_CLASSIC;
+  memcpy(Frame.DATA, MSG.DATA, 8);
+  Frame.TIME = Clock();
+  Frame.HWTIME = Time.micros + (1000ULL * Time.millis) + (0x100000000ULL * 1000ULL * Time.millis_overflow);
+  return DriverCAN_OK;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        ReadFrameFD
+ * @class       DriverPCAN (Private)
+ * @brief       ReadFrame on an FD Channel, Classic and FD Frames Both Arrive Through CAN_ReadFD
+ * @param [Frame]     Received Frame, PCAN Hardware Timestamp in HWTIME
+ * @param [Timeout]   Longest Wait in MicroSeconds, Zero Polls Once
+ * @return      DriverCAN Status
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t DriverPCAN::ReadFrameFD (FRAME &Frame, uint64_t Timeout) {
+  TPCANMsgFD MSG;
+  TPCANTimestampFD Time;
+  TPCANStatus Status = CAN_ReadFD(CHANNEL, &MSG, &Time);
+  if ((Status == PCAN_ERROR_QRCVEMPTY) && Timeout) {
+    auto Exit = std::chrono::steady_clock::now() + std::chrono::microseconds(Timeout);
+    do {
+      uint64_t Left = std::chrono::duration_cast<std::chrono::microseconds>(
+          Exit - std::chrono::steady_clock::now()).count();
+      WaitEvent(Left);
+      Status = CAN_ReadFD(CHANNEL, &MSG, &Time);
+    } while ((Status == PCAN_ERROR_QRCVEMPTY) && (std::chrono::steady_clock::now() < Exit));
+  }
+  if (Status == PCAN_ERROR_QRCVEMPTY) {
+    return DriverCAN_EMPTY;
+  }
+  if (Status != PCAN_ERROR_OK) {
+    return DriverCAN_ERROR;
+  }
+  Frame.ID = MSG.ID;
+  Frame.LEN = DLCToLength(MSG.DLC);
+  Frame.TYPE = (MSG.MSGTYPE & PCAN_MESSAGE_EXTENDED) ? DriverCAN_EXTENDED : DriverCAN_STANDARD;
+  Frame.FLAGS = ((MSG.MSGTYPE & PCAN_MESSAGE_FD) ? DriverCAN_FD : 0) | ((MSG.MSGTYPE & PCAN_MESSAGE_BRS) ? DriverCAN_BRS : 0);
+  if (!(Frame.FLAGS & DriverCAN_FD) && (Frame.LEN > 8)) {
+    Frame.LEN = 8;                              // Classic DLC 9 to 15 Still Means 8 Bytes
+  }
+  memcpy(Frame.DATA, MSG.DATA, Frame.LEN);
+  Frame.TIME = Clock();
+  Frame.HWTIME = Time;
+  return DriverCAN_OK;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        WriteFrame
+ * @class       DriverPCAN (Public)
+ * @brief       DriverCAN Write
+ * @param [Frame]     Frame to Write
+ * @return      DriverCAN Status
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t DriverPCAN::WriteFrame (const FRAME &Frame) {
+  if (FD) {
+    return WriteFrameFD(Frame);
+  }
+  if (Frame.FLAGS & DriverCAN_FD) {
+    return DriverCAN_ERROR;                     // FD Frame on a Classic Channel
+  }
+  TPCANMsg MSG;
+  MSG.ID = Frame.ID;
+  MSG.LEN = Frame.LEN;
+  MSG.MSGTYPE = (Frame.TYPE == DriverCAN_EXTENDED) ? PCAN_MESSAGE_EXTENDED : PCAN_MESSAGE_STANDARD;
+  memcpy(MSG.DATA, Frame.DATA, 8);
+  return Write(MSG) ? DriverCAN_ERROR : DriverCAN_OK;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        WriteFrameFD
+ * @class       DriverPCAN (Private)
+ * @brief       WriteFrame on an FD Channel, Length Mapped to the DLC, FD and BRS From the Frame Flags
+ * @param [Frame]     Frame to Write
+ * @return      DriverCAN Status
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t DriverPCAN::WriteFrameFD (const FRAME &Frame) {
+  TPCANMsgFD MSG;
+  MSG.ID = Frame.ID;
+  MSG.DLC = LengthToDLC(Frame.LEN);
+  MSG.MSGTYPE = (Frame.TYPE == DriverCAN_EXTENDED) ? PCAN_MESSAGE_EXTENDED : PCAN_MESSAGE_STANDARD;
+  if (Frame.FLAGS & DriverCAN_FD) {
+    MSG.MSGTYPE |= PCAN_MESSAGE_FD;
+    if (Frame.FLAGS & DriverCAN_BRS) {
+      MSG.MSGTYPE |= PCAN_MESSAGE_BRS;
+    }
+  }
+  uint8_t Length = DLCToLength(MSG.DLC);
+  memcpy(MSG.DATA, Frame.DATA, Frame.LEN);
+  memset(&MSG.DATA[Frame.LEN], 0x00, Length - Frame.LEN);
+  TPCANStatus Status;
+  BYTE I = 0;
+  do {
+    Status = CAN_WriteFD(CHANNEL, &MSG);
+    I++;
+  } while ((Status != PCAN_ERROR_OK) && ( I < 5));
+  return (Status != PCAN_ERROR_OK) ? DriverCAN_ERROR : DriverCAN_OK;
+}
+/* ==================================================================================================== */
+
 
 /* ==================================================================================================== */
 /**
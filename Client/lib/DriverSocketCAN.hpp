@@ -0,0 +1,418 @@
+/* ==================================================================================================== */
+/*
+*  DriverSocketCAN.h
+*  Linux SocketCAN Driver Operation
+*    ISO: 11898 Part 1 - Controller Area Network (CAN)
+*  Version: v1.0:0
+*  Developed By: Alakshendra Singh
+*  For Reporting Any Issue Don't Contact Me. Fix Yourself
+*/
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @file        DriverSocketCAN.h
+ * @author      Alakshendra Singh
+ * @brief       Linux SocketCAN Driver, DriverCAN Backend For can0, vcan0 and Friends
+ * @version     1.0
+ *
+ * The Bit Rate Belongs to the Network Interface (ip link set can0 type can bitrate 500000), a Raw
+ * Socket Cannot Change It, so Open Only Records KBPS. A vcan Interface Has No Bit Rate at All.
+ * The Same Holds For CAN FD (ip link set can0 type can bitrate 500000 dbitrate 2000000 fd on),
+ * OpenFD Only Lets the Socket Carry canfd_frame.
+ *
+ * @copyright   Copyright (c) 2025
+ */
+/* ==================================================================================================== */
+
+#ifndef _DriverSocketCAN
+#define _DriverSocketCAN
+
+#include <iostream>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#include <time.h>
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <linux/can.h>
+#include <linux/can/raw.h>
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
+#include "DriverCAN.hpp"
+
+using namespace std;
+
+#ifndef DriverSocketCAN_INTERFACE
+  #define DriverSocketCAN_INTERFACE       "can0"
+#endif
+
+#define DriverSocketCAN_BATCH             64
+
+#ifndef CANFD_FDF
+  #define CANFD_FDF                       0x04
+#endif
+
+
+
+/* ==================================================================================================== */
+/**
+ * @class       DriverSocketCAN
+ * @brief       SocketCAN Raw Socket Driver For CAN According To ISO 11898-1
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+class DriverSocketCAN : public DriverCAN {
+  private:
+    char INTERFACE[IFNAMSIZ];
+    int SOCKET;
+    uint8_t FD;                                 // CAN_RAW_FD_FRAMES Enabled on the Socket
+    uint16_t KBPS;
+    uint32_t FILTER_LOW;
+    uint32_t FILTER_HIGH;
+    uint8_t FILTER_TYPE;
+
+    static uint64_t Micros (const struct timespec &Time);
+    static uint64_t Arrival (uint64_t Stamp);
+
+  public:
+
+    DriverSocketCAN (const char * Interface = DriverSocketCAN_INTERFACE) {
+      strncpy(INTERFACE, Interface, IFNAMSIZ - 1);
+      INTERFACE[IFNAMSIZ - 1] = '\0';
+      SOCKET = -1; FD = 0; KBPS = 500;
+      FILTER_LOW = 0; FILTER_HIGH = CAN_EFF_MASK; FILTER_TYPE = DriverCAN_STANDARD;
+      cout << "\nSocketCAN Driver Loaded On " << INTERFACE;
+    }
+    ~DriverSocketCAN (void) {
+      Close();
+      cout << "\nSocketCAN Driver Unloaded";
+    }
+
+    uint8_t Open (uint16_t KBPS) override;
+    uint8_t OpenFD (const char * BitRate) override;
+    uint8_t Close (void) override;
+    uint8_t SetFilter (uint32_t Low, uint32_t High, uint8_t Type = DriverCAN_STANDARD) override;
+    uint8_t ReadFrame (FRAME &Frame, uint64_t Timeout = 0) override;
+    uint8_t WriteFrame (const FRAME &Frame) override;
+    uint16_t WriteBatch (const FRAME * Frames, uint16_t Count) override;
+};
+/* ==================================================================================================== */
+
+
+/* ==================================================================================================== */
+/**
+ * @name        Micros
+ * @class       DriverSocketCAN (Private)
+ * @brief       Kernel Timestamp to MicroSeconds
+ * @param [Time]    Timestamp
+ * @return      Time in MicroSeconds
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint64_t DriverSocketCAN::Micros (const struct timespec &Time) {
+  return ((uint64_t)Time.tv_sec * 1000000ULL) + ((uint64_t)Time.tv_nsec / 1000ULL);
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Arrival
+ * @class       DriverSocketCAN (Private)
+ * @brief       Kernel Receive Stamp (CLOCK_REALTIME) Moved Onto DriverCAN::Clock
+ * @param [Stamp]   Kernel Software Timestamp in MicroSeconds, Zero When There Was None
+ * @return      Receive Time on DriverCAN::Clock
+ *
+ * The Frame's Age is Taken on the Realtime Clock and Subtracted From Clock, so the Stamp Keeps the
+ * Kernel's Arrival Time. A Frame Older Than the Clock's Epoch Reads as Zero.
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint64_t DriverSocketCAN::Arrival (uint64_t Stamp) {
+  uint64_t Now = Clock();
+  if (Stamp == 0) {
+    return Now;
+  }
+  struct timespec Real;
+  clock_gettime(CLOCK_REALTIME, &Real);
+  uint64_t Age = (Micros(Real) > Stamp) ? (Micros(Real) - Stamp) : 0;
+  return (Now > Age) ? (Now - Age) : 0;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Open
+ * @class       DriverSocketCAN (Public)
+ * @brief       Bind a Raw CAN Socket to the Interface, Hardware Timestamps Requested When the NIC Has Them
+ * @param [KBPS]    Speed in KBPS, Recorded Only (Set by the Interface)
+ * @return      DriverCAN Status
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t DriverSocketCAN::Open (uint16_t KBPS) {
+  Close();
+  this->KBPS = KBPS;
+  SOCKET = socket(PF_CAN, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC, CAN_RAW);
+  if (SOCKET < 0) {
+    cout << "\nSocketCAN Socket Failed : " << strerror(errno);
+    return DriverCAN_ERROR;
+  }
+  struct ifreq Request;
+  memset(&Request, 0, sizeof(Request));
+  memcpy(Request.ifr_name, INTERFACE, IFNAMSIZ);
+  if (ioctl(SOCKET, SIOCGIFINDEX, &Request) < 0) {
+    cout << "\nSocketCAN Interface " << INTERFACE << " Not Found : " << strerror(errno);
+    Close();
+    return DriverCAN_ERROR;
+  }
+  struct sockaddr_can Address;
+  memset(&Address, 0, sizeof(Address));
+  Address.can_family = AF_CAN;
+  Address.can_ifindex = Request.ifr_ifindex;
+  if (bind(SOCKET, (struct sockaddr *)&Address, sizeof(Address)) < 0) {
+    cout << "\nSocketCAN Bind Failed : " << strerror(errno);
+    Close();
+    return DriverCAN_ERROR;
+  }
+  int Stamp = SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE |
+      SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+  if (setsockopt(SOCKET, SOL_SOCKET, SO_TIMESTAMPING, &Stamp, sizeof(Stamp)) < 0) {
+    int On = 1;
+    setsockopt(SOCKET, SOL_SOCKET, SO_TIMESTAMPNS, &On, sizeof(On));
+  }
+  SetFilter(FILTER_LOW, FILTER_HIGH, FILTER_TYPE);
+  cout << "\nSocketCAN Bound To " << INTERFACE << "\nSocketCAN Ready For Use";
+  return DriverCAN_OK;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        OpenFD
+ * @class       DriverSocketCAN (Public)
+ * @brief       Open, Then Enable CAN FD Frames on the Socket, the Interface Must Be Up in FD Mode
+ * @param [BitRate]   FD Bit Rate String, Ignored (Set by the Interface)
+ * @return      DriverCAN Status
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t DriverSocketCAN::OpenFD (const char * BitRate) {
+  (void)BitRate;
+  if (Open(KBPS) != DriverCAN_OK) {
+    return DriverCAN_ERROR;
+  }
+  int On = 1;
+  if (setsockopt(SOCKET, SOL_CAN_RAW, CAN_RAW_FD_FRAMES, &On, sizeof(On)) < 0) {
+    cout << "\nSocketCAN FD Frames Refused : " << strerror(errno);
+    Close();
+    return DriverCAN_ERROR;
+  }
+  FD = 1;
+  return DriverCAN_OK;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Close
+ * @class       DriverSocketCAN (Public)
+ * @brief       Close the Raw CAN Socket
+ * @param []    Nothing
+ * @return      DriverCAN Status
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t DriverSocketCAN::Close (void) {
+  if (SOCKET >= 0) {
+    close(SOCKET);
+    SOCKET = -1;
+  }
+  FD = 0;
+  return DriverCAN_OK;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        SetFilter
+ * @class       DriverSocketCAN (Public)
+ * @brief       Range Filter, the Kernel Passes the Common ID Prefix and the Range Is Checked on Read
+ * @param [Low]       CAN ID Lower Limit
+ * @param [High]      CAN ID Upper Limit
+ * @param [Type]      Standard or Extended CAN ID
+ * @return      DriverCAN Status
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t DriverSocketCAN::SetFilter (uint32_t Low, uint32_t High, uint8_t Type) {
+  FILTER_LOW = Low; FILTER_HIGH = High; FILTER_TYPE = Type;
+  if (SOCKET < 0) {
+    return DriverCAN_OK;
+  }
+  uint32_t Width = (Type == DriverCAN_EXTENDED) ? CAN_EFF_MASK : CAN_SFF_MASK;
+  uint32_t Mask = Width;
+  uint32_t Differ = (Low ^ High) & Width;
+  while (Differ) {
+    Mask &= ~Differ;
+    Differ >>= 1;
+  }
+  struct can_filter Filter;
+  Filter.can_id = (Low & Mask) | ((Type == DriverCAN_EXTENDED) ? CAN_EFF_FLAG : 0);
+  Filter.can_mask = Mask | CAN_EFF_FLAG | CAN_RTR_FLAG;
+  if (setsockopt(SOCKET, SOL_CAN_RAW, CAN_RAW_FILTER, &Filter, sizeof(Filter)) < 0) {
+    return DriverCAN_ERROR;
+  }
+  return DriverCAN_OK;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        ReadFrame
+ * @class       DriverSocketCAN (Public)
+ * @brief       Read One Frame, Sleeping in the Kernel Until It Arrives or the Timeout Passes
+ * @param [Frame]     Received Frame With Hardware (Else Kernel) Timestamp
+ * @param [Timeout]   Longest Wait in MicroSeconds, Zero Polls Once
+ * @return      DriverCAN Status
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t DriverSocketCAN::ReadFrame (FRAME &Frame, uint64_t Timeout) {
+  if (SOCKET < 0) {
+    return DriverCAN_ERROR;
+  }
+  struct timespec Now;
+  clock_gettime(CLOCK_MONOTONIC, &Now);
+  uint64_t Exit = Micros(Now) + Timeout;
+  for (;;) {
+    struct canfd_frame CAN;                     // A Classic can_frame Fills Its First CAN_MTU Bytes
+    struct iovec Vector = { &CAN, sizeof(CAN) };
+    char Control[CMSG_SPACE(sizeof(struct scm_timestamping)) + CMSG_SPACE(sizeof(struct timespec))];
+    struct msghdr Header;
+    memset(&Header, 0, sizeof(Header));
+    Header.msg_iov = &Vector;
+    Header.msg_iovlen = 1;
+    Header.msg_control = Control;
+    Header.msg_controllen = sizeof(Control);
+    ssize_t Length = recvmsg(SOCKET, &Header, 0);
+    if ((Length == (ssize_t)CAN_MTU) || (Length == (ssize_t)CANFD_MTU)) {
+      uint32_t ID = CAN.can_id & ((CAN.can_id & CAN_EFF_FLAG) ? CAN_EFF_MASK : CAN_SFF_MASK);
+      if ((CAN.can_id & (CAN_RTR_FLAG | CAN_ERR_FLAG)) || (ID < FILTER_LOW) || (ID > FILTER_HIGH)) {
+        continue;                               // Outside the Range the Kernel Filter Let Through
+      }
+      Frame.ID = ID;
+      uint8_t Limit = (Length == (ssize_t)CANFD_MTU) ? CANFD_MAX_DLEN : CAN_MAX_DLEN;
+      Frame.LEN = (CAN.len > Limit) ? Limit : CAN.len;
+      Frame.TYPE = (CAN.can_id & CAN_EFF_FLAG) ? DriverCAN_EXTENDED : DriverCAN_STANDARD;
+      Frame.FLAGS = (Length == (ssize_t)CANFD_MTU) ? (DriverCAN_FD | ((CAN.flags & CANFD_BRS) ? DriverCAN_BRS : 0)) :
+          DriverCAN_CLASSIC;
+      memcpy(Frame.DATA, CAN.data, Frame.LEN);
+      uint64_t Software = 0;
+      Frame.HWTIME = 0;
+      for (struct cmsghdr * Message = CMSG_FIRSTHDR(&Header); Message; Message = CMSG_NXTHDR(&Header, Message)) {
+        if ((Message->cmsg_level == SOL_SOCKET) && (Message->cmsg_type == SO_TIMESTAMPING)) {
+          struct scm_timestamping Stamp;
+          memcpy(&Stamp, CMSG_DATA(Message), sizeof(Stamp));
+          Software = Micros(Stamp.ts[0]);
+          Frame.HWTIME = Micros(Stamp.ts[2]);
+        } else if ((Message->cmsg_level == SOL_SOCKET) && (Message->cmsg_type == SO_TIMESTAMPNS)) {
+          struct timespec Stamp;
+          memcpy(&Stamp, CMSG_DATA(Message), sizeof(Stamp));
+          Software = Micros(Stamp);
+        }
+      }
+      Frame.TIME = Arrival(Software);
+      return DriverCAN_OK;
+    }
+    if ((Length >= 0) || ((errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR))) {
+      return DriverCAN_ERROR;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &Now);
+    uint64_t Left = (Micros(Now) < Exit) ? (Exit - Micros(Now)) : 0;
+    if (Left == 0) {
+      return DriverCAN_EMPTY;
+    }
+    struct pollfd Wait = { SOCKET, POLLIN, 0 };
+    struct timespec Sleep = { (time_t)(Left / 1000000ULL), (long)((Left % 1000000ULL) * 1000ULL) };
+    if ((ppoll(&Wait, 1, &Sleep, NULL) < 0) && (errno != EINTR)) {
+      return DriverCAN_ERROR;
+    }
+  }
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        WriteFrame
+ * @class       DriverSocketCAN (Public)
+ * @brief       Write One Frame, Retried While the Interface Queue Is Full
+ * @param [Frame]     Frame to Write
+ * @return      DriverCAN Status
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t DriverSocketCAN::WriteFrame (const FRAME &Frame) {
+  return (WriteBatch(&Frame, 1) == 1) ? DriverCAN_OK : DriverCAN_ERROR;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        WriteBatch
+ * @class       DriverSocketCAN (Public)
+ * @brief       Write Frames in Order With One sendmmsg Per DriverSocketCAN_BATCH Frames
+ * @param [Frames]    Frames to Write
+ * @param [Count]     Number of Frames
+ * @return      Number of Frames Written Before the First Failure
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint16_t DriverSocketCAN::WriteBatch (const FRAME * Frames, uint16_t Count) {
+  if (SOCKET < 0) {
+    return 0;
+  }
+  uint16_t Sent = 0;
+  uint8_t Retry = 0;
+  while (Sent < Count) {
+    struct canfd_frame CAN[DriverSocketCAN_BATCH];  // Classic Frames Use the can_frame Prefix
+    struct iovec Vector[DriverSocketCAN_BATCH];
+    struct mmsghdr Header[DriverSocketCAN_BATCH];
+    uint16_t Batch = ((Count - Sent) > DriverSocketCAN_BATCH) ? DriverSocketCAN_BATCH : (Count - Sent);
+    memset(CAN, 0, sizeof(CAN));
+    memset(Header, 0, sizeof(Header));
+    for (uint16_t I = 0; I < Batch; I++) {
+      const FRAME &Frame = Frames[Sent + I];
+      CAN[I].can_id = (Frame.TYPE == DriverCAN_EXTENDED) ? ((Frame.ID & CAN_EFF_MASK) | CAN_EFF_FLAG) :
+          (Frame.ID & CAN_SFF_MASK);
+      if (Frame.FLAGS & DriverCAN_FD) {
+        CAN[I].len = DLCToLength(LengthToDLC(Frame.LEN));
+        CAN[I].flags = CANFD_FDF | ((Frame.FLAGS & DriverCAN_BRS) ? CANFD_BRS : 0);
+        memcpy(CAN[I].data, Frame.DATA, (Frame.LEN > CANFD_MAX_DLEN) ? CANFD_MAX_DLEN : Frame.LEN);
+      } else {
+        CAN[I].len = (Frame.LEN > 8) ? 8 : Frame.LEN;
+        memcpy(CAN[I].data, Frame.DATA, 8);
+      }
+      Vector[I].iov_base = &CAN[I];
+      Vector[I].iov_len = (Frame.FLAGS & DriverCAN_FD) ? CANFD_MTU : CAN_MTU;
+      Header[I].msg_hdr.msg_iov = &Vector[I];
+      Header[I].msg_hdr.msg_iovlen = 1;
+    }
+    int Done = sendmmsg(SOCKET, Header, Batch, 0);
+    if (Done > 0) {
+      Sent += (uint16_t)Done;
+      Retry = 0;
+      continue;
+    }
+    if (((errno != EAGAIN) && (errno != ENOBUFS) && (errno != EINTR)) || (++Retry >= 5)) {
+      break;
+    }
+    struct pollfd Wait = { SOCKET, POLLOUT, 0 };
+    poll(&Wait, 1, 1);                          // Interface Queue Full, Give It a MilliSecond
+  }
+  return Sent;
+}
+/* ==================================================================================================== */
+
+
+/* ==================================================================================================== */
+/**
+ * @end       End of File DriverSocketCAN.h
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+#endif  // _DriverSocketCAN
+/* ==================================================================================================== */
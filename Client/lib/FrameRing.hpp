@@ -0,0 +1,278 @@
+/* ==================================================================================================== */
+/*
+*  FrameRing.h
+*  Lock Free Single Producer Single Consumer CAN Frame Ring
+*    ISO: 11898 Part 1 - Controller Area Network (CAN)
+*  Version: v1.0:0
+*  Developed By: Alakshendra Singh
+*  For Reporting Any Issue Don't Contact Me. Fix Yourself
+*/
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @file        FrameRing.h
+ * @author      Alakshendra Singh
+ * @brief       Lock Free SPSC Ring Between the CAN Reader Thread and the DoCAN State Machines
+ * @version     1.0
+ *
+ * One Thread Pushes, One Thread Pops. HEAD is Written Only by the Producer and TAIL Only by the
+ * Consumer, so No Lock is Taken per Frame. The Lock Only Guards the Consumer Going to Sleep.
+ * A Full Ring Drops the New Frame and Counts It. Only the Consumer Sleeps, and Only When Empty.
+ * Claim / Publish Let the Producer Read Straight Into a Slot, Peek / Release Let the Consumer Decode
+ * a Frame Where It Lies, so a Frame is Never Copied on Its Way Through the Ring.
+ *
+ * @copyright   Copyright (c) 2025
+ */
+/* ==================================================================================================== */
+
+#ifndef _FrameRing
+#define _FrameRing
+
+#include <stdint.h>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <condition_variable>
+#include "DriverCAN.hpp"
+
+
+
+/* ==================================================================================================== */
+/**
+ * @class       FrameRing
+ * @brief       SPSC Ring of CAN Frames, DEPTH Must Be a Power of Two
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+template <uint32_t DEPTH>
+class FrameRing {
+  static_assert((DEPTH >= 2) && ((DEPTH & (DEPTH - 1)) == 0), "FrameRing DEPTH Must Be a Power of Two");
+
+  private:
+    DriverCAN::FRAME SLOT[DEPTH];
+    alignas(64) std::atomic<uint32_t> HEAD;     // Next Slot to Write, Producer Owned
+    alignas(64) std::atomic<uint32_t> TAIL;     // Next Slot to Read, Consumer Owned
+    alignas(64) std::atomic<uint8_t> WAITING;   // Consumer Asleep on READY
+    std::atomic<uint8_t> KICKED;                // Interrupt Pending, Ends the Next Sleep Early
+    std::atomic<uint64_t> DROPPED;
+    std::atomic<uint32_t> PEAK;
+    std::mutex LOCK;
+    std::condition_variable READY;
+
+  public:
+
+    FrameRing (void) : HEAD(0), TAIL(0), WAITING(0), KICKED(0), DROPPED(0), PEAK(0) {}
+
+    uint8_t Push (const DriverCAN::FRAME &Frame);
+    uint8_t Pop (DriverCAN::FRAME &Frame, uint64_t Timeout = 0);
+    DriverCAN::FRAME * Claim (void);
+    void Publish (void);
+    const DriverCAN::FRAME * Peek (uint64_t Timeout = 0);
+    void Release (void);
+    void Wake (void);
+    void Interrupt (void);
+    void Clear (void);
+    uint32_t Size (void);
+    uint32_t Peak (void) { return PEAK.load(std::memory_order_relaxed); }
+    uint64_t Dropped (void) { return DROPPED.load(std::memory_order_relaxed); }
+};
+/* ==================================================================================================== */
+
+
+/* ==================================================================================================== */
+/**
+ * @name        Push
+ * @class       FrameRing (Public, Producer)
+ * @brief       Append a Frame, Waking the Consumer if It Sleeps
+ * @param [Frame]     Frame to Queue
+ * @return      1 When Queued, 0 When the Ring Was Full and the Frame Dropped
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+template <uint32_t DEPTH>
+uint8_t FrameRing<DEPTH>::Push (const DriverCAN::FRAME &Frame) {
+  DriverCAN::FRAME * Slot = Claim();
+  if (Slot == nullptr) {
+    DROPPED.fetch_add(1, std::memory_order_relaxed);
+    return 0;
+  }
+  *Slot = Frame;
+  Publish();
+  return 1;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Claim
+ * @class       FrameRing (Public, Producer)
+ * @brief       Next Free Slot, Filled in Place and Then Queued by Publish
+ * @param []    Nothing
+ * @return      Slot, nullptr When the Ring is Full
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+template <uint32_t DEPTH>
+DriverCAN::FRAME * FrameRing<DEPTH>::Claim (void) {
+  uint32_t Head = HEAD.load(std::memory_order_relaxed);
+  if ((Head - TAIL.load(std::memory_order_acquire)) >= DEPTH) {
+    return nullptr;
+  }
+  return &SLOT[Head & (DEPTH - 1)];
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Publish
+ * @class       FrameRing (Public, Producer)
+ * @brief       Queue the Slot Returned by Claim, Waking the Consumer if It Sleeps
+ * @param []    Nothing
+ * @return      Nothing
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+template <uint32_t DEPTH>
+void FrameRing<DEPTH>::Publish (void) {
+  uint32_t Head = HEAD.load(std::memory_order_relaxed);
+  uint32_t Used = Head + 1 - TAIL.load(std::memory_order_acquire);
+  HEAD.store(Head + 1, std::memory_order_seq_cst);      // Ordered Against the WAITING Store in Peek
+  if (Used > PEAK.load(std::memory_order_relaxed)) {
+    PEAK.store(Used, std::memory_order_relaxed);
+  }
+  if (WAITING.load(std::memory_order_seq_cst)) {
+    Wake();
+  }
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Pop
+ * @class       FrameRing (Public, Consumer)
+ * @brief       Take the Oldest Frame, Sleeping Until One Arrives or the Timeout Passes
+ * @param [Frame]     Received Frame
+ * @param [Timeout]   Longest Wait in MicroSeconds, Zero Polls Once
+ * @return      DriverCAN Status
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+template <uint32_t DEPTH>
+uint8_t FrameRing<DEPTH>::Pop (DriverCAN::FRAME &Frame, uint64_t Timeout) {
+  const DriverCAN::FRAME * Slot = Peek(Timeout);
+  if (Slot == nullptr) {
+    return DriverCAN_EMPTY;
+  }
+  Frame = *Slot;
+  Release();
+  return DriverCAN_OK;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Peek
+ * @class       FrameRing (Public, Consumer)
+ * @brief       Oldest Frame Left in Its Slot, Sleeping Until One Arrives or the Timeout Passes
+ * @param [Timeout]   Longest Wait in MicroSeconds, Zero Polls Once
+ * @return      Slot, Valid Until Release, nullptr When Empty
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+template <uint32_t DEPTH>
+const DriverCAN::FRAME * FrameRing<DEPTH>::Peek (uint64_t Timeout) {
+  uint32_t Tail = TAIL.load(std::memory_order_relaxed);
+  if ((HEAD.load(std::memory_order_acquire) == Tail) && Timeout) {
+    std::unique_lock<std::mutex> Guard(LOCK);
+    WAITING.store(1, std::memory_order_seq_cst);          // Producer Sees WAITING or We See HEAD
+    READY.wait_for(Guard, std::chrono::microseconds(Timeout),
+        [this, Tail] { return (HEAD.load(std::memory_order_seq_cst) != Tail) || KICKED.exchange(0); });
+    WAITING.store(0, std::memory_order_relaxed);
+  }
+  if (HEAD.load(std::memory_order_acquire) == Tail) {
+    return nullptr;
+  }
+  return &SLOT[Tail & (DEPTH - 1)];
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Release
+ * @class       FrameRing (Public, Consumer)
+ * @brief       Hand the Slot Returned by Peek Back to the Producer
+ * @param []    Nothing
+ * @return      Nothing
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+template <uint32_t DEPTH>
+void FrameRing<DEPTH>::Release (void) {
+  TAIL.store(TAIL.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Wake
+ * @class       FrameRing (Public)
+ * @brief       Wake a Sleeping Consumer, Taking the Lock So the Wake Cannot Fall Between Check and Wait
+ * @param []    Nothing
+ * @return      Nothing
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+template <uint32_t DEPTH>
+void FrameRing<DEPTH>::Wake (void) {
+  { std::lock_guard<std::mutex> Guard(LOCK); }
+  READY.notify_one();
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Interrupt
+ * @class       FrameRing (Public)
+ * @brief       End the Consumer's Sleep Without a Frame, Pop Then Returns DriverCAN_EMPTY
+ * @param []    Nothing
+ * @return      Nothing
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+template <uint32_t DEPTH>
+void FrameRing<DEPTH>::Interrupt (void) {
+  KICKED.store(1);
+  Wake();
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Clear
+ * @class       FrameRing (Public, Consumer)
+ * @brief       Drop Every Queued Frame
+ * @param []    Nothing
+ * @return      Nothing
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+template <uint32_t DEPTH>
+void FrameRing<DEPTH>::Clear (void) {
+  TAIL.store(HEAD.load(std::memory_order_acquire), std::memory_order_release);
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Size
+ * @class       FrameRing (Public)
+ * @brief       Frames Queued Right Now
+ * @param []    Nothing
+ * @return      Frame Count
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+template <uint32_t DEPTH>
+uint32_t FrameRing<DEPTH>::Size (void) {
+  return HEAD.load(std::memory_order_acquire) - TAIL.load(std::memory_order_acquire);
+}
+/* ==================================================================================================== */
+
+
+/* ==================================================================================================== */
+/**
+ * @end       End of File FrameRing.h
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+#endif  // _FrameRing
+/* ==================================================================================================== */
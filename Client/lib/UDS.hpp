@@ -26,6 +26,24 @@
 #define _UDS
 
 #include "DoCAN.hpp"
+#include <deque>
+#include <vector>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+
+#define UDS_RESPONSE_POSITIVE             0
+#define UDS_RESPONSE_NEGATIVE             1
+#define UDS_RESPONSE_FAILED               2
+#define UDS_RESPONSE_CANCELLED            3
+
+#define UDS_PENDING_MAX                   100
+#define UDS_MESSAGE_MAX                   4095
+
+#define UDS_SESSION_DEFAULT               0x01
+#define UDS_S3_DEFAULT                    5000    // S3 Server in MilliSeconds
+#define UDS_P2_MARGIN                     50      // Tester Side Delta P2 in MilliSeconds
 
 /* ==================================================================================================== */
 /**
@@ -34,25 +52,88 @@
  */
 /* ---------------------------------------------------------------------------------------------------- */
 class ISO_UDS {
+  public:
+
+    struct UDSRESPONSE {
+      uint8_t STATUS;                           // UDS_RESPONSE_* Outcome
+      uint8_t NRC;                              // Negative Response Code When NEGATIVE
+      uint16_t PENDING;                         // Response Pending (NRC 0x78) Received Before the Final One
+      uint64_t LATENCY;                         // MicroSeconds From Request Start to Final Response
+      std::vector<uint8_t> DATA;                // Final Response, SID Included
+    };
+
+    struct UDSREQUEST {
+      uint32_t TICKET;                          // Handle For Cancel
+      std::future<UDSRESPONSE> RESPONSE;
+    };
+
   private:
     ISO_DoCAN DoCAN;
 
+    struct UDSJOB {
+      uint32_t TICKET;
+      std::vector<uint8_t> DATA;
+      std::promise<UDSRESPONSE> RESPONSE;
+    };
+
+    std::recursive_mutex CHANNEL;               // One Exchange on the Bus at a Time
+    std::mutex QUEUE_LOCK;
+    std::condition_variable QUEUE_READY;
+    std::deque<UDSJOB> QUEUE;
+    std::thread WORKER;
+    uint32_t TICKET;
+    uint32_t ACTIVE;
+    uint8_t CANCEL;
+    uint8_t RUNNING;
+    uint16_t PENDING;
+
+    void Worker (void);
+    static UDSRESPONSE Cancelled (void);
+
+    struct {
+      uint16_t DEFAULT;
+      uint16_t ACTIVE;
+      uint64_t TIME;                            // Last Positive Response, Server S3 Restarted There
+      uint64_t S3;
+      uint8_t SESSION;                          // Session Reported by the Server
+      uint8_t KEEPALIVE;                        // TesterPresent While in a Non Default Session
+    } LINK;
 
-  public:
     struct {
-      uint8_t DATA[4095];
-      uint16_t LEN;
-      uint32_t ID;
-    } MESSAGE;
+      uint32_t TX;
+      uint32_t RX;
+      uint32_t FN;
+    } ADDRESS;
+
+    uint8_t Exchange (const uint8_t * Request, uint16_t Length, uint8_t * Response, uint16_t Size,
+        uint16_t &Received);
+    void Accepted (const uint8_t * Response, uint16_t Length);
+    void LinkRevert (void);
+
+  public:
 
     ISO_UDS (void) {
       cout << "\nUDS Driver Loaded";
+      LINK.DEFAULT = DoCAN_KBPS_DEFAULT; LINK.ACTIVE = DoCAN_KBPS_DEFAULT; LINK.TIME = 0; LINK.S3 = UDS_S3_DEFAULT;
+      LINK.SESSION = UDS_SESSION_DEFAULT; LINK.KEEPALIVE = 0;
+      TICKET = 0; ACTIVE = 0; CANCEL = 0; RUNNING = 0; PENDING = 0;
+      ADDRESS.TX = 0x785; ADDRESS.RX = 0x78D; ADDRESS.FN = 0x7DF;
     }
     ~ISO_UDS (void) {
+      Stop();
       cout << "\nUDS Driver Unloaded";
     }
 
     void Start (void);
+    void Stop (void);
+    void SetDriver (DriverCAN * Driver);
+    void SetCANID (uint32_t ID_TX, uint32_t ID_RX, uint32_t ID_FN);
+    UDSREQUEST Request (const uint8_t * Data, uint16_t Length);
+    uint8_t Cancel (uint32_t Ticket);
+    uint8_t LinkControl (uint16_t KBPS);
+    void SetS3 (uint64_t Time);
+    void SetTesterPresent (uint8_t Enable);
+    void SessionTimeout (void);
 
     uint64_t Clock (uint8_t Mode = 0);
     uint64_t MicroClock (void);
@@ -73,12 +154,434 @@ class ISO_UDS {
 
 
 void ISO_UDS::Start (void) {
-  DoCAN.SetBuffer (&MESSAGE.ID, &MESSAGE.LEN, MESSAGE.DATA);
-  DoCAN.SetUDSParameter (0x00, 0x00, 0x00, 4095);
+  std::lock_guard<std::recursive_mutex> Bus(CHANNEL);
+  DoCAN.SetUDSParameter (0x00, 0x00, 0x00, UDS_MESSAGE_MAX);
   DoCAN.SetTiming (1000000, 5000000);
-  DoCAN.SetCANID (0x785, 0x78D, 0x7DF);
+  DoCAN.SetCANID (ADDRESS.TX, ADDRESS.RX, ADDRESS.FN);
   DoCAN.Start();
+  LINK.ACTIVE = LINK.DEFAULT;
+  std::lock_guard<std::mutex> Guard(QUEUE_LOCK);
+  if (!RUNNING && !WORKER.joinable()) {
+    RUNNING = 1;
+    WORKER = std::thread(&ISO_UDS::Worker, this);
+  }
+}
+
+/* ==================================================================================================== */
+/**
+ * @name        Stop
+ * @class       ISO_UDS (Public)
+ * @brief       Stop the Request Worker, the Running Request and Every Queued One End as CANCELLED
+ * @param []    Nothing
+ * @return      Nothing
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+void ISO_UDS::Stop (void) {
+  {
+    std::lock_guard<std::mutex> Guard(QUEUE_LOCK);
+    RUNNING = 0;
+    if (ACTIVE) {
+      CANCEL = 1;
+      DoCAN.Abort();
+    }
+    for (UDSJOB &Job : QUEUE) {
+      Job.RESPONSE.set_value(Cancelled());
+    }
+    QUEUE.clear();
+  }
+  QUEUE_READY.notify_all();
+  if (WORKER.joinable()) {
+    WORKER.join();
+  }
+  DoCAN.Abort(0);
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        SetDriver
+ * @class       ISO_UDS (Public)
+ * @brief       Run on Another CAN Backend, Call Before Start
+ * @param [Driver]    DriverCAN Backend, Owned by the Caller
+ * @return      Nothing
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+void ISO_UDS::SetDriver (DriverCAN * Driver) {
+  DoCAN.SetDriver(Driver);
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        SetCANID
+ * @class       ISO_UDS (Public)
+ * @brief       Request, Response and Functional CAN IDs of the Server, Call Before Start
+ * @param [ID_TX]     Request CAN ID (Tester to Server)
+ * @param [ID_RX]     Response CAN ID (Server to Tester)
+ * @param [ID_FN]     Functional Request CAN ID
+ * @return      Nothing
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+void ISO_UDS::SetCANID (uint32_t ID_TX, uint32_t ID_RX, uint32_t ID_FN) {
+  ADDRESS.TX = ID_TX; ADDRESS.RX = ID_RX; ADDRESS.FN = ID_FN;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Request
+ * @class       ISO_UDS (Public)
+ * @brief       Queue a Diagnostic Request, the Future Resolves With the Final Response
+ * @param [Data]      Request, SID First
+ * @param [Length]    Request Length, 1 to 4095
+ * @return      Ticket and Future of the Response
+ *
+ * Requests Run One at a Time, in Order, on the Worker Thread Started by Start. The Caller Never
+ * Blocks and Any Number of Requests Can Be Queued. NRC 0x78 Extends the Wait to P2*. Before Start
+ * or After Stop the Future is Ready at Once With STATUS FAILED.
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+ISO_UDS::UDSREQUEST ISO_UDS::Request (const uint8_t * Data, uint16_t Length) {
+  UDSJOB Job;
+  UDSREQUEST Request;
+  Request.RESPONSE = Job.RESPONSE.get_future();
+  Request.TICKET = 0;
+  if ((Data != nullptr) && (Length > 0) && (Length <= UDS_MESSAGE_MAX)) {
+    Job.DATA.assign(Data, Data + Length);
+    std::lock_guard<std::mutex> Guard(QUEUE_LOCK);
+    if (RUNNING) {
+      Job.TICKET = ++TICKET;
+      if (Job.TICKET == 0) {
+        Job.TICKET = ++TICKET;                  // Zero is Never a Ticket
+      }
+      Request.TICKET = Job.TICKET;
+      QUEUE.push_back(std::move(Job));
+    }
+  }
+  if (Request.TICKET == 0) {
+    UDSRESPONSE Response = {};
+    Response.STATUS = UDS_RESPONSE_FAILED;
+    Job.RESPONSE.set_value(Response);
+    return Request;
+  }
+  QUEUE_READY.notify_one();
+  return Request;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Cancel
+ * @class       ISO_UDS (Public)
+ * @brief       Cancel a Request : Dropped if Still Queued, Aborted on the Bus if Running
+ * @param [Ticket]    Ticket From Request
+ * @return      1 When Cancelled, 0 When Already Finished or Unknown
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t ISO_UDS::Cancel (uint32_t Ticket) {
+  std::lock_guard<std::mutex> Guard(QUEUE_LOCK);
+  if (Ticket && (Ticket == ACTIVE)) {
+    CANCEL = 1;
+    DoCAN.Abort();                              // Worker Clears It Before the Next Request
+    return 1;
+  }
+  for (auto Job = QUEUE.begin(); Job != QUEUE.end(); Job++) {
+    if (Job->TICKET == Ticket) {
+      Job->RESPONSE.set_value(Cancelled());
+      QUEUE.erase(Job);
+      return 1;
+    }
+  }
+  return 0;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Worker
+ * @class       ISO_UDS (Private)
+ * @brief       Request Worker : Take the Next Request, Exchange It and Resolve Its Future
+ * @param []    Nothing
+ * @return      Nothing
+ *
+ * ACTIVE, CANCEL and the DoCAN Abort Flag Change Only Under QUEUE_LOCK, so a Cancel Racing the End
+ * of a Request Can Never Abort the Next One, and a Cancel That Returned 1 Always Resolves CANCELLED.
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+void ISO_UDS::Worker (void) {
+  for (;;) {
+    UDSJOB Job;
+    {
+      std::unique_lock<std::mutex> Guard(QUEUE_LOCK);
+      QUEUE_READY.wait(Guard, [this] { return !RUNNING || !QUEUE.empty(); });
+      if (!RUNNING) {
+        return;
+      }
+      Job = std::move(QUEUE.front());
+      QUEUE.pop_front();
+      ACTIVE = Job.TICKET;
+      CANCEL = 0;
+      DoCAN.Abort(0);
+    }
+
+    UDSRESPONSE Response = {};
+    uint8_t Status;
+    {
+      std::lock_guard<std::recursive_mutex> Bus(CHANNEL);
+      uint16_t Received = 0;
+      Response.DATA.resize(UDS_MESSAGE_MAX);    // DoCAN Writes the Response Straight Into It
+      uint64_t Entry = MicroClock();
+      Status = Exchange(Job.DATA.data(), (uint16_t)Job.DATA.size(), Response.DATA.data(),
+          (uint16_t)Response.DATA.size(), Received);
+      Response.LATENCY = MicroClock() - Entry;
+      Response.PENDING = PENDING;
+      Response.DATA.resize((Status != 0xFF) ? Received : 0);
+    }
+
+    {
+      std::lock_guard<std::mutex> Guard(QUEUE_LOCK);
+      ACTIVE = 0;
+      DoCAN.Abort(0);
+      if (CANCEL) {                             // Cancelled Even if the Response Made It in Time
+        Response = Cancelled();
+      } else if (Status == 0) {
+        Response.STATUS = UDS_RESPONSE_POSITIVE;
+      } else if (Status == 0xFF) {
+        Response.STATUS = UDS_RESPONSE_FAILED;
+      } else {
+        Response.STATUS = UDS_RESPONSE_NEGATIVE;
+        Response.NRC = Status;
+      }
+    }
+    Job.RESPONSE.set_value(std::move(Response));
+  }
 }
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Cancelled
+ * @class       ISO_UDS (Private)
+ * @brief       Response of a Cancelled Request
+ * @param []    Nothing
+ * @return      UDSRESPONSE With STATUS CANCELLED
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+ISO_UDS::UDSRESPONSE ISO_UDS::Cancelled (void) {
+  UDSRESPONSE Response = {};
+  Response.STATUS = UDS_RESPONSE_CANCELLED;
+  return Response;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Exchange
+ * @class       ISO_UDS (Private)
+ * @brief       Send a Request and Wait for the Final Response, Both Buffers Belong to This Request
+ * @param [Request]     Request, SID First
+ * @param [Length]      Request Length
+ * @param [Response]    Destination DoCAN Writes the Response Into, May Be the Request Buffer
+ * @param [Size]        Destination Size
+ * @param [Received]    Response Length
+ * @return      Zero on Positive Response, NRC on Negative Response, 0xFF on DoCAN Failure
+ *
+ * Each NRC 0x78 Restarts the Wait With P2*, Up to UDS_PENDING_MAX in a Row. Caller Holds CHANNEL.
+ * Every Positive Response Goes Through Accepted, Whether It Came From Request or LinkControl.
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t ISO_UDS::Exchange (const uint8_t * Request, uint16_t Length, uint8_t * Response, uint16_t Size,
+    uint16_t &Received) {
+  uint8_t SID = Request[0];
+  if (DoCAN.Transmit(Request, Length) != DoCAN_TX_COMPLETE) {
+    return 0xFF;
+  }
+  uint8_t Time = 1;
+  PENDING = 0;
+  while (DoCAN.Receive(Response, Size, Received, Time) == DoCAN_RX_COMPLETE) {
+    if ((Received == 3) && (Response[0] == 0x7F) && (Response[1] == SID)) {
+      if ((Response[2] == 0x78) && (PENDING < UDS_PENDING_MAX)) {
+        PENDING++;                              // Response Pending, Next Wait is P2*
+        Time = 0;
+        continue;
+      }
+      return Response[2];
+    }
+    if ((Received > 0) && (Response[0] == (SID | 0x40))) {
+      Accepted(Response, Received);
+      return 0;
+    }
+  }
+  return 0xFF;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        LinkControl
+ * @class       ISO_UDS (Public)
+ * @brief       Verify and Transition Baudrate of Server and Tester (Service 0x87)
+ * @param [KBPS]    Target Speed in KBPS
+ * @return      Zero on Success, NRC on Negative Response, 0xFF on DoCAN Failure
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t ISO_UDS::LinkControl (uint16_t KBPS) {
+  std::lock_guard<std::recursive_mutex> Bus(CHANNEL);
+  uint8_t Fixed = 0x00;
+  switch (KBPS) {
+    case 125 :  { Fixed = 0x10; break; }
+    case 250 :  { Fixed = 0x11; break; }
+    case 500 :  { Fixed = 0x12; break; }
+    case 1000 : { Fixed = 0x13; break; }
+  }
+  uint8_t Data[8];                              // Request and Response, Both Single Frames
+  uint16_t LEN;
+  Data[0] = 0x87;
+  if (Fixed) {
+    Data[1] = 0x01;
+    Data[2] = Fixed;
+    LEN = 3;
+  } else {
+    uint32_t Baud = (uint32_t)KBPS * 1000;
+    Data[1] = 0x02;
+    Data[2] = (Baud >> 16) & 0xFF;
+    Data[3] = (Baud >> 8) & 0xFF;
+    Data[4] = Baud & 0xFF;
+    LEN = 5;
+  }
+  uint8_t Status = Exchange(Data, LEN, Data, sizeof(Data), LEN);
+  if (Status) {
+    return Status;
+  }
+
+  // Transition is confirmed at the old baudrate, the server switches once its response is on the bus
+  Data[0] = 0x87;
+  Data[1] = 0x03;
+  LEN = 2;
+  Status = Exchange(Data, LEN, Data, sizeof(Data), LEN);
+  if (Status) {
+    return Status;
+  }
+  if (DoCAN.SetBaudrate(KBPS)) {
+    return 0xFF;
+  }
+  LINK.ACTIVE = KBPS;
+  return 0;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Accepted
+ * @class       ISO_UDS (Private)
+ * @brief       Track Server Session State From a Positive Response
+ * @param [Response]    Positive Response, SID First
+ * @param [Length]      Response Length
+ * @return      Nothing
+ *
+ * The Server Restarts S3 on Every Request It Served, so LINK.TIME Moves Here. A Session Control
+ * Response Carries P2_Server_Max (1 ms) and P2*_Server_Max (10 ms), the Tester Waits Those Plus
+ * UDS_P2_MARGIN. Entering the Default Session or ECUReset Drops the Server to the Default Session
+ * and, Once This Response is on the Bus, to the Default Baudrate, so the Tester Follows Here.
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+void ISO_UDS::Accepted (const uint8_t * Response, uint16_t Length) {
+  LINK.TIME = MilliClock();
+  if ((Response[0] == 0x50) && (Length >= 6)) {
+    uint64_t P2 = ((uint64_t)Response[2] << 8) | Response[3];
+    uint64_t P2_Star = (((uint64_t)Response[4] << 8) | Response[5]) * 10;
+    LINK.SESSION = Response[1] & 0x7F;
+    DoCAN.SetTiming((P2 + UDS_P2_MARGIN) * 1000, (P2_Star + UDS_P2_MARGIN) * 1000);
+    if (LINK.SESSION == UDS_SESSION_DEFAULT) {
+      LinkRevert();
+    }
+  } else if (Response[0] == 0x51) {
+    LINK.SESSION = UDS_SESSION_DEFAULT;
+    LinkRevert();
+  }
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        LinkRevert
+ * @class       ISO_UDS (Private)
+ * @brief       Follow the Server Back to the Default Baudrate When the Link Was Switched
+ * @param []    Nothing
+ * @return      Nothing
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+void ISO_UDS::LinkRevert (void) {
+  if ((LINK.ACTIVE != LINK.DEFAULT) && (DoCAN.SetBaudrate(LINK.DEFAULT) == 0)) {
+    LINK.ACTIVE = LINK.DEFAULT;
+  }
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        SetS3
+ * @class       ISO_UDS (Public)
+ * @brief       S3 of the Server, Used by SessionTimeout
+ * @param [Time]    S3 in MilliSeconds, Defaults to UDS_S3_DEFAULT
+ * @return      Nothing
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+void ISO_UDS::SetS3 (uint64_t Time) {
+  std::lock_guard<std::recursive_mutex> Bus(CHANNEL);
+  LINK.S3 = Time;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        SetTesterPresent
+ * @class       ISO_UDS (Public)
+ * @brief       Keep a Non Default Session Alive From SessionTimeout
+ * @param [Enable]    1 to Send TesterPresent Once Half of S3 Passed Without a Request
+ * @return      Nothing
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+void ISO_UDS::SetTesterPresent (uint8_t Enable) {
+  std::lock_guard<std::recursive_mutex> Bus(CHANNEL);
+  LINK.KEEPALIVE = Enable;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        SessionTimeout
+ * @class       ISO_UDS (Public)
+ * @brief       Follow the Server Session Timer, Call Periodically
+ * @param []    Nothing
+ * @return      Nothing
+ *
+ * With TesterPresent Enabled a Non Default Session is Kept Alive by a Suppressed 0x3E Once Half of
+ * S3 Passed. Otherwise, Once S3 Has Expired, the Server is Back in the Default Session at the
+ * Default Baudrate and the Tester Follows.
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+void ISO_UDS::SessionTimeout (void) {
+  std::lock_guard<std::recursive_mutex> Bus(CHANNEL);
+  if ((LINK.SESSION == UDS_SESSION_DEFAULT) && (LINK.ACTIVE == LINK.DEFAULT)) {
+    return;
+  }
+  uint64_t Idle = MilliClock() - LINK.TIME;
+  if (LINK.KEEPALIVE && (LINK.SESSION != UDS_SESSION_DEFAULT) && (Idle <= LINK.S3)) {
+    if (Idle >= (LINK.S3 / 2)) {
+      const uint8_t Present[2] = {0x3E, 0x80};  // Suppressed Positive Response
+      if (DoCAN.Transmit(Present, sizeof(Present)) == DoCAN_TX_COMPLETE) {
+        LINK.TIME = MilliClock();
+      }
+    }
+    return;
+  }
+  if (Idle > LINK.S3) {
+    LINK.SESSION = UDS_SESSION_DEFAULT;
+    LinkRevert();
+  }
+}
+/* ==================================================================================================== */
 
 
 
@@ -0,0 +1,154 @@
+/* ==================================================================================================== */
+/*
+ *  UDSManager.h
+ *  Unified Diagnostics Services (UDS) - Multi ECU Session Manager
+ *    ISO: 14229 Part 1   - Diagonostics Services
+ *    ISO: 15765 Part 2   - Transport (One Connection per ECU)
+ *  Version: v1.0:0
+ *  Developed By: Alakshendra Singh
+ *  For Reporting Any Issue Don't Contact Me. Fix Yourself
+*/
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @file        UDSManager.h
+ * @author      Alakshendra Singh
+ * @brief       Many ECUs Over One CAN Device, Each With Its Own ISO_UDS, Transport State and Buffers
+ * @version     1.0
+ *
+ * Every ECU Gets a DriverMux Port, so Responses Are Routed on Receive ID, and Its Own Request
+ * Worker, so Requests to Different ECUs Run at the Same Time. Frames From All Connections Share
+ * the Bus, Total Time is Set by Bus Load and the Slowest ECU Instead of the Sum Over ECUs.
+ *
+ * @copyright   Copyright (c) 2025
+ */
+/* ==================================================================================================== */
+
+#ifndef _UDSManager
+#define _UDSManager
+
+#include "UDS.hpp"
+#include "DriverMux.hpp"
+#include <memory>
+#include <vector>
+
+#define UDSManager_NONE                   0xFF
+
+
+
+/* ==================================================================================================== */
+/**
+ * @class       ISO_UDSManager
+ * @brief       Session Manager For Up To DriverMux_PORTS ECUs on One CAN Device
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+class ISO_UDSManager {
+  private:
+    DriverMux MUX;
+    std::vector<std::unique_ptr<ISO_UDS>> ECUS;   // Destroyed Before MUX, Their Ports Live in It
+
+  public:
+
+    ISO_UDSManager (DriverCAN &Device, uint32_t Low = 0x000, uint32_t High = 0x7FF) : MUX(Device, Low, High) {
+      cout << "\nUDS Manager Loaded";
+    }
+    ~ISO_UDSManager (void) {
+      Stop();
+      cout << "\nUDS Manager Unloaded";
+    }
+
+    uint8_t AddECU (uint32_t ID_TX, uint32_t ID_RX, uint32_t ID_FN = 0x7DF);
+    uint8_t Count (void) { return (uint8_t)ECUS.size(); }
+    ISO_UDS & ECU (uint8_t Index) { return *ECUS[Index]; }
+
+    void Start (void);
+    void Stop (void);
+    std::vector<ISO_UDS::UDSREQUEST> Request (const uint8_t * Data, uint16_t Length);
+};
+/* ==================================================================================================== */
+
+
+/* ==================================================================================================== */
+/**
+ * @name        AddECU
+ * @class       ISO_UDSManager (Public)
+ * @brief       Add an ECU With Its Own Connection on the Shared Device, Call Before Start
+ * @param [ID_TX]     Request CAN ID (Tester to ECU)
+ * @param [ID_RX]     Response CAN ID (ECU to Tester), Unique per ECU
+ * @param [ID_FN]     Functional Request CAN ID
+ * @return      ECU Index, UDSManager_NONE When Every Port is Taken
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t ISO_UDSManager::AddECU (uint32_t ID_TX, uint32_t ID_RX, uint32_t ID_FN) {
+  DriverMux::Port * Port = MUX.NewPort();
+  if (Port == nullptr) {
+    return UDSManager_NONE;
+  }
+  ECUS.emplace_back(new ISO_UDS());
+  ECUS.back()->SetDriver(Port);
+  ECUS.back()->SetCANID(ID_TX, ID_RX, ID_FN);
+  return (uint8_t)(ECUS.size() - 1);
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Start
+ * @class       ISO_UDSManager (Public)
+ * @brief       Start Every ECU Connection, the First One Opens the Device
+ * @param []    Nothing
+ * @return      Nothing
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+void ISO_UDSManager::Start (void) {
+  for (auto &Unit : ECUS) {
+    Unit->Start();
+  }
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Stop
+ * @class       ISO_UDSManager (Public)
+ * @brief       Stop Every ECU Connection, Outstanding Requests End as CANCELLED
+ * @param []    Nothing
+ * @return      Nothing
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+void ISO_UDSManager::Stop (void) {
+  for (auto &Unit : ECUS) {
+    Unit->Stop();
+  }
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Request
+ * @class       ISO_UDSManager (Public)
+ * @brief       Send the Same Request to Every ECU at Once, Each Over Its Own Connection
+ * @param [Data]      Request, SID First
+ * @param [Length]    Request Length
+ * @return      One Ticket and Future per ECU, in ECU Index Order
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+std::vector<ISO_UDS::UDSREQUEST> ISO_UDSManager::Request (const uint8_t * Data, uint16_t Length) {
+  std::vector<ISO_UDS::UDSREQUEST> Requests;
+  Requests.reserve(ECUS.size());
+  for (auto &Unit : ECUS) {
+    Requests.push_back(Unit->Request(Data, Length));
+  }
+  return Requests;
+}
+/* ==================================================================================================== */
+
+
+/* ==================================================================================================== */
+/**
+ * @end       End of File UDSManager.h
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+#endif  // _UDSManager
+/* ==================================================================================================== */
@@ -1,8 +1,7 @@
-#include "lib\DriverPCAN.hpp"
-#include "lib\UDS.hpp"
+#include "lib/UDS.hpp"
 
 int main(void) {
-  cout << "\n\n\nPeak System's PCAN Testing";
+  cout << "\n\n\nUDS Tester";
   cout << "\n - Alakshendra Singh\n";
   ISO_UDS UDS;
   UDS.Start();
@@ -0,0 +1,176 @@
+/* ==================================================================================================== */
+/*
+ *  crypto.c
+ *  Unified Diagnostics Services on CAN (UDSonCAN) - Crypto Check
+ *    Runs The Software AES-CMAC Against The RFC 4493 Examples
+ *    Feeds Secured Requests Frame By Frame Through The Incremental Receive MAC And Compares It
+ *    With The One Shot MAC, Then Checks Counter Exhaustion And Release On Session Exit
+ *
+ *  Usage: UDSonCrypto
+ */
+/* ==================================================================================================== */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "UDS.h"
+
+
+
+typedef struct {
+    const char *Name;
+    uint8_t Length;
+    uint8_t MAC[UDS_CryptoBlockSize];
+} Crypto_Case;
+
+
+const uint8_t UDS_AuthKey[UDS_CryptoKeyLength] = {                                    // RFC 4493 Key
+    0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6, 0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C
+};
+
+uint16_t UDS_IOCurrentValue (uint8_t _Index) {
+    return (uint16_t)_Index;
+}
+
+
+static const uint8_t Crypto_Message[64] = {                                           // RFC 4493 Message, Examples Use A Prefix
+    0x6B, 0xC1, 0xBE, 0xE2, 0x2E, 0x40, 0x9F, 0x96, 0xE9, 0x3D, 0x7E, 0x11, 0x73, 0x93, 0x17, 0x2A,
+    0xAE, 0x2D, 0x8A, 0x57, 0x1E, 0x03, 0xAC, 0x9C, 0x9E, 0xB7, 0x6F, 0xAC, 0x45, 0xAF, 0x8E, 0x51,
+    0x30, 0xC8, 0x1C, 0x46, 0xA3, 0x5C, 0xE4, 0x11, 0xE5, 0xFB, 0xC1, 0x19, 0x1A, 0x0A, 0x52, 0xEF,
+    0xF6, 0x9F, 0x24, 0x45, 0xDF, 0x4F, 0x9B, 0x17, 0xAD, 0x2B, 0x41, 0x7B, 0xE6, 0x6C, 0x37, 0x10
+};
+
+static const Crypto_Case Crypto_Cases[] = {
+    {"RFC 4493 Example 1", 0,
+      {0xBB, 0x1D, 0x69, 0x29, 0xE9, 0x59, 0x37, 0x28, 0x7F, 0xA3, 0x7D, 0x12, 0x9B, 0x75, 0x67, 0x46}},
+    {"RFC 4493 Example 2", 16,
+      {0x07, 0x0A, 0x16, 0xB4, 0x6B, 0x4D, 0x41, 0x44, 0xF7, 0x9B, 0xDD, 0x9D, 0xD0, 0x4A, 0x28, 0x7C}},
+    {"RFC 4493 Example 3", 40,
+      {0xDF, 0xA6, 0x67, 0x47, 0xDE, 0x9A, 0xE6, 0x30, 0x30, 0xCA, 0x32, 0x61, 0x14, 0x97, 0xC8, 0x27}},
+    {"RFC 4493 Example 4", 64,
+      {0x51, 0xF0, 0xBE, 0xBF, 0x7E, 0x3B, 0x9D, 0x92, 0xFC, 0x49, 0x74, 0x17, 0x79, 0x36, 0x3C, 0xFE}},
+};
+
+
+/* ==================================================================================================== */
+/*
+ *  Checks
+ *
+ *  uint8_t Crypto_Vectors (void)
+ *  uint8_t Crypto_Secured (uint16_t _Inner, uint8_t _Corrupt)
+ *  uint8_t Crypto_Release (void)
+ *
+ *  Each Returns Zero When The Check Passed
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+static uint8_t Crypto_Vectors (void) {
+    UDS_CMACContext _Context;
+    uint8_t _MAC[UDS_CryptoBlockSize];
+    uint8_t _Failed = 0;
+    for (uint8_t c = 0; c < (sizeof(Crypto_Cases) / sizeof(Crypto_Cases[0])); c++) {
+        const Crypto_Case *_Case = &Crypto_Cases[c];
+        UDS_CryptoSoftware.Start(&_Context, UDS_AuthKey);                             // One Shot
+        UDS_CryptoSoftware.Update(&_Context, Crypto_Message, _Case->Length);
+        UDS_CryptoSoftware.Finish(&_Context, _MAC);
+        uint8_t _Whole = (uint8_t)(memcmp(_MAC, _Case->MAC, UDS_CryptoBlockSize) != 0);
+
+        UDS_CryptoSoftware.Restart(&_Context);                                        // Byte By Byte With The Loaded Key
+        for (uint8_t i = 0; i < _Case->Length; i++) {
+            UDS_CryptoSoftware.Update(&_Context, &Crypto_Message[i], 1);
+        }
+        UDS_CryptoSoftware.Finish(&_Context, _MAC);
+        uint8_t _Bytes = (uint8_t)(memcmp(_MAC, _Case->MAC, UDS_CryptoBlockSize) != 0);
+
+        printf("%-34s %s\n", _Case->Name, (_Whole || _Bytes) ? "FAILED" : "OK");
+        _Failed |= _Whole | _Bytes;
+    }
+    return _Failed;
+}
+/* ---------------------------------------------------------------------------------------------------- */
+static uint8_t Crypto_Secured (uint16_t _Inner, uint8_t _Corrupt) {
+    uint8_t _Request[UDS_ParaBufferSize];
+    uint16_t _Length = UDS_SecuredHeaderLength + _Inner + UDS_SecuredMACLength;
+    _Request[0] = 0x84;                                                               // Secured Data Header
+    _Request[1] = 0x00;
+    _Request[2] = 0x00;
+    _Request[3] = UDS_SecuredCMAC;
+    _Request[4] = 0x00;
+    _Request[5] = UDS_SecuredMACLength;
+    _Request[6] = 0x00;
+    _Request[7] = 0x01;
+    _Request[UDS_SecuredHeaderLength] = 0x22;                                         // Internal Request
+    for (uint16_t i = 1; i < _Inner; i++) {
+        _Request[UDS_SecuredHeaderLength + i] = (uint8_t)(i * 7u);
+    }
+    UDS_CMACContext _Context;                                                         // One Shot Signature
+    UDS_CryptoSoftware.Start(&_Context, UDS_AuthKey);
+    UDS_CryptoSoftware.Update(&_Context, _Request, _Length - UDS_SecuredMACLength);
+    UDS_CryptoSoftware.Finish(&_Context, &_Request[_Length - UDS_SecuredMACLength]);
+    if (_Corrupt) {
+        _Request[_Length - 1] ^= 0x01;
+    }
+
+    UDS_Auth.State = UDS_AuthAuthenticated;                                           // As After Verify Proof
+    UDS_Crypto->Start(&UDS_Auth.Context, UDS_AuthKey);
+    memset(UDS_Message.Data, 0, sizeof(UDS_Message.Data));
+    uint16_t _Received = (_Length < 6u) ? _Length : 6u;                               // First Frame Bytes, As TP_RxFrameFF Copies Them
+    memcpy(UDS_Message.Data, _Request, _Received);
+    UDS_AuthRxStart(_Length);
+    UDS_AuthRxUpdate(_Received);
+    while (_Received < _Length) {                                                     // Consecutive Frames, As TP_RxFrameCF Copies Them
+        uint16_t _Left = _Length - _Received;
+        uint16_t _Chunk = (_Left > 7u) ? 7u : _Left;
+        memcpy(&UDS_Message.Data[_Received], &_Request[_Received], _Chunk);
+        _Received += _Chunk;
+        UDS_AuthRxUpdate(_Received);
+    }
+    return (uint8_t)(UDS_Auth.RxActive || (UDS_Auth.RxVerified != (_Corrupt ? 0u : 1u)));
+}
+/* ---------------------------------------------------------------------------------------------------- */
+static uint8_t Crypto_Release (void) {
+    uint8_t _Failed = 0;
+    UDS_Auth.State = UDS_AuthAuthenticated;                                           // Exhausted Counter Drops The Authentication
+    UDS_Auth.AntiReplay = UDS_SecuredCounterMax;
+    UDS_Auth.RxVerified = 1u;
+    UDS_Message.Length = UDS_SecuredHeaderLength + 3u + UDS_SecuredMACLength;
+    UDS_Message.Data[0] = 0x84;
+    UDS_Server.Status = UDS_ServerBusy;
+    _Failed |= (uint8_t)(UDS_SecuredDataTransmission() != 0);
+    _Failed |= (uint8_t)(UDS_Auth.State != UDS_AuthIdle);
+    printf("%-34s %s\n", "Anti Replay Counter Exhausted", _Failed ? "FAILED" : "OK");
+
+    uint8_t _Exit = 0;
+    UDS_Auth.State = UDS_AuthAuthenticated;                                           // Session Exit Forgets Everything
+    UDS_Auth.AntiReplay = 0x1234u;
+    UDS_Crypto->Start(&UDS_Auth.Context, UDS_AuthKey);
+    UDS_SessionExit();
+    const uint8_t *_Wipe = (const uint8_t *)&UDS_Auth;
+    for (uint16_t i = 0; i < sizeof(UDS_Auth); i++) {
+        _Exit |= (uint8_t)(_Wipe[i] != 0u);
+    }
+    printf("%-34s %s\n", "Authentication Released On Exit", _Exit ? "FAILED" : "OK");
+    return _Failed | _Exit;
+}
+/* ==================================================================================================== */
+
+
+/* ---------------------------------------------------------------------------------------------------- */
+int main (void) {
+    uint8_t _Failed = 0;
+    UDS_InitApp();
+    _Failed |= Crypto_Vectors();
+
+    uint8_t _Secured = 0;
+    uint16_t _Largest = UDS_ParaBufferSize - UDS_SecuredHeaderLength - UDS_SecuredMACLength;
+    for (uint16_t n = 1; n <= _Largest; n++) {                                        // MAC Boundary At Every Frame Offset
+        _Secured |= Crypto_Secured(n, 0);
+        _Secured |= Crypto_Secured(n, 1);
+    }
+    printf("%-34s %s\n", "Incremental MAC Over CF (1 To Max)", _Secured ? "FAILED" : "OK");
+    _Failed |= _Secured;
+
+    _Failed |= Crypto_Release();
+    printf("%s\n", _Failed ? "FAILED" : "PASSED");
+    return _Failed;
+}
+/* ==================================================================================================== */
@@ -0,0 +1,326 @@
+/* ==================================================================================================== */
+/*
+ *  main.c
+ *  Unified Diagnostics Services on CAN (UDSonCAN) - Host Runner
+ *    Runs The Server Library On A Workstation Over The In Memory Bus
+ *    Reports Per Request Latency And Transport Throughput
+ *
+ *  Usage: UDSonHost [-n Iterations] [-v] [-t TraceFile]
+ *    -n  Repetitions Per Request (Default 100)
+ *    -v  Virtual Clock, One Millisecond Per Server Loop
+ *    -t  Binary Frame Trace Written To TraceFile, Drained Between Server Loops (make TRACE=1)
+ *  Built With UDS_EnableMetrics (make METRICS=1) The Server Metrics DID Is Read And Printed Last
+ */
+/* ==================================================================================================== */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "UDS.h"
+
+
+
+#ifndef HostRunnerParameters                                                          // Host Runner Parameters
+  #define HostRunnerParameters
+  #define Host_StepLimit              200000u                                         // Server Loops Before A Request Times Out
+  #define Host_RequestSize            4095u                                           // Largest ISO-TP Payload
+  #define Host_TraceBatch             4u                                              // Trace Records Drained Per Server Loop
+#endif
+
+
+typedef struct {
+    const char *Name;
+    uint8_t Request[128];
+    uint16_t Length;
+    uint8_t Response;                                                                 // Expected Positive Response SID
+} Host_Case;
+
+typedef struct {
+    uint64_t Minimum;
+    uint64_t Maximum;
+    uint64_t Total;
+    uint32_t Virtual;
+    uint64_t Bytes;
+    uint32_t Frames;
+    uint32_t Count;
+} Host_Result;
+
+
+const uint8_t UDS_AuthKey[UDS_CryptoKeyLength] = {
+    0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6, 0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C
+};
+
+uint16_t UDS_IOCurrentValue (uint8_t _Index) {
+    return (uint16_t)(_Index * 100u);                                                 // Host Signals Read Back Their Index
+}
+
+
+static uint32_t Host_FramesMoved = 0;
+
+
+/* ==================================================================================================== */
+/*
+ *  Tester Side
+ *
+ *  void Host_Step (void)
+ *  uint8_t Host_Await (Host_CANFrame *_Frame)
+ *  uint8_t Host_Send (const uint8_t *_Data, uint16_t _Length)
+ *  uint8_t Host_Receive (uint8_t *_Data, uint16_t *_Length)
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+static void Host_Step (void) {
+    Host_FramesMoved += Host_BusPoll();                                               // One Frame Into DoCAN
+    UDS_MainApp();                                                                    // One Server Loop
+#ifdef UDS_EnableTrace
+    UDS_TraceDrain(Host_TraceBatch);                                                  // Idle Time Trace Drain
+#endif
+    if (Host_State.Virtual) {
+        Host_ClockAdvance(1u);                                                        // One Millisecond Per Loop
+    }
+}
+/* ---------------------------------------------------------------------------------------------------- */
+static uint8_t Host_Await (Host_CANFrame *_Frame) {
+    uint32_t _Steps = 0;
+    while (Host_QueuePop(&Host_BusFromServer, _Frame)) {                              // Server Frame Wait
+        if (++_Steps > Host_StepLimit) {
+            return 1;
+        }
+        Host_Step();
+    }
+    Host_FramesMoved++;
+    return 0;
+}
+/* ---------------------------------------------------------------------------------------------------- */
+static uint8_t Host_Send (const uint8_t *_Data, uint16_t _Length) {
+    uint8_t _Frame[8];
+    if (_Length < 8) {                                                                // Single Frame
+        memset(_Frame, TP_CANPadding, sizeof(_Frame));
+        _Frame[0] = (uint8_t)_Length;
+        memcpy(&_Frame[1], _Data, _Length);
+        return Host_BusInject(_UDS_RxID, _Frame);
+    }
+
+    _Frame[0] = (uint8_t)(0x10 | (_Length >> 8));                                     // First Frame
+    _Frame[1] = (uint8_t)(_Length & 0xFF);
+    memcpy(&_Frame[2], _Data, 6);
+    if (Host_BusInject(_UDS_RxID, _Frame)) {
+        return 1;
+    }
+
+    Host_CANFrame _FC;
+    if (Host_Await(&_FC) || ((_FC.Data[0] & 0xF0) != 0x30) ||                         // Flow Control Wait
+          ((_FC.Data[0] & 0x0F) != TP_FSContinueToSend)) {
+        return 1;
+    }
+    uint16_t _Offset = 6;
+    uint8_t _Index = 1;
+    while (_Offset < _Length) {                                                       // Consecutive Frames
+        uint16_t _Chunk = ((_Length - _Offset) > 7) ? 7 : (_Length - _Offset);
+        memset(_Frame, TP_CANPadding, sizeof(_Frame));
+        _Frame[0] = (uint8_t)(0x20 | (_Index & 0x0F));
+        memcpy(&_Frame[1], &_Data[_Offset], _Chunk);
+        if (Host_BusInject(_UDS_RxID, _Frame)) {
+            return 1;
+        }
+        _Offset += _Chunk;
+        _Index++;
+    }
+    return 0;
+}
+/* ---------------------------------------------------------------------------------------------------- */
+static uint8_t Host_Receive (uint8_t *_Data, uint16_t *_Length) {
+    Host_CANFrame _Frame;
+    while (1) {
+        if (Host_Await(&_Frame) || (_Frame.CANID != _UDS_TxID)) {
+            return 1;
+        }
+        uint8_t _PCI = _Frame.Data[0] >> 4;
+        if (_PCI == 0x00) {                                                           // Single Frame
+            *_Length = _Frame.Data[0] & 0x0F;
+            memcpy(_Data, &_Frame.Data[1], *_Length);
+            if ((*_Length == 3) && (_Data[0] == UDS_NRC) && (_Data[2] == UDS_NRC_RCRRP)) {
+                continue;                                                             // Response Pending, Keep Waiting
+            }
+            return 0;
+        }
+        if (_PCI != 0x01) {
+            return 1;
+        }
+        uint16_t _Total = (uint16_t)(((_Frame.Data[0] & 0x0F) << 8) | _Frame.Data[1]);// First Frame
+        memcpy(_Data, &_Frame.Data[2], 6);
+        uint8_t _FC[8] = {0x30, 0x00, 0x00, TP_CANPadding, TP_CANPadding, TP_CANPadding, TP_CANPadding, TP_CANPadding};
+        Host_BusInject(_UDS_RxID, _FC);                                               // Continue To Send, No Block Limit
+        uint16_t _Offset = 6;
+        while (_Offset < _Total) {                                                    // Consecutive Frames
+            if (Host_Await(&_Frame) || ((_Frame.Data[0] >> 4) != 0x02)) {
+                return 1;
+            }
+            uint16_t _Chunk = ((_Total - _Offset) > 7) ? 7 : (_Total - _Offset);
+            memcpy(&_Data[_Offset], &_Frame.Data[1], _Chunk);
+            _Offset += _Chunk;
+        }
+        *_Length = _Total;
+        return 0;
+    }
+}
+/* ==================================================================================================== */
+
+
+/* ==================================================================================================== */
+/*
+ *  Runner
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+static uint8_t Host_Run (const Host_Case *_Case, Host_Result *_Result) {
+    static uint8_t _Response[Host_RequestSize];
+    uint16_t _Length = 0;
+    uint32_t _Frames = Host_FramesMoved;
+    uint32_t _Virtual = Host_Clock();
+    uint64_t _Start = Host_Micros();
+
+    if (Host_Send(_Case->Request, _Case->Length) || Host_Receive(_Response, &_Length)) {
+        return 1;
+    }
+    while ((UDS_Server.Status != UDS_ServerFree) || TP_Status.TxFlag) {               // Let Server Settle Before Next Request
+        Host_Step();
+    }
+
+    uint64_t _Elapsed = Host_Micros() - _Start;
+    if ((_Length == 0) || (_Response[0] != _Case->Response)) {
+        return 1;
+    }
+    if ((_Result->Count == 0) || (_Elapsed < _Result->Minimum)) {
+        _Result->Minimum = _Elapsed;
+    }
+    if (_Elapsed > _Result->Maximum) {
+        _Result->Maximum = _Elapsed;
+    }
+    _Result->Total += _Elapsed;
+    _Result->Virtual += Host_Clock() - _Virtual;
+    _Result->Bytes += _Case->Length + _Length;
+    _Result->Frames += Host_FramesMoved - _Frames;
+    _Result->Count++;
+    return 0;
+}
+/* ---------------------------------------------------------------------------------------------------- */
+#ifdef UDS_EnableMetrics
+static uint32_t Host_Word (const uint8_t *_Data) {
+    return ((uint32_t)_Data[0] << 24) | ((uint32_t)_Data[1] << 16) | ((uint32_t)_Data[2] << 8) | _Data[3];
+}
+/* ---------------------------------------------------------------------------------------------------- */
+static uint8_t Host_Metrics (void) {
+    static uint8_t _Response[Host_RequestSize];
+    const uint8_t _Request[3] = {0x22, (uint8_t)(UDS_MetricsDID >> 8), (uint8_t)(UDS_MetricsDID & 0xFF)};
+    uint16_t _Length = 0;
+    if (Host_Send(_Request, sizeof(_Request)) || Host_Receive(_Response, &_Length) ||
+          (_Response[0] != 0x62) || (_Length != (3u + UDS_MetricsLength))) {
+        printf("Metrics DID %04X FAILED\n", UDS_MetricsDID);
+        return 1;
+    }
+    const uint8_t *_Record = &_Response[3];
+    const char *_Names[UDS_MetricsPCICount] = {"SF", "FF", "CF", "FC", "Invalid"};
+    printf("\nMetrics DID %04X\n", UDS_MetricsDID);
+    printf("%-18s %12s %12s\n", "Frames", "RX", "TX");
+    for (uint8_t i = 0; i < UDS_MetricsPCICount; i++) {
+        printf("%-18s %12u %12u\n", _Names[i], Host_Word(&_Record[i * 4]), Host_Word(&_Record[20 + (i * 4)]));
+    }
+    printf("%-18s %12u\n", "Dropped", Host_Word(&_Record[40]));
+    printf("%-18s %12u\n", "N_Bs Timeouts", Host_Word(&_Record[44]));
+    printf("%-18s %12u\n", "N_Cr Timeouts", Host_Word(&_Record[48]));
+    printf("%-18s %12u\n", "FC.WAIT", Host_Word(&_Record[52]));
+    printf("%-18s %12u us\n", "Tick Max", Host_Word(&_Record[56]));
+    printf("%-18s %12u\n", "ROE Dropped", Host_Word(&_Record[60]));
+    printf("%-18s %12u\n", "Queue Max", (unsigned)((_Record[64] << 8) | _Record[65]));
+    for (uint8_t i = 0; i < UDS_MetricsNRCSlots; i++) {
+        const uint8_t *_Slot = &_Record[66 + (i * 3)];
+        if (_Slot[1] || _Slot[2]) {
+            printf("NRC SID %02X %20u\n", _Slot[0], (unsigned)((_Slot[1] << 8) | _Slot[2]));
+        }
+    }
+    return 0;
+}
+#endif
+/* ---------------------------------------------------------------------------------------------------- */
+int main (int argc, char **argv) {
+    uint32_t _Iterations = 100;
+    const char *_Trace = NULL;
+    int _Option;
+    while ((_Option = getopt(argc, argv, "n:vt:")) != -1) {
+        switch (_Option) {
+            case 'n' : _Iterations = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'v' : Host_ClockVirtual(1); break;
+            case 't' : _Trace = optarg; break;
+            default :
+                fprintf(stderr, "Usage: %s [-n Iterations] [-v] [-t TraceFile]\n", argv[0]);
+                return 2;
+        }
+    }
+    if (_Trace != NULL) {
+#ifdef UDS_EnableTrace
+        Host_State.Trace = fopen(_Trace, "wb");
+        if (Host_State.Trace == NULL) {
+            perror(_Trace);
+            return 2;
+        }
+#else
+        fprintf(stderr, "Trace Needs A Build With UDS_EnableTrace (make TRACE=1)\n");
+        return 2;
+#endif
+    }
+
+    static Host_Case _Cases[] = {
+        {"TesterPresent",        {0x3E, 0x00},             2, 0x7E},
+        {"ExtendedSession",      {0x10, 0x03},             2, 0x50},
+        {"ReadDID Status",       {0x22, 0x01, 0x00},       3, 0x62},
+        {"ReadDID VIN",          {0x22, 0xF1, 0x90},       3, 0x62},
+        {"ReadDID Block",        {0x22, 0x02, 0x00},       3, 0x62},
+        {"WriteDID Block",       {0x2E, 0x02, 0x00},     103, 0x6E},
+    };
+    uint8_t _CaseCount = sizeof(_Cases) / sizeof(_Cases[0]);
+    for (uint16_t i = 3; i < 103; i++) {                                              // Write Record Pattern
+        _Cases[_CaseCount - 1].Request[i] = (uint8_t)i;
+    }
+
+    UDS_InitApp();
+    Host_Micros();                                                                    // Monotonic Origin
+
+    printf("%-18s %8s %10s %10s %10s %10s %12s %8s\n", "Request", "Count", "Min(us)", "Avg(us)",
+            "Max(us)", "Virt(ms)", "Bytes/s", "Frames");
+    uint8_t _Failed = 0;
+    for (uint8_t c = 0; c < _CaseCount; c++) {
+        Host_Result _Result = {0};
+        for (uint32_t n = 0; n < _Iterations; n++) {
+            if (Host_Run(&_Cases[c], &_Result)) {
+                _Failed = 1;
+                break;
+            }
+        }
+        if (_Result.Count == 0) {
+            printf("%-18s FAILED\n", _Cases[c].Name);
+            continue;
+        }
+        double _Seconds = Host_State.Virtual ? (_Result.Virtual / 1000.0) : (_Result.Total / 1e6);
+        printf("%-18s %8u %10llu %10llu %10llu %10.3f %12.0f %8u\n", _Cases[c].Name, _Result.Count,
+                (unsigned long long)_Result.Minimum, (unsigned long long)(_Result.Total / _Result.Count),
+                (unsigned long long)_Result.Maximum, (double)_Result.Virtual / _Result.Count,
+                (_Seconds > 0) ? (_Result.Bytes / _Seconds) : 0.0, _Result.Frames / _Result.Count);
+    }
+    if (Host_BusToServer.Dropped || Host_BusFromServer.Dropped) {
+        printf("Bus Overflow: %u To Server, %u From Server\n", Host_BusToServer.Dropped, Host_BusFromServer.Dropped);
+        _Failed = 1;
+    }
+#ifdef UDS_EnableMetrics
+    _Failed |= Host_Metrics();
+#endif
+#ifdef UDS_EnableTrace
+    if (Host_State.Trace != NULL) {
+        while (UDS_TraceDrain(Host_TraceBatch)) {                                     // Trace Tail Flushed
+        }
+        fclose(Host_State.Trace);
+    }
+#endif
+    return _Failed;
+}
+/* ==================================================================================================== */
@@ -0,0 +1,88 @@
+/* ==================================================================================================== */
+/*
+ *  trace.c
+ *  Unified Diagnostics Services on CAN (UDSonCAN) - Trace Decoder
+ *    Turns The Binary Stream Drained From UDS_Trace Back Into One Line Per CAN Frame
+ *    Works On A Capture File Or On A Live UART Piped Into Standard Input
+ *
+ *  Usage: UDSonTrace [TraceFile]
+ */
+/* ==================================================================================================== */
+
+#include <stdio.h>
+#include <stdint.h>
+
+
+
+#ifndef TraceDecoderParameters                                                        // Trace Decoder Parameters (Match UDS_Trace.h)
+  #define TraceDecoderParameters
+  #define Trace_Marker                0xA7                                            // Trace Record Start Byte
+  #define Trace_Length                17u                                             // Trace Record Length On The Wire
+#endif
+
+
+static const char *Trace_PCI[16] = {
+    "SF", "FF", "CF", "FC", "??", "??", "??", "??", "??", "??", "??", "??", "??", "??", "??", "??"
+};
+
+
+/* ---------------------------------------------------------------------------------------------------- */
+int main (int argc, char **argv) {
+    FILE *_Input = stdin;
+    if (argc > 2) {
+        fprintf(stderr, "Usage: %s [TraceFile]\n", argv[0]);
+        return 2;
+    }
+    if (argc == 2) {
+        _Input = fopen(argv[1], "rb");
+        if (_Input == NULL) {
+            perror(argv[1]);
+            return 2;
+        }
+    }
+
+    uint8_t _Wire[Trace_Length];
+    uint32_t _Fill = 0;
+    uint32_t _Records = 0;
+    uint32_t _Skipped = 0;
+    uint32_t _Lost = 0;
+    int _Byte;
+    while ((_Byte = fgetc(_Input)) != EOF) {
+        if ((_Fill == 0) && (_Byte != Trace_Marker)) {                                // Hunting For A Record Start
+            _Skipped++;
+            continue;
+        }
+        _Wire[_Fill++] = (uint8_t)_Byte;
+        if (_Fill < Trace_Length) {
+            continue;
+        }
+        _Fill = 0;
+        uint8_t _Sum = 0;
+        for (uint32_t i = 1; i < (Trace_Length - 1); i++) {
+            _Sum += _Wire[i];
+        }
+        if (_Sum != _Wire[Trace_Length - 1]) {                                        // Bad Record, Resync On Next Marker
+            _Skipped += Trace_Length;
+            continue;
+        }
+        uint32_t _Time = ((uint32_t)_Wire[2] << 24) | ((uint32_t)_Wire[3] << 16) | ((uint32_t)_Wire[4] << 8) | _Wire[5];
+        uint16_t _CANID = (uint16_t)((_Wire[6] << 8) | _Wire[7]);
+        if (_Wire[1] == 'L') {                                                        // Records Dropped On The Server
+            printf("%12s  --  %u Records Lost\n", "", _Time);
+            _Lost += _Time;
+            continue;
+        }
+        printf("%12u  %s  %03X  %s ", _Time, (_Wire[1] == 'T') ? "TX" : "RX", _CANID, Trace_PCI[_Wire[8] >> 4]);
+        for (uint32_t i = 8; i < 16; i++) {
+            printf(" %02X", _Wire[i]);
+        }
+        printf("\n");
+        _Records++;
+    }
+    if (_Input != stdin) {
+        fclose(_Input);
+    }
+    fprintf(stderr, "%u Records, %u Lost On Server, %u Bytes Skipped\n", _Records, _Lost, _Skipped);
+    return 0;
+}
+/* ==================================================================================================== */
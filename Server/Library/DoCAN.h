@@ -16,6 +16,9 @@
   #include "UDS.h"
   #include "RachanaUDS.h"
   #include "SansaadhanUDS.h"
+#elif defined(_UDSonHost)
+  #include <stdint.h>
+  #include "UDS.h"
 #else
   #include "CommonIncs.h"
   #include "UDS.h"
@@ -32,14 +35,6 @@
  *  Declaring and Initializing the DoCAN Operational Variables
  */
  /* ---------------------------------------------------------------------------------------------------- */
-#ifndef TP_CANPadding
-  #define TP_CANPadding                               0x55                            // TP CAN Padding Character
-#endif
-
-#ifndef TP_RxBufferSize
-  #define TP_RxBufferSize                             128u                            // TP Receive Message Buffer Size
-#endif
-
 #ifndef TP_FlowStatus
   #define TP_FlowStatus
   #define TP_FSContinueToSend                         0x00                            // TP FS Continue To Send (CTS)
@@ -47,18 +42,6 @@
   #define TP_FSOverflow                               0x02                            // TP FS Overflow (OF)
 #endif
 
-#ifndef TP_ServerParameters
-  #define TP_ServerParameters
-  #define TP_ServerWaitCountDown                      600u                            // TP Wait Count Down
-  #define TP_ServerWaitTimeout                        5000u                           // TP Wait Timeout
-  #define TP_Server_NAs                               1000u                           // TP Timeout N_As
-  #define TP_Server_NAr                               1000u                           // TP Timeout N_Ar
-  #define TP_Server_NBs                               1000u                           // TP Timeout N_Bs
-  #define TP_Server_NBr                               0u                              // TP Timeout N_Br
-  #define TP_Server_NCs                               0u                              // TP Timeout N_Cs
-  #define TP_Server_NCr                               1000u                           // TP Timeout N_Cr
-#endif
-
 #ifndef TP_TxProcessFlow
   #define TP_TxProcessFlow
   #define TP_TxProcessIdle                            0u
@@ -70,6 +53,10 @@
   #define TP_TxProcessSFSending                       6u
 #endif
 
+#ifndef TP_NoDeadline
+  #define TP_NoDeadline                               UDS_DeadlineNone                // TP Nothing Timed Pending
+#endif
+
 
 typedef union {
     uint8_t Raw;
@@ -164,7 +151,6 @@ typedef struct {
 extern TP_SegmentedBlockRx TP_RxControl;
 
 typedef struct {
-    uint32_t Time;                                                                    // TP Buffer Entry Time
     uint8_t Process;                                                                  // TP Buffer Process Flow
     uint8_t FlowStatus;                                                               // TP Buffer Tester Bus State
     uint8_t FrameIndex;                                                               // TP Consecutive Frame
@@ -186,10 +172,17 @@ extern void TP_ReceiveDataCAN (uint16_t _CANID, uint8_t _D0, uint8_t _D1, uint8_
 extern void TP_SendDataCAN (uint16_t _CANID, uint8_t _D0, uint8_t _D1, uint8_t _D2,
       uint8_t _D3, uint8_t _D4, uint8_t _D5, uint8_t _D6, uint8_t _D7);
 extern void TP_SendDataFrameCAN (void);
+extern uint8_t TP_SetBaudrateCAN (uint32_t _Baud);
+extern void TP_LinkTransition (void);
+#if !defined(_UDSonSPI) && !defined(_UDSonHost)
+extern uint8_t SetCanBaudrate (uint32_t _Baud);                                       // Supplied By Platform
+#endif
+extern void TP_LinkRevert (void);
 
 extern void TP_VariablesStart (void);
 extern void TP_SendNegativeResponse (uint8_t _Reason, uint8_t _SID, char C);
 extern uint8_t TP_CheckCANID (uint16_t _CANID, char C);
+extern uint8_t TP_CheckFunctional (uint16_t _CANID, uint8_t _Allowed);
 
 extern void TP_RxFrameSF (void);
 extern void TP_RxFrameFF (void);
@@ -205,9 +198,23 @@ extern void TP_RxDoCAN (void);
 extern void TP_TxDoCAN (void);
 extern void TP_TxFrameUSDT (char C);
 
+extern uint32_t TP_NextDeadline (uint32_t _Time);
+
 
 #ifdef _UDSonSPI
   #include "UDSonSPI.h"                                                               // Physical Layer Included
+#elif defined(_UDSonHost)
+  #include "UDSonHost.h"                                                              // Physical Layer Included
+#elif defined(UDS_EnableRTOSTask)
+  #include "UDSonFreeRTOS.h"                                                          // Task Port Included
+#endif
+
+#ifndef UDS_PortWake
+  #define UDS_PortWake()                              ((void)0)                       // No Sleeping Server Task To Wake
+#endif
+#ifndef UDS_PortEnterCritical
+  #define UDS_PortEnterCritical()                     ((void)0)                       // Single Thread Build, No Writer To Race
+  #define UDS_PortExitCritical()                      ((void)0)
 #endif
 
 
@@ -232,6 +239,9 @@ extern void TP_TxFrameUSDT (char C);
 
 #ifdef _UDSonSPI
   #include "UDS.h"
+#elif defined(_UDSonHost)
+  #include "DoCAN.h"
+  #include "UDS.h"
 #else
   #include "CommonIncs.h"
   #include "DoCAN.h"
@@ -261,11 +271,19 @@ TP_SegmentedBlockTx TP_TxControl = {0};
  *  void TP_SendDataCAN (uint16_t _CANID, uint8_t _D0, uint8_t _D1, uint8_t _D2, uint8_t _D3,
  *        uint8_t _D4, uint8_t _D5, uint8_t _D6, uint8_t _D7)
  *  void TP_SendDataFrameCAN (void)
+ *  uint8_t TP_SetBaudrateCAN (uint32_t _Baud)
+ *  void TP_LinkTransition (void)
+ *  void TP_LinkRevert (void)
+ *
+ *  FreeRTOS And Bare Metal Platforms Supply uint8_t SetCanBaudrate (uint32_t _Baud) : It Waits For
+ *  Pending CAN Transmission, Reprograms The Bit Timing And Returns Zero Once The New Baudrate Is Active
  */
 /* ---------------------------------------------------------------------------------------------------- */
 uint32_t TP_Clock (void) {
 #ifdef _UDSonSPI
     return Tools.Clock(); 
+#elif defined(_UDSonHost)
+    return Host_Clock();                                                              // Virtual Or Monotonic Milliseconds
 #else
     return xTaskGetTickCount();
 #endif
@@ -273,6 +291,7 @@ uint32_t TP_Clock (void) {
 /* ---------------------------------------------------------------------------------------------------- */
 void TP_ReceiveDataCAN (uint16_t _CANID, uint8_t _D0, uint8_t _D1, uint8_t _D2,
       uint8_t _D3, uint8_t _D4, uint8_t _D5, uint8_t _D6, uint8_t _D7) {
+    UDS_MetricsRxOverwrite();                                                         // Previous Frame Not Yet Read Counted
     TP_MessageRX.CANID.Raw = _CANID;                                                  // TP CAN ID Receoved Loaded
     TP_MessageRX.Data[0] = _D0;                                                       // TP CAN Data Received Loaded
     TP_MessageRX.Data[1] = _D1;                                                       // TP CAN Data Received Loaded
@@ -287,10 +306,13 @@ void TP_ReceiveDataCAN (uint16_t _CANID, uint8_t _D0, uint8_t _D1, uint8_t _D2,
 /* ---------------------------------------------------------------------------------------------------- */
 void TP_SendDataCAN (uint16_t _CANID, uint8_t _D0, uint8_t _D1, uint8_t _D2,
       uint8_t _D3, uint8_t _D4, uint8_t _D5, uint8_t _D6, uint8_t _D7) {
+    UDS_MetricsTxFrame(_D0 >> 4);                                                     // Frame Counted By PCI
+    UDS_TraceSend(_CANID, _D0, _D1, _D2, _D3, _D4, _D5, _D6, _D7);                    // Frame Copied To Trace Ring
 #ifdef _UDSonSPI
     SPI_TransmitFrameBuild(_CANID, _D0, _D1, _D2, _D3, _D4, _D5, _D6, _D7);           // SPI Transmit Frame Building
-    SPI_TransmitFrameShow();                                                          // SPI Transmit Frame Show
     SPI_TransmitFrame();                                                              // SPI Transmit Frame Sent
+#elif defined(_UDSonHost)
+    Host_BusSend(_CANID, _D0, _D1, _D2, _D3, _D4, _D5, _D6, _D7);                     // In Memory Bus
 #else
 	CanData_t SendData;
 	SendData.Id = _CANID;
@@ -312,6 +334,33 @@ void TP_SendDataFrameCAN (void) {
                     TP_MessageTX.Data[2], TP_MessageTX.Data[3], TP_MessageTX.Data[4],
                     TP_MessageTX.Data[5], TP_MessageTX.Data[6], TP_MessageTX.Data[7]);
 }
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t TP_SetBaudrateCAN (uint32_t _Baud) {
+#ifdef _UDSonSPI
+    (void)_Baud;                                                                      // CAN Controller Sits Behind The SPI Bridge
+    return 1;                                                                         // Baudrate Not Changed
+#elif defined(_UDSonHost)
+    return Host_SetBaudrate(_Baud);                                                   // In Memory Bus Baudrate
+#else
+    return SetCanBaudrate(_Baud);                                                     // Driver Waits For Pending TX Then Reprograms Bit Timing
+#endif
+}
+/* ---------------------------------------------------------------------------------------------------- */
+void TP_LinkTransition (void) {
+    UDS_Link.Transition = 0u;                                                         // TP Link Transition Consumed
+    if (TP_SetBaudrateCAN(UDS_Link.VerifiedBaud) == 0) {                              // TP Reprogramming CAN Bit Timing
+        UDS_Link.ActiveBaud = UDS_Link.VerifiedBaud;                                  // TP New Baudrate Active
+    }
+    UDS_Link.VerifiedBaud = 0u;                                                       // TP Verification Used Up
+}
+/* ---------------------------------------------------------------------------------------------------- */
+void TP_LinkRevert (void) {
+    UDS_Link.Revert = 0u;                                                             // TP Link Revert Consumed
+    if (UDS_Link.ActiveBaud != UDS_LinkDefaultBaud) {                                 // TP Link Still Switched
+        TP_SetBaudrateCAN(UDS_LinkDefaultBaud);                                       // TP Back To Default Baudrate
+        UDS_Link.ActiveBaud = UDS_LinkDefaultBaud;                                    // TP Default Baudrate Active
+    }
+}
 /* ==================================================================================================== */
 
 
@@ -326,17 +375,18 @@ void TP_SendDataFrameCAN (void) {
  *  Misc Functions for TP Layers
  *
  *  uint8_t TP_CheckCANID (uint16_t _CANID, char C)
+ *  uint8_t TP_CheckFunctional (uint16_t _CANID, uint8_t _Allowed)
  *  void TP_SendNegativeResponse (uint8_t _Reason, uint8_t _SID, uint16_t _CANID)
  */
 /* ---------------------------------------------------------------------------------------------------- */
 uint8_t TP_CheckCANID (uint16_t _CANID, char C) {
     if ((C == 'R') || (C == 'r')) {                                                   // Received Mode Selection
-        if (_CANID == UDS_Server.UDS_RxID) {                                          // Received CAN IDs Check
+        if (_CANID == _UDS_RxID) {                                                    // Received CAN IDs Check
           return 0;                                                                   // Received Physical CAN ID Flag
         }
         uint8_t i = 0;
-        while (i < UDS_Addressing.FunctionalIDAvailable) {                            // Received Functional Address ID Check Loop
-          if (_CANID == UDS_Addressing.FunctionalRxID[i]) {                           // Received Functional Address ID Check
+        while (i < UDS_FunctionalCount) {                                             // Received Functional Address ID Check Loop
+          if (_CANID == UDS_FunctionalRxID[i]) {                                      // Received Functional Address ID Check
             return 0;                                                                 // Received Functional ID Flag
           }
           i++;
@@ -344,12 +394,12 @@ uint8_t TP_CheckCANID (uint16_t _CANID, char C) {
         return 0xFF;                                                                  // No CAN ID Matched
     }
     if ((C == 'T') || (C == 't')) {                                                   // Transmited Mode Selection
-        if (_CANID == UDS_Server.UDS_TxID) {                                          // Transmited CAN IDs Check
+        if (_CANID == _UDS_TxID) {                                                    // Transmited CAN IDs Check
           return 0;                                                                   // Transmited Physical CAN ID Flag
         }
         uint8_t i = 0;
-        while (i < UDS_Addressing.FunctionalIDAvailable) {                            // Transmited Functional Address ID Check Loop
-          if (_CANID == UDS_Addressing.FunctionalTxID[i]) {                           // Transmited Functional Address ID Check
+        while (i < UDS_FunctionalCount) {                                             // Transmited Functional Address ID Check Loop
+          if (_CANID == UDS_FunctionalTxID[i]) {                                      // Transmited Functional Address ID Check
             return 0;                                                                 // Transmited Functional ID Flag
           }
           i++;
@@ -359,9 +409,21 @@ uint8_t TP_CheckCANID (uint16_t _CANID, char C) {
     return 0xFF;
 }
 /* ---------------------------------------------------------------------------------------------------- */
+uint8_t TP_CheckFunctional (uint16_t _CANID, uint8_t _Allowed) {
+    uint8_t i = 0;
+    while (i < UDS_FunctionalCount) {                                                 // Received Functional Address ID Check Loop
+      if (_CANID == UDS_FunctionalRxID[i]) {                                          // Received Functional Address ID Check
+        return (_Allowed >> i) & 0x01;                                                // Functional ID Allowed Flag
+      }
+      i++;
+    }
+    return 0;                                                                         // Physical Or Unknown CAN ID
+}
+/* ---------------------------------------------------------------------------------------------------- */
 void TP_SendNegativeResponse (uint8_t _Reason, uint8_t _SID, char C) {
     if ((C == 'P') || (C == 'p')) {                                                   // For Physical Addressing of UDS
-        TP_SendDataCAN(UDS_Server.UDS_TxID, UDS_NRC_Length, UDS_NRC, _SID, _Reason,   // Sending Negative Response
+        UDS_MetricsCountNRC(_SID);                                                    // NRC Counted Against The SID
+        TP_SendDataCAN(_UDS_TxID, UDS_NRC_Length, UDS_NRC, _SID, _Reason,             // Sending Negative Response
                   TP_CANPadding, TP_CANPadding, TP_CANPadding, TP_CANPadding);
     } else if ((C == 'F') || (C == 'f')) {                                            // For Functional Addressing of UDS
         // Functional Addressing
@@ -402,14 +464,15 @@ void TP_VariablesStart (void) {
     TP_TxControl.DataCounter = 0u;                                                    // TP Tx Data Bytes Counter
     TP_TxControl.BlocksAllowed = 0u;                                                  // TP Tx Blocks Allowed Received From Flow Control
     TP_TxControl.SeparationTimeout = 0u;                                              // TP Tx Separation Time Received From Flow Control
-    TP_TxControl.Time = 0u;                                                           // TP Tx Timer Entry Points
+    UDS_DeadlineCancel(UDS_DeadlineRx);                                               // TP N_Cr Off
+    UDS_DeadlineCancel(UDS_DeadlineTx);                                               // TP N_Bs And STmin Off
     TP_TxControl.Process = TP_TxProcessIdle;                                          // TP Tx Process Set to Idle
 }
 
 extern void TP_SendFlowControl (void);
 void TP_SendFlowControl (void) {
     // Any Logic For Processing and Sending Flow Control
-    TP_TxFrameFC(UDS_Server.UDS_TxID,0,0,0);                                          // TP Transmit Flow Control
+    TP_TxFrameFC(_UDS_TxID,0,0,0);                                                    // TP Transmit Flow Control
 }
 /* ==================================================================================================== */
 
@@ -431,6 +494,12 @@ void TP_SendFlowControl (void) {
  */
 /* ---------------------------------------------------------------------------------------------------- */
 void TP_RxFrameSF (void) {
+    if ((TP_MessageRX.Data[0] == 0x02) && (TP_MessageRX.Data[1] == 0x3E) &&          // Tester Present With Suppressed Response
+          (TP_MessageRX.Data[2] == 0x80) &&                                           // Functional Only, Same IDs As Service 0x3E
+          TP_CheckFunctional(TP_MessageRX.CANID.Raw, UDS_FuncID1 | UDS_FuncID2)) {
+      UDS_SessionTimerUpdate();                                                       // Session Kept Alive, No Copy, Server Not Occupied
+      return;
+    }
     if (UDS_Server.Status == UDS_ServerFree) {                                        // Checking if UDS Server is Free
       if ((TP_MessageRX.Data[0] < 8) && (TP_MessageRX.Data[0] != 0)) {                // Checking for Length
           UDS_Message.CANID = TP_MessageRX.CANID.Raw;                                 // UDS CAN ID Loaded
@@ -454,21 +523,17 @@ void TP_RxFrameFF (void) {
         uint16_t Length = 0;
         Length = (uint16_t)(TP_MessageRX.Data[1] |                                    // Extracting Length
                     (uint16_t)((TP_MessageRX.Data[0] & 0x0F) << 8));
-        if ((Length > 7) && (Length < 4096)) {                                        // Checking for Length
+        if (Length > TP_MaxFFDL) {                                                    // Checking Length Against Receive Buffer
+            TP_TxFrameFC(_UDS_TxID, TP_FSOverflow, 0, 0);                             // TP Transmit Flow Control Overflow
+        } else if ((Length > 7) && (Length < 4096)) {                                 // Checking for Length
             UDS_Message.CANID = TP_MessageRX.CANID.Raw;                               // UDS CAN ID Loaded
             UDS_Message.Length = Length;                                              // UDS Frame Length Loaded
             TP_RxControl.TotalLength = Length;                                         // TP Receive Total Payload Loaded
-            uint16_t Frames = 0;
-            Frames = Length - 6;
-            if ((Frames % 7) == 0) {
-                Frames = (Frames / 7) + 1;
-            } else {
-                Frames = (Frames / 7) + 2;
-            }
-            TP_RxControl.TotalFrames = Frames;                                         // TP Receive Total Number of Frames
+            TP_RxControl.TotalFrames = TP_FrameCount(Length);                         // TP Receive Total Number of Frames
             TP_RxControl.FrameCounter = 1;                                             // TP Receive Frame Counter Set To 1
             TP_RxControl.FrameIndex = 1;                                               // TP Receive Frame Index is Zero + 1
             TP_Status.WaitCount = 0;                                                  // TP Receive Status Wait Count Reset
+            UDS_DeadlineArm(UDS_DeadlineRx, TP_Clock(), TP_Server_NCr);               // TP N_Cr Started
             TP_RxControl.DataCounter = 0;                                              // TP Receive Data Byte Counter Reseted
             uint8_t i = 2;
             while (i < 8) {
@@ -476,8 +541,10 @@ void TP_RxFrameFF (void) {
               TP_RxControl.DataCounter++;                                              // TP Received Data Bytes Counter Incremented
               i++;
             }
+            UDS_AuthRxStart(Length);                                                  // Secured Request MAC Started
+            UDS_AuthRxUpdate(TP_RxControl.DataCounter);                               // First Frame Bytes MACed
             UDS_Server.Status = UDS_ServerReceiving;                                  // UDS Server in Receiving Mode
-            
+            TP_SendFlowControl();                                                     // TP Request Remaining Consecutive Frames
         } else {
             TP_SendNegativeResponse(UDS_NRC_IMLIF, TP_MessageRX.Data[1], 'P');        // NRC : Incorrect Format
         }
@@ -493,6 +560,7 @@ void TP_RxFrameCF (void) {
         if (TP_RxControl.FrameIndex == FrameIndex) {                                   // Frame Index Checker
             TP_RxControl.FrameIndex = (TP_RxControl.FrameIndex + 1) % 16;               // TP Receive Frame Index Incremented with Overflow Check
             TP_RxControl.FrameCounter++;                                               // TP Frame Counter Incremented
+            UDS_DeadlineArm(UDS_DeadlineRx, TP_Clock(), TP_Server_NCr);               // TP N_Cr Restarted
             uint8_t i = 1;
             while (i < 8) {
               if (TP_RxControl.DataCounter >= TP_RxBufferSize) {                       // TP Data Counter Check for Memory Check
@@ -502,9 +570,11 @@ void TP_RxFrameCF (void) {
               TP_RxControl.DataCounter++;                                              // TP Received Data Bytes Counter Incremented
               i++;
             }
+            UDS_AuthRxUpdate(TP_RxControl.DataCounter);                               // Consecutive Frame Bytes MACed
 
             if (TP_RxControl.FrameCounter >= TP_RxControl.TotalFrames) {                // TP Receiver Check is All Frames Received
               UDS_Server.Status = UDS_ServerBusy;                                     // UDS Server Status is Set To Busy``
+              UDS_DeadlineCancel(UDS_DeadlineRx);                                     // TP N_Cr Stopped
             }
         }
     }
@@ -519,17 +589,20 @@ void TP_RxFrameFC (void) {
         case TP_FSContinueToSend : {                                                  // FS = Continue To Send (CTS)
             TP_TxControl.FlowStatus = TP_FSContinueToSend;                               // TP Transmit Status To CTS
             TP_TxControl.BlocksAllowed = TP_MessageRX.Data[1];                         // Extracting Block Size (BS) and Loading in TP
-            uint32_t _Time = 0;
-            if ((TP_MessageRX.Data[2] >> 4) < 10)  {                                  // Checking For Format of STMin
-              _Time = (TP_MessageRX.Data[2] & 0xF0) ? 1 : 0;                          // Assigning 1 ms
+            uint8_t _STmin = TP_MessageRX.Data[2];                                    // Extracting Separation Time Minimum (STMin)
+            uint32_t _Time = 127u;                                                    // Reserved STMin Treated As Longest (ISO 15765-2)
+            if (_STmin <= 0x7F) {                                                     // STMin 0 - 127 ms
+              _Time = _STmin;
+            } else if ((_STmin >= 0xF1) && (_STmin <= 0xF9)) {                        // STMin 100 - 900 us
+              _Time = 1u;                                                             // Rounded Up To The Millisecond Clock
             }
-            _Time = (TP_MessageRX.Data[2] & 0x0F) + _Time;                            // Extracting Separation Time Minimum (STMin)
             TP_TxControl.SeparationTimeout = _Time;                                    // Loading Separation Time Minimum
             TP_TxControl.ReceivedFC = 1;                                               // TP Received Flow Control Flag is Set
             break;
         }
         case TP_FSWait : {                                                            // FS = Wait (WT)
             TP_TxControl.FlowStatus = TP_FSWait;                                         // TP Transmit Status To Wait
+            UDS_MetricsCount(FlowWait);                                               // FC.WAIT Counted
             UDS_Server.Status = UDS_ServerWaiting;                                    // UDS Server Status is Set To Waiting
             TP_TxControl.ReceivedFC = 1;                                               // TP Received Flow Control Flag is Set
             break;
@@ -637,7 +710,7 @@ void TP_TxFrameFC (uint16_t CANID, uint8_t FS, uint8_t STmin, uint8_t BS) {
 /* ---------------------------------------------------------------------------------------------------- */
 void TP_TxFrameUSDT (char C) {
     if ((C == 'P') || (C == 'p')) {                                                   // Physical Addressing Mode
-      TP_MessageTX.CANID.Raw = UDS_Server.UDS_TxID;                                   // Loaded Physical Addressing TX CAN ID
+      TP_MessageTX.CANID.Raw = _UDS_TxID;                                             // Loaded Physical Addressing TX CAN ID
     } else if ((C == 'F') || (C == 'f')) {                                            // Functional Addressing Mode
       // Functional IDs
     } else {                                                                          // Ignoring Exceptions
@@ -656,21 +729,14 @@ void TP_TxFrameUSDT (char C) {
 
     // Multi Frame Transmission
     else {                                                                            // UDS Segamented Multiple Transmission
-      if (UDS_Message.Length >= UDS_ParaBufferSize) {                                 // Normal USDT Sending Check
+      if (UDS_Message.Length > UDS_TxLengthMax) {                                     // Normal USDT Sending Check
         UDS_Server.Status = UDS_ServerFree;                                           // UDS Server Status is Set To Free
         TP_TxControl.Process = TP_TxProcessIdle;                                      // TP Process Selected To Idle State
         return;                                                                       // Doing Nothing
       }
       UDS_Server.Status = UDS_ServerTransmitting;                                     // UDS Server Status is Set To Transmitting
-      uint16_t Frames = 0;
-      Frames = UDS_Message.Length - 6;                                                // Number of Frames Check
-      if ((Frames % 7) == 0) {
-          Frames = (Frames / 7) + 1;                                                  // Frames Require No Padding At Last
-      } else {
-          Frames = (Frames / 7) + 2;                                                  // Frames Require Padding At Last
-      }
       TP_Status.WaitCount = 0;
-      TP_TxControl.TotalFrames = Frames;                                              // TP Total Frames Loaded
+      TP_TxControl.TotalFrames = TP_FrameCount(UDS_Message.Length);                   // TP Total Frames Loaded
       TP_TxControl.FrameCounter = 0;
       TP_TxControl.FrameIndex = 0;
       TP_TxControl.FramesAllowed = 0;
@@ -695,6 +761,7 @@ void TP_TxFrameUSDT (char C) {
 
 void TP_TxDoCAN (void) {
     if (TP_Status.TxFlag == 0x00) {                                                   // Checking for TX Flag
+      UDS_DeadlineCancel(UDS_DeadlineTx);                                             // Nothing Timed Without A Transfer
       return;
     }
     else if (TP_Status.TxFlag == 0x01) {                                              // If CAN Message Transmission
@@ -703,6 +770,7 @@ void TP_TxDoCAN (void) {
 
         case TP_TxProcessIdle : {                                                     // TP Process : Idle State
             TP_Status.TxFlag = 0x00;                                                  // TP Reseting TX Flag
+            UDS_DeadlineCancel(UDS_DeadlineTx);                                       // Transfer Over, Timer Off
             return;
         }
 
@@ -710,12 +778,13 @@ void TP_TxDoCAN (void) {
             TP_TxFrameFF();                                                           // Sending First Frame
             TP_TxControl.FrameCounter++;                                              // TP Frame Counter Incremented
             TP_TxControl.Process = TP_TxProcessFCWait;                                // TP Process Selected To FF Sent
-            TP_TxControl.Time = TP_Clock();                                           // TP Flow Control Wait Entry Time
+            UDS_DeadlineArm(UDS_DeadlineTx, Time, TP_Server_NBs);                     // TP N_Bs Started
             return;
         }
 
         case TP_TxProcessFCWait : {                                                   // TP Process : Flow Control Wait State
-            if ((Time - TP_TxControl.Time) > TP_Server_NBs) {                         // Flow Control Receive Timeout
+            if (UDS_DeadlineDue(UDS_DeadlineTx, Time)) {                              // Flow Control Receive Timeout
+                UDS_MetricsCount(TimeoutNBs);                                         // N_Bs Timeout Counted
                 UDS_Server.Status = UDS_ServerFree;                                   // UDS Server Status is Set To Free
                 TP_TxControl.Process = TP_TxProcessIdle;                              // TP Process Selected To Idle State
                 return;
@@ -734,7 +803,7 @@ void TP_TxDoCAN (void) {
                       return;                                                         // TP Wait Counted Out
                   }
                   TP_TxControl.Process = TP_TxProcessWaiting;                         // TP Process Selected To Waiting State
-                  TP_TxControl.Time = TP_Clock();                                     // TP Wait Entry Time Loaded
+                  UDS_DeadlineArm(UDS_DeadlineTx, Time, TP_ServerWaitTimeout);        // TP Wait Timeout Started
                   return;
               } else if (TP_TxControl.FlowStatus == TP_FSContinueToSend) {
                   if (TP_TxControl.BlocksAllowed == 0) {
@@ -751,7 +820,7 @@ void TP_TxDoCAN (void) {
                   }
                   UDS_Server.Status = UDS_ServerTransmitting;                         // UDS Server Status is Set To Transmitting
                   TP_TxControl.Process = TP_TxProcessSeparationWait;                  // TP Process Selected To Frame Separation Wait State
-                  TP_TxControl.Time = TP_Clock();                                     // TP Separation Time Entry Time Loaded
+                  UDS_DeadlineArm(UDS_DeadlineTx, Time, TP_TxControl.SeparationTimeout); // TP STmin Started
               }
               TP_TxControl.ReceivedFC = 0x00;                                         // TP Reseting Flow Control Flag
             }
@@ -759,7 +828,7 @@ void TP_TxDoCAN (void) {
         }
 
         case TP_TxProcessSeparationWait : {                                           // TP Process : Separation Timeout Between Frames State
-            if ((Time - TP_TxControl.Time) > TP_TxControl.SeparationTimeout) {        // Separation Between Frame Timeout
+            if (UDS_DeadlineDue(UDS_DeadlineTx, Time)) {                              // Separation Between Frame Timeout
                 TP_TxControl.Process = TP_TxProcessCFSending;                         // TP Process Selected To Send Consecutive Frame State
             }
             return;
@@ -775,16 +844,18 @@ void TP_TxDoCAN (void) {
                     TP_TxControl.Process = TP_TxProcessIdle;                          // TP Process Selected To Idle State
                     return;
                 }
-                TP_TxControl.Time = TP_Clock();                                       // TP Separation Time Entry Time Loaded
+                UDS_DeadlineArm(UDS_DeadlineTx, Time, TP_TxControl.SeparationTimeout); // TP STmin Started
                 TP_TxControl.Process = TP_TxProcessSeparationWait;                    // TP Process Selected To Frame Separation Wait State
             } else {
                 TP_TxControl.Process = TP_TxProcessFCWait;                            // TP Process Selected To Wait for Flow Control State
+                UDS_DeadlineArm(UDS_DeadlineTx, Time, TP_Server_NBs);                 // TP N_Bs Started
             }
             return;
         }
 
         case TP_TxProcessWaiting : {                                                  // TP Process : Wait State
-            if ((Time - TP_TxControl.Time) > TP_ServerWaitTimeout) {                  // Wait Receive Timeout
+            if (UDS_DeadlineDue(UDS_DeadlineTx, Time)) {                              // Wait Receive Timeout
+                UDS_MetricsCount(TimeoutNBs);                                         // N_Bs Timeout Counted (After FC.WAIT)
                 UDS_Server.Status = UDS_ServerFree;                                   // UDS Server Status is Set To Free
                 TP_TxControl.Process = TP_TxProcessIdle;                              // TP Process Selected To Idle State
                 return;
@@ -803,7 +874,7 @@ void TP_TxDoCAN (void) {
                       return;                                                         // TP Wait Counted Out
                   }
                   TP_TxControl.Process = TP_TxProcessWaiting;                         // TP Process Selected To Waiting State
-                  TP_TxControl.Time = TP_Clock();                                     // TP Wait Entry Time Loaded
+                  UDS_DeadlineArm(UDS_DeadlineTx, Time, TP_ServerWaitTimeout);        // TP Wait Timeout Started
                   return;
               } else if (TP_TxControl.FlowStatus == TP_FSContinueToSend) {
                   if (TP_TxControl.BlocksAllowed == 0) {
@@ -820,7 +891,7 @@ void TP_TxDoCAN (void) {
                   }
                   UDS_Server.Status = UDS_ServerTransmitting;                         // UDS Server Status is Set To Transmitting
                   TP_TxControl.Process = TP_TxProcessSeparationWait;                  // TP Process Selected To Frame Separation Wait State
-                  TP_TxControl.Time = TP_Clock();                                     // TP Separation Time Entry Time Loaded
+                  UDS_DeadlineArm(UDS_DeadlineTx, Time, TP_TxControl.SeparationTimeout); // TP STmin Started
               }
               TP_TxControl.ReceivedFC = 0x00;
             }
@@ -829,6 +900,12 @@ void TP_TxDoCAN (void) {
 
         case TP_TxProcessSFSending : {                                                // TP Process : Sending Single Frame State
             TP_TxFrameSF();                                                           // DoCAN Single Frame Transmission
+            if (UDS_Link.Transition) {                                                // Link Control Response Has Been Sent
+                TP_LinkTransition();                                                  // Switching Baudrate After Response
+            }
+            if (UDS_Link.Revert) {                                                    // Session End Response Has Been Sent
+                TP_LinkRevert();                                                      // Default Baudrate After Response
+            }
             UDS_Server.Status = UDS_ServerFree;                                       // UDS Server Status is Set To Free
             TP_TxControl.Process = TP_TxProcessIdle;                                  // TP Process Selected To Idle State
             return;
@@ -858,15 +935,24 @@ void TP_TxDoCAN (void) {
 
 
 void TP_RxDoCAN (void) {
+    if (UDS_DeadlineDue(UDS_DeadlineRx, TP_Clock())) {                                // Consecutive Frame Receive Timeout
+      UDS_DeadlineCancel(UDS_DeadlineRx);
+      if (UDS_Server.Status == UDS_ServerReceiving) {
+        UDS_MetricsCount(TimeoutNCr);                                                 // N_Cr Timeout Counted
+        UDS_Server.Status = UDS_ServerFree;                                           // Segmented Request Abandoned
+      }
+    }
     if (TP_Status.RxFlag == 0x00) {                                                   // Checking for RX Flag
       return;
     } else if (TP_Status.RxFlag == 0x01) {                                            // If CAN Message is Received
       TP_Status.RxFlag = 0;                                                           // RX Flag Reset
+      UDS_TraceReceive();                                                             // Frame Copied To Trace Ring
       if (TP_CheckCANID(TP_MessageRX.CANID.Raw, 'R')) {                               // Check CANID To Filter Junk Message
         return;                                                                       // Ignoring Junk Messages
       }
       uint8_t PCI = TP_MessageRX.Data[0];                                             // Reading PCI
       PCI = PCI >> 4;                                                                 // Extracting First 4 Bits
+      UDS_MetricsRxFrame(PCI);                                                        // Frame Counted By PCI
 
       switch (PCI) {                                                                  // Checking The Protocol Control Indicator
         // Receiving Single Frame
@@ -901,6 +987,44 @@ void TP_RxDoCAN (void) {
       return;
     }
 }
+/* ---------------------------------------------------------------------------------------------------- */
+
+
+/* ==================================================================================================== */
+/*
+ *  Section
+ *  Transport Deadlines
+ *
+ *  uint32_t TP_NextDeadline (uint32_t _Time)
+ *
+ *  Clock Ticks Until TP_RxDoCAN Or TP_TxDoCAN Next Has Work, Zero When Due Now
+ *  Timed Waits (N_Cr, N_Bs, FC.WAIT, STmin) Come From UDS_Deadline, Only Untimed Work Is Checked Here
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint32_t TP_NextDeadline (uint32_t _Time) {
+    if (TP_Status.RxFlag) {                                                           // Frame Waiting For TP_RxDoCAN
+      return 0u;
+    }
+    if (TP_Status.TxFlag) {
+      switch (TP_TxControl.Process) {
+          case TP_TxProcessFCWait :                                                   // Waiting Unless Flow Control Arrived
+          case TP_TxProcessWaiting : {
+              if (TP_TxControl.ReceivedFC) {
+                return 0u;
+              }
+              break;
+          }
+          case TP_TxProcessSeparationWait : {                                         // STmin Is Timed
+              break;
+          }
+          default : {                                                                 // Frame Ready To Send
+              return 0u;
+          }
+      }
+    }
+    return UDS_DeadlineNext(_Time);
+}
+/* ==================================================================================================== */
 
 
 
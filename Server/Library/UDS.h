@@ -16,53 +16,23 @@
 #ifdef _UDSonSPI
   #include "RachanaUDS.h"
   #include "SansaadhanUDS.h"
+#elif defined(_UDSonHost)
+  #include <stdint.h>
 #else
   #include "CommonIncs.h"
 #endif
 
+#include "UDS_Config.h"
 
 
 
 
-
-#ifndef UDSCANID                                                                      // UDS Server CAN IDs
-  #define UDSCANID
-  
-  #define _UDS_RxID                   0x785                                           // UDS Server RX CAN ID
-  #define _UDS_TxID                   0x78D                                           // UDS Server TX CAN ID
-  
-  #define _UDS_Fun1_RxID              0x069                                           // UDS Server Functional Rx ID 1
-  #define _UDS_Fun1_TxID              0x096                                           // UDS Server Functional Tx ID 1
-  #define _UDS_Fun2_RxID              0x0A5                                           // UDS Server Functional Rx ID 2
-  #define _UDS_Fun2_TxID              0x05A                                           // UDS Server Functional Tx ID 2
-  #define _UDS_Fun3_RxID              0x000                                           // UDS Server Functional Rx ID 3
-  #define _UDS_Fun3_TxID              0x000                                           // UDS Server Functional Tx ID 3
-  #define _UDS_Fun4_RxID              0x000                                           // UDS Server Functional Rx ID 4
-  #define _UDS_Fun4_TxID              0x000                                           // UDS Server Functional Tx ID 4
-  #define _UDS_Fun5_RxID              0x000                                           // UDS Server Functional Rx ID 5
-  #define _UDS_Fun5_TxID              0x000                                           // UDS Server Functional Tx ID 5
-  #define _UDS_Fun6_RxID              0x000                                           // UDS Server Functional Rx ID 6
-  #define _UDS_Fun6_TxID              0x000                                           // UDS Server Functional Tx ID 6
-  #define _UDS_Fun7_RxID              0x000                                           // UDS Server Functional Rx ID 7
-  #define _UDS_Fun7_TxID              0x000                                           // UDS Server Functional Tx ID 7
-  #define _UDS_Fun8_RxID              0x000                                           // UDS Server Functional Rx ID 8
-  #define _UDS_Fun8_TxID              0x000                                           // UDS Server Functional Tx ID 8
-
-  #define UDS_FuncID1                 0x01                                            // UDS Allowed Functional Address 1
-  #define UDS_FuncID2                 0x02                                            // UDS Allowed Functional Address 2
-  #define UDS_FuncID3                 0x04                                            // UDS Allowed Functional Address 3
-  #define UDS_FuncID4                 0x08                                            // UDS Allowed Functional Address 4
-  #define UDS_FuncID5                 0x10                                            // UDS Allowed Functional Address 5
-  #define UDS_FuncID6                 0x20                                            // UDS Allowed Functional Address 6
-  #define UDS_FuncID7                 0x40                                            // UDS Allowed Functional Address 7
-  #define UDS_FuncID8                 0x80                                            // UDS Allowed Functional Address 8 
-#endif
-
-#ifndef UDSParameters                                                                 // UDS Server Parameter
-  #define UDSParameters
-  #define UDS_ParaBufferSize          128u                                            // UDS Parameter Message Buffer Size
-  #define UDS_ParaS3Timeout           5000u                                           // UDS Parameter S3 Timeout
-  #define UDS_ParaP3Timeout           5000u                                           // UDS Parameter P3 Timeout
+#ifndef UDSLinkBaudrates                                                              // UDS Link Control Baudrates
+  #define UDSLinkBaudrates
+  #define UDS_LinkCAN125K             0x10                                            // UDS Link Fixed Baudrate CAN 125 KBPS
+  #define UDS_LinkCAN250K             0x11                                            // UDS Link Fixed Baudrate CAN 250 KBPS
+  #define UDS_LinkCAN500K             0x12                                            // UDS Link Fixed Baudrate CAN 500 KBPS
+  #define UDS_LinkCAN1M               0x13                                            // UDS Link Fixed Baudrate CAN 1 MBPS
 #endif
 
 #ifndef UDSSessions                                                                   // UDS Sessions
@@ -119,6 +89,8 @@
   #define UDS_NRC_IK                  0x35                                            // Invalid Key
   #define UDS_NRC_ENA                 0x36                                            // Exceed Number of Attempts
   #define UDS_NRC_RTDNE               0x37                                            // Required Time Delay Not Expired
+  #define UDS_NRC_OVF                 0x58                                            // Ownership Verification Failed
+  #define UDS_NRC_CCF                 0x59                                            // Challenge Calculation Failed
   #define UDS_NRC_UDNA                0x70                                            // Upload Download Not Accept
   #define UDS_NRC_TDS                 0x71                                            // Transfer Data Suspended
   #define UDS_NRC_GPF                 0x72                                            // General Programming Failure
@@ -136,8 +108,6 @@
 
 // UDS Server Details
 typedef struct {
-  uint16_t UDS_RxID;                                                                  // UDS Server Rx CAN ID
-  uint16_t UDS_TxID;                                                                  // UDS Server Tx CAN ID
   uint8_t Session;                                                                    // UDS Server Current Session
   uint8_t Security;                                                                   // UDS Server Current Security
   uint32_t SessionTime;                                                               // UDS Server Session Start Time
@@ -148,19 +118,12 @@ extern UDS_ServerDetails UDS_Server;
 
 // UDS Functional Addressing
 typedef struct {
-  uint8_t AddressingID;                                                               // UDS Current Addressing ID
-  uint8_t FunctionalIDAvailable;                                                      // UDS Number of Functional Addressing Avialble
-  uint16_t PhysicalRxID;                                                              // UDS Physical Rx ID
-  uint16_t PhysicalTxID;                                                              // UDS Physical Tx ID
-  uint16_t FunctionalRxID[8];                                                         // UDS Functional Address Rx IDs
-  uint16_t FunctionalTxID[8];                                                         // UDS Functional Address Tx IDs
+  uint8_t AddressingID;                                                               // UDS Current Addressing ID (IDs In UDS_Config)
 } UDS_AddressingControl;
 extern UDS_AddressingControl UDS_Addressing;
 
 // UDS Server Communication Control
 typedef struct {
-  uint32_t TxTimeout;                                                                 // UDS Tx Disable Timeout
-  uint32_t RxTimeout;                                                                 // UDS Rx Disable Timeout
   uint32_t TxTime;                                                                    // UDS Tx Disable Entry Time
   uint32_t RxTime;                                                                    // UDS Rx Disable Entry Time
   uint8_t TxState;                                                                    // UDS Tx State (Active High)
@@ -185,7 +148,7 @@ typedef struct {
     uint16_t S3;                                                                      // UDS ISO Timer S3_Server_Max
     uint16_t S3Star;                                                                  // UDS ISO Timer S3*_Server_Max
 } UDS_ISOTimeParatemeters;
-extern UDS_ISOTimeParatemeters UDS_ISOTime;
+extern const UDS_ISOTimeParatemeters UDS_ISOTime;
 
 // UDS Security Timeouts
 typedef struct {
@@ -194,7 +157,7 @@ typedef struct {
     uint32_t Programming;                                                             // UDS Server Security Programming Timeout
     uint32_t EOL;                                                                     // UDS Server Security EOL Timeout
 } UDS_ServerSecurityTimeouts;
-extern UDS_ServerSecurityTimeouts UDS_SercurityTimeouts;
+extern const UDS_ServerSecurityTimeouts UDS_SercurityTimeouts;
 
 // UDS Session Timeout 
 typedef struct {
@@ -203,24 +166,47 @@ typedef struct {
     uint32_t Safety;                                                                  // UDS Server Safety Session Timeout
     uint32_t Engineering;                                                             // UDS Server Engineering Session Timeout
 } UDS_ServerSessionTimeouts;
-extern UDS_ServerSessionTimeouts UDS_SessionTimeouts;
+extern const UDS_ServerSessionTimeouts UDS_SessionTimeouts;
+
+// UDS Link Control
+typedef struct {
+    uint32_t ActiveBaud;                                                              // UDS Link Baudrate Currently On Bus
+    uint32_t VerifiedBaud;                                                            // UDS Link Baudrate Verified By Tester
+    uint8_t Transition;                                                               // UDS Link Transition Pending (Active High)
+    uint8_t Revert;                                                                   // UDS Link Back To Default After Response (Active High)
+} UDS_LinkController;
+extern UDS_LinkController UDS_Link;
+
+extern void UDS_SessionTimerUpdate (void);                                            // UDS Hooks Called From DoCAN
+extern void UDS_AuthRxStart (uint16_t _Length);
+extern void UDS_AuthRxUpdate (uint16_t _Received);
 
 
 
 
+#include "UDS_Metrics.h"
+#include "UDS_Trace.h"
+#include "UDS_Deadline.h"
 #include "DoCAN.h"
+#include "UDS_DID.h"
+#include "UDS_ROE.h"
+#include "UDS_Auth.h"
 
 
 extern void UDS_SessionTimeout (uint32_t _Time);
+extern void UDS_SessionDeadline (uint32_t _Time);
 extern uint8_t UDS_GetSession (void);
 extern uint8_t UDS_SetSession (uint8_t _Session, uint32_t _Time);
 extern void UDS_SecurityTimeout (uint32_t _Time);
+extern void UDS_SecurityDeadline (uint32_t _Time);
 extern uint8_t UDS_GetSecurity (void);
 extern uint8_t UDS_SetSecurity (uint8_t _Security, uint32_t _Time);
 
 extern void UDS_VariablesStart (void);
-extern void UDS_SessionTimerUpdate (void);
 extern uint8_t UDS_AddressingCheck (uint16_t _CANID, uint8_t AllowedAddress);
+extern uint32_t UDS_LinkBaudrate (uint8_t _ModeID);
+extern void UDS_LinkRevert (void);
+extern void UDS_SessionExit (void);
 
 extern uint8_t UDS_DiagonosticsSessionControl (void);
 extern uint8_t UDS_ECUReset (void);
@@ -230,11 +216,13 @@ extern uint8_t UDS_CommunicationControl (void);
 extern uint8_t UDS_SecurityAccess (void);
 extern uint8_t UDS_ReadDataIdentifier (void);
 extern uint8_t UDS_WriteDataIdentifier (void);
+extern uint8_t UDS_LinkControl (void);
 
 
 extern void UDS_Application (void);
 extern void UDS_InitApp (void);
 extern void UDS_MainApp (void);
+extern uint32_t UDS_NextDeadline (void);
 
 
 
@@ -260,6 +248,9 @@ extern void UDS_MainApp (void);
 #ifdef _UDSonSPI
   #include "RachanaUDS.h"
   #include "SansaadhanUDS.h"
+#elif defined(_UDSonHost)
+  #include "UDS.h"
+  #include "DoCAN.h"
 #else
   #include "CommonIncs.h"
   #include "UDS.h"
@@ -278,11 +269,18 @@ extern void UDS_MainApp (void);
 
 UDS_ServerDetails UDS_Server = {0};
 UDS_ServerMessageBuffer UDS_Message = {0};
-UDS_ISOTimeParatemeters UDS_ISOTime = {0};
-UDS_ServerSecurityTimeouts UDS_SercurityTimeouts = {0};
-UDS_ServerSessionTimeouts UDS_SessionTimeouts = {0};
+const UDS_ISOTimeParatemeters UDS_ISOTime = {                                         // P2, P2*, P3, P3*, S3, S3*
+    UDS_ParaP2Server, UDS_ParaP2StarServer, 0u, 0u, 0u, 0u
+};
+const UDS_ServerSecurityTimeouts UDS_SercurityTimeouts = {                            // Enhanced, Safety, Programming, EOL
+    UDS_ParaSecurityTimeout, UDS_ParaSecurityTimeout, UDS_ParaSecurityTimeout, UDS_ParaSecurityTimeout
+};
+const UDS_ServerSessionTimeouts UDS_SessionTimeouts = {                               // Extended, Programming, Safety, Engineering
+    UDS_ParaS3Timeout, UDS_ParaS3Timeout, UDS_ParaS3Timeout, UDS_ParaS3Timeout
+};
 UDS_AddressingControl UDS_Addressing = {0};
 UDS_CommunicationController UDS_Communication = {0};
+UDS_LinkController UDS_Link = {0};
 
 
 
@@ -293,6 +291,9 @@ UDS_CommunicationController UDS_Communication = {0};
  *  void UDS_SessionTimerUpdate (void)
  *  void UDS_VariablesStart (void)
  *  uint8_t UDS_AddressingCheck (uint16_t _CANID, uint8_t AllowedAddress)
+ *  uint32_t UDS_LinkBaudrate (uint8_t _ModeID)
+ *  void UDS_LinkRevert (void)
+ *  void UDS_SessionExit (void)
  *  
  *  UDS Server Miscellineous Functions
  */
@@ -301,12 +302,12 @@ void UDS_SessionTimerUpdate (void) {
     uint32_t _Time = TP_Clock();
     UDS_Server.SessionTime = _Time;
     UDS_Server.SecurityTime = _Time;
+    UDS_SessionDeadline(_Time);                                                       // S3 Restarted
+    UDS_SecurityDeadline(_Time);                                                      // Security Timeout Restarted
 }
 /* ---------------------------------------------------------------------------------------------------- */
 void UDS_VariablesStart (void) {
     // Global Variable : UDS_Server
-    UDS_Server.UDS_RxID = _UDS_RxID;                                                  // UDS ECU RX CAN ID
-    UDS_Server.UDS_TxID = _UDS_TxID;                                                  // UDS ECU TX CAN ID
     UDS_Server.Session = UDS_Default;                                                 // ECU Default Session
     UDS_Server.Security = UDS_SecurityNone;                                           // ECU Security Level 0
     UDS_Server.SessionTime = 0u;                                                      // ECU Session Entry Time
@@ -320,62 +321,31 @@ void UDS_VariablesStart (void) {
       UDS_Message.Data[i] = 0u;                                                       // UDS Message Data
     }
 
-    // Global Variable : UDS_Communication
-    UDS_Communication.TxTimeout = 600000;                                             // UDS Tx Disable Timeout
-    UDS_Communication.RxTimeout = 600000;                                             // UDS Rx Disable Timeout
-    UDS_Communication.TxTime = 0u;                                                    // UDS Tx Disable Entry Time
-    UDS_Communication.RxTime = 0u;                                                    // UDS Rx Disable Entry Time
-    UDS_Communication.TxState = 1u;                                                   // UDS Tx State
-    UDS_Communication.RxState = 1u;                                                   // UDS Rx State
-
-    // Global Variable : UDS_ISOTime
-    UDS_ISOTime.P2 = 50u;                                                             // UDS ISO Timer P2_Server_Max
-    UDS_ISOTime.P2Star = 5000u;                                                       // UDS ISO Timer P2*_Server_Max
-    UDS_ISOTime.P3 = 0u;                                                              // UDS ISO Timer P3_Server_Max
-    UDS_ISOTime.P3Star = 0u;                                                          // UDS ISO Timer P3*_Server_Max
-    UDS_ISOTime.S3 = 0u;                                                              // UDS ISO Timer S3_Server_Max
-    UDS_ISOTime.S3Star = 0u;                                                          // UDS ISO Timer S3*_Server_Max
-
-    // Global Variable : UDS_SercurityTimeouts
-    UDS_SercurityTimeouts.Enhanced = 5000u;                                           // UDS Server Security Enhanced Timeout
-    UDS_SercurityTimeouts.EOL = 5000u;                                                // UDS Server Security EOL Timeout
-    UDS_SercurityTimeouts.Programming = 5000u;                                        // UDS Server Security Programming Timeout
-    UDS_SercurityTimeouts.Safety = 5000u;                                             // UDS Server Security Safety Timeout
-
-    // Global Variable : UDS_SessionTimeouts
-    UDS_SessionTimeouts.Extended = 5000u;                                             // UDS Server Extented Session Timeout
-    UDS_SessionTimeouts.Programming = 5000u;                                          // UDS Server Programming Session Timeout
-    UDS_SessionTimeouts.Safety = 5000u;                                               // UDS Server Safety Session Timeout
-    UDS_SessionTimeouts.Engineering = 5000u;                                          // UDS Server Engineering Session Timeout
-
     // Global Variable : UDS_Addressing
     UDS_Addressing.AddressingID = 0u;                                                 // UDS Addressing ID For Functions To Use
-    UDS_Addressing.FunctionalIDAvailable 2;                                           // UDS Functional Addresses Available
-    UDS_Addressing.PhysicalRxID = _UDS_RxID;                                          // UDS Physical Rx CAN ID
-    UDS_Addressing.PhysicalTxID = _UDS_TxID;                                          // UDS Physical Tx CAN ID
-    UDS_Addressing.FunctionalRxID[0] = _UDS_Fun1_RxID;                                // UDS Functional Rx CAN ID Group 1
-    UDS_Addressing.FunctionalTxID[0] = _UDS_Fun1_TxID;                                // UDS Functional Tx CAN ID Group 1
-    UDS_Addressing.FunctionalRxID[1] = _UDS_Fun2_RxID;                                // UDS Functional Rx CAN ID Group 2
-    UDS_Addressing.FunctionalTxID[1] = _UDS_Fun2_TxID;                                // UDS Functional Tx CAN ID Group 2
-    
+
     // Global Variable : UDS_Communication
-    UDS_Communication.RxTimeout = 600000u;                                            // UDS Rx Disable Timeout
-    UDS_Communication.TxTimeout = 600000u;                                            // UDS Tx Disable Timeout
     UDS_Communication.RxTime = 0u;                                                    // UDS Rx Entry Time
     UDS_Communication.TxTime = 0u;                                                    // UDS Tx Entry Time
     UDS_Communication.RxState = 1u;                                                   // UDS Rx Communication State (Active High)
     UDS_Communication.TxState = 1u;                                                   // UDS Tx Communication State (Active High)
+
+    // Global Variable : UDS_Link
+    UDS_Link.ActiveBaud = UDS_LinkDefaultBaud;                                        // UDS Link Active Baudrate
+    UDS_Link.VerifiedBaud = 0u;                                                       // UDS Link Nothing Verified
+    UDS_Link.Transition = 0u;                                                         // UDS Link No Transition Pending
+    UDS_Link.Revert = 0u;                                                             // UDS Link No Revert Pending
 }
 /* ---------------------------------------------------------------------------------------------------- */
 uint8_t UDS_AddressingCheck (uint16_t _CANID, uint8_t AllowedAddress) {
-    if (UDS_Addressing.PhysicalRxID == _CANID) {                                      // UDS Physical Address Check
+    if (_UDS_RxID == _CANID) {                                                        // UDS Physical Address Check
       UDS_Addressing.AddressingID = 0;                                                // UDS Addressing ID Loaded
       return 0;
     }
 
     uint8_t i = 0;
-    while (i < UDS_Addressing.FunctionalIDAvailable) {                                // UDS Functional Address Check Loop
-      if (UDS_Addressing.FunctionalRxID[i] == _CANID) {                               // UDS Functional Address Check
+    while (i < UDS_FunctionalCount) {                                                 // UDS Functional Address Check Loop
+      if (UDS_FunctionalRxID[i] == _CANID) {                                          // UDS Functional Address Check
         uint8_t C = 1 << i;
         if ((C & AllowedAddress) == C) {                                              // UDS Functional Address Allowed
           UDS_Addressing.AddressingID = i + 1;                                        // UDS Addressing ID Loaded
@@ -388,6 +358,31 @@ uint8_t UDS_AddressingCheck (uint16_t _CANID, uint8_t AllowedAddress) {
     }
     return 1;
 }
+/* ---------------------------------------------------------------------------------------------------- */
+uint32_t UDS_LinkBaudrate (uint8_t _ModeID) {
+    switch (_ModeID) {
+        case UDS_LinkCAN125K : return 125000u;                                        // Fixed Baudrate : CAN 125 KBPS
+        case UDS_LinkCAN250K : return 250000u;                                        // Fixed Baudrate : CAN 250 KBPS
+        case UDS_LinkCAN500K : return 500000u;                                        // Fixed Baudrate : CAN 500 KBPS
+        case UDS_LinkCAN1M : return 1000000u;                                         // Fixed Baudrate : CAN 1 MBPS
+        default : return 0u;                                                          // Baudrate Not Supported
+    }
+}
+/* ---------------------------------------------------------------------------------------------------- */
+void UDS_LinkRevert (void) {
+    UDS_Link.VerifiedBaud = 0u;                                                       // Dropping Any Verified Baudrate
+    UDS_Link.Transition = 0u;                                                         // Dropping Any Pending Transition
+    if (UDS_Link.ActiveBaud != UDS_LinkDefaultBaud) {                                 // Checking If Link Was Switched
+        UDS_Link.Revert = 1u;                                                         // Default Baudrate Once Response Is Sent
+    }
+}
+/* ---------------------------------------------------------------------------------------------------- */
+void UDS_SessionExit (void) {
+    UDS_LinkRevert();                                                                 // Default Baudrate After Response
+    UDS_IOControlRelease();                                                           // Signals Back To Application
+    UDS_ROERelease();                                                                 // Non Stored Events Cleared
+    UDS_AuthRelease();                                                                // Authentication And Key Schedule Dropped
+}
 /* ==================================================================================================== */
 
 
@@ -396,53 +391,41 @@ uint8_t UDS_AddressingCheck (uint16_t _CANID, uint8_t AllowedAddress) {
  *  Session Control
  *
  *  void UDS_SessionTimeout (uint32_t _Time)
+ *  void UDS_SessionDeadline (uint32_t _Time)
  *  uint8_t UDS_GetSession (void);
  *  uint8_t UDS_SetSession (uint8_t _Session, uint32_t _Time)
  *
  *  UDS Server Session Timeout, Get & Set Check & Implementation
+ *  S3 Is A UDS_Deadline Slot, Armed On Every Session Change Or Timer Reset And Only Checked Once Due
  */
 /* ---------------------------------------------------------------------------------------------------- */
 void UDS_SessionTimeout (uint32_t _Time) {
+    if (!UDS_DeadlineDue(UDS_DeadlineS3, _Time)) {                                    // S3 Not Expired Or Default Session
+      return;
+    }
+    UDS_Server.Session = UDS_Default;                                                 // Resetting To Default
+    UDS_Server.Security = UDS_SecurityNone;                                           // Resetting The Security
+    UDS_DeadlineCancel(UDS_DeadlineS3);                                               // Default Session Never Times Out
+    UDS_DeadlineCancel(UDS_DeadlineSecurity);                                         // Nothing Unlocked
+    UDS_SessionExit();                                                                // Releasing Session Resources
+    if (UDS_Link.Revert) {                                                            // No Response To Wait For
+        TP_LinkRevert();                                                              // Back To Default Baudrate Now
+    }
+}
+/* ---------------------------------------------------------------------------------------------------- */
+void UDS_SessionDeadline (uint32_t _Time) {
+    uint32_t _Limit = 0u;
     switch (UDS_Server.Session) {
-        case UDS_Default : {                                                          // Default Session Timeout
-            UDS_Server.Session = UDS_Default;                                         // Retransitioning To Default
-            break;
-        }
-        case UDS_Extended : {                                                         // Extented Session Timeout
-            if ((_Time - UDS_Server.SessionTime) > UDS_SessionTimeouts.Extended) {    // Checking For Timeout
-                UDS_Server.Session = UDS_Default;                                     // Resetting To Default
-                UDS_Server.Security = UDS_SecurityNone;                               // Resetting The Security
-            }
-            break;
-        }
-        case UDS_Programming : {                                                      // Programming Session Timeout
-            if ((_Time - UDS_Server.SessionTime) > UDS_SessionTimeouts.Programming) { // Checking For Timeout
-                UDS_Server.Session = UDS_Default;                                     // Resetting To Default
-                UDS_Server.Security = UDS_SecurityNone;                               // Resetting The Security
-            }
-            break;
-        }
-        case UDS_Safety : {                                                           // Safety Session Timeout
-            if ((_Time - UDS_Server.SessionTime) > UDS_SessionTimeouts.Safety) {      // Checking For Timeout
-                UDS_Server.Session = UDS_Default;                                     // Resetting To Default
-                UDS_Server.Security = UDS_SecurityNone;                               // Resetting The Security
-            }
-            break;
-        }
-        case UDS_Engineering : {                                                      // Engineering Session
-            if ((_Time - UDS_Server.SessionTime) > UDS_SessionTimeouts.Engineering) { // Checking For Timeout
-                UDS_Server.Session = UDS_Default;                                     // Resetting To Default
-                UDS_Server.Security = UDS_SecurityNone;                               // Resetting The Security
-            }
-            break;
-        }
-
-        default : {                                                                   // Rare Case
-            UDS_Server.Session = UDS_Default;                                         // Resetting To Default
-            UDS_Server.Security = UDS_SecurityNone;                                   // Resetting The Security
-            break;
+        case UDS_Extended : _Limit = UDS_SessionTimeouts.Extended; break;             // Extended Session Timeout
+        case UDS_Programming : _Limit = UDS_SessionTimeouts.Programming; break;       // Programming Session Timeout
+        case UDS_Safety : _Limit = UDS_SessionTimeouts.Safety; break;                 // Safety Session Timeout
+        case UDS_Engineering : _Limit = UDS_SessionTimeouts.Engineering; break;       // Engineering Session Timeout
+        default : {                                                                   // Default Session Never Times Out
+            UDS_DeadlineCancel(UDS_DeadlineS3);
+            return;
         }
     }
+    UDS_DeadlineArm(UDS_DeadlineS3, _Time, _Limit);                                   // S3 Armed From _Time
 }
 /* ---------------------------------------------------------------------------------------------------- */
 uint8_t UDS_GetSession (void) {
@@ -454,6 +437,7 @@ uint8_t UDS_SetSession (uint8_t _Session, uint32_t _Time) {
         case UDS_Default : {                                                          // Default Session
             UDS_Server.Session = UDS_Default;                                         // Default Session Set
             UDS_Server.Security = UDS_SecurityNone;                                   // Security Reset
+            UDS_SessionExit();                                                        // Session Resources Released
             UDS_Server.SessionTime = _Time;                                           // Session Timer Reset
             UDS_Server.SecurityTime = _Time;                                          // Security Timer Reset
             break;
@@ -487,6 +471,8 @@ uint8_t UDS_SetSession (uint8_t _Session, uint32_t _Time) {
             break;
         }
     }
+    UDS_SessionDeadline(_Time);                                                       // S3 Armed For New Session
+    UDS_SecurityDeadline(_Time);                                                      // Security Reset, Timer Off
     return UDS_Server.Session;
 }
 /* ====================================================================================================*/
@@ -496,49 +482,35 @@ uint8_t UDS_SetSession (uint8_t _Session, uint32_t _Time) {
 /*
  *  Security Control
  *
- *  void UDS_SessionTimeout (uint32_t _Time)
- *  uint8_t UDS_GetSession (void);
- *  uint8_t UDSSetSession (uint8_t _Session, uint32_t _Time)
+ *  void UDS_SecurityTimeout (uint32_t _Time)
+ *  void UDS_SecurityDeadline (uint32_t _Time)
+ *  uint8_t UDS_GetSecurity (void)
+ *  uint8_t UDS_SetSecurity (uint8_t _Security, uint32_t _Time)
  *
  *  UDS Server Security Timeout, Get & Set Check & Implementation
  */
 /* ---------------------------------------------------------------------------------------------------- */
 void UDS_SecurityTimeout (uint32_t _Time) {
+    if (!UDS_DeadlineDue(UDS_DeadlineSecurity, _Time)) {                              // Not Expired Or Nothing Unlocked
+      return;
+    }
+    UDS_Server.Security = UDS_SecurityNone;                                           // Resetting Security
+    UDS_DeadlineCancel(UDS_DeadlineSecurity);
+}
+/* ---------------------------------------------------------------------------------------------------- */
+void UDS_SecurityDeadline (uint32_t _Time) {
+    uint32_t _Limit = 0u;
     switch (UDS_Server.Security) {
-        case UDS_SecurityNone : {                                                     // Security None Timeout
-          UDS_Server.Security = UDS_SecurityNone;                                     // Resetting Security
-          break;
-        }
-        case UDS_SecurityEnhanced : {                                                 // Security Enhanced Timeout
-          if ((_Time - UDS_Server.SecurityTime) > UDS_SercurityTimeouts.Enhanced) {   // Security Timeout Check
-                UDS_Server.Security = UDS_SecurityNone;                               // Resetting Security
-          }
-          break;
-        }
-        case UDS_SecuritySafety : {                                                   // Security Safty Timeout
-          if ((_Time - UDS_Server.SecurityTime) > UDS_SercurityTimeouts.Safety) {     // Security Timeout Check
-                UDS_Server.Security = UDS_SecurityNone;                               // Resetting Security
-          }
-          break;
-        }
-        case UDS_SecurityProgramming : {                                              // Security Programming Timeout
-          if ((_Time - UDS_Server.SecurityTime) > UDS_SercurityTimeouts.Programming) {// Security Timeout Check
-                UDS_Server.Security = UDS_SecurityNone;                               // Resetting Security
-          }
-          break;
-        }
-        case UDS_SecurityEOL : {                                                      // Security EOL Timeout
-          if ((_Time - UDS_Server.SecurityTime) > UDS_SercurityTimeouts.EOL) {        // Security Timeout Check
-                UDS_Server.Security = UDS_SecurityNone;                               // Resetting Security
-          }
-          break;
-        }
-
-        default : {                                                                   // Rare Case
-            UDS_Server.Security = UDS_SecurityNone;                                   // Resetting Security
-            break;
+        case UDS_SecurityEnhanced : _Limit = UDS_SercurityTimeouts.Enhanced; break;   // Security Enhanced Timeout
+        case UDS_SecuritySafety : _Limit = UDS_SercurityTimeouts.Safety; break;       // Security Safety Timeout
+        case UDS_SecurityProgramming : _Limit = UDS_SercurityTimeouts.Programming; break;
+        case UDS_SecurityEOL : _Limit = UDS_SercurityTimeouts.EOL; break;             // Security EOL Timeout
+        default : {                                                                   // Security None Never Times Out
+            UDS_DeadlineCancel(UDS_DeadlineSecurity);
+            return;
         }
     }
+    UDS_DeadlineArm(UDS_DeadlineSecurity, _Time, _Limit);                             // Security Timeout Armed From _Time
 }
 /* ---------------------------------------------------------------------------------------------------- */
 uint8_t UDS_GetSecurity (void) {
@@ -578,6 +550,7 @@ uint8_t UDS_SetSecurity (uint8_t _Security, uint32_t _Time) {
             break;
         }
     }
+    UDS_SecurityDeadline(_Time);                                                      // Security Timeout Armed For New Level
     return UDS_Server.Security;
 }
 /* ==================================================================================================== */
@@ -661,6 +634,9 @@ uint8_t UDS_DiagonosticsSessionControl (void) {
     }
 
     if (_Suppress) {                                                                  // Checking if Positive Response is Suppressed
+        if (UDS_Link.Revert) {                                                        // Nothing To Wait For On The Bus
+            TP_LinkRevert();                                                          // Back To Default Baudrate Now
+        }
         UDS_Server.Status = UDS_ServerFree;                                           // UDS Server Status Set To Free
         return 1;                                                                     // Returning All OK
     } else {                                                                          // Frame Building
@@ -696,26 +672,7 @@ uint8_t UDS_ECUReset (void) {
     uint8_t _Suppress = (UDS_Message.Data[1] & 0x80) ? 1 : 0;                         // Checking is Positive Response Is Suppressed
     uint8_t _SF = UDS_Message.Data[1] & 0x7F;                                         // Extracting Sub Function
 
-    if ((_SID != 0x01) && (_SID != 0x02) && (_SID != 0x03)) {                         // Checking if Sub Function is Implemented
-        TP_SendNegativeResponse(UDS_NRC_SFNS, _SID, 'P');                             // NRC : Sub Function Not Supported
-        UDS_Server.Status = UDS_ServerFree;                                           // UDS Server Status Set To Free
-        return 0;
-    }
-
-    if (!(_Suppress)) {                                                               // Checking if Positive Response is Suppressed
-      TP_MessageTX.CANID.Raw = UDS_Server.UDS_TxID;                                   // TP Direct Loading CANID 
-      TP_MessageTX.Data[0] = 0x51;                                                    // TP Direct Loading Positive Response
-      TP_MessageTX.Data[1] = _SID;                                                    // TP Direct Loading SID
-      TP_MessageTX.Data[2] = TP_CANPadding;                                           // TP Direct Loading Padding
-      TP_MessageTX.Data[3] = TP_CANPadding;                                           // TP Direct Loading Padding
-      TP_MessageTX.Data[4] = TP_CANPadding;                                           // TP Direct Loading Padding
-      TP_MessageTX.Data[5] = TP_CANPadding;                                           // TP Direct Loading Padding
-      TP_MessageTX.Data[6] = TP_CANPadding;                                           // TP Direct Loading Padding
-      TP_MessageTX.Data[7] = TP_CANPadding;                                           // TP Direct Loading Padding
-      TP_SendDataFrameCAN();                                                          // Sending Response Frame
-    }
-
-    switch (_SF) {
+    switch (_SF) {                                                                    // Sub Function Validated Before Any Response
       case 0x01 : {                                                                   // Hard Reset
         // HardReset() Function
         break;
@@ -734,8 +691,21 @@ uint8_t UDS_ECUReset (void) {
         return 0;
       }
     }
-    UDS_Server.Status = UDS_ServerFree;                                               // UDS Server Status Set To Free
-    return 1;
+    UDS_SetSession(UDS_Default, TP_Clock());                                          // Reset Server Starts In Default Session
+
+    if (_Suppress) {                                                                  // Checking if Positive Response is Suppressed
+        if (UDS_Link.Revert) {                                                        // Nothing To Wait For On The Bus
+            TP_LinkRevert();                                                          // Back To Default Baudrate Now
+        }
+        UDS_Server.Status = UDS_ServerFree;                                           // UDS Server Status Set To Free
+        return 1;                                                                     // Returning All OK
+    } else {                                                                          // Frame Building
+      UDS_Message.Length = 2;                                                         // TML Suggested
+      UDS_Message.Data[0] = 0x51;                                                     // Positive Response SID
+      UDS_Message.Data[1] = _SF;                                                      // Echo Sub Function
+      TP_TxFrameUSDT('P');                                                            // Sending Response Frame
+      return 1;
+    }
 }
 /* ==================================================================================================== */
 
@@ -753,8 +723,6 @@ uint8_t UDS_TesterPresent (void) {
     uint8_t _SID = UDS_Message.Data[0];                                               // Extracting SID
     uint8_t _Suppress = (UDS_Message.Data[1] & 0x80) ? 1 : 0;                         // Checking is Positive Response Is Suppressed
     uint8_t _SF = UDS_Message.Data[1] & 0x7F;                                         // Extracting Sub Function
-    uint32_t _Time = TP_Clock();                                                      // Loaded Current Time
-    uint8_t _CurrentSession = UDS_GetSession();                                       // UDS Get Active Current Session
     
     if (_SF != 0x00) {                                                                // Checking Subfunction
         TP_SendNegativeResponse(UDS_NRC_SFNS, _SID, 'P');                             // NRC : Sub Function Not Supported
@@ -782,6 +750,101 @@ uint8_t UDS_TesterPresent (void) {
 /* ==================================================================================================== */
 
 
+/* ==================================================================================================== */
+/*
+ *  UDS Link Control
+ *
+ *  uint8_t UDS_LinkControl (void)
+ *
+ *  UDS Server Service 0x87 : Link Control
+ *  Verification Only Records The Baudrate, The CAN Controller Is Reprogrammed By TP_TxDoCAN Once
+ *  The Positive Response To Transition Mode Has Left The Bus (Or At Once When It Is Suppressed)
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t UDS_LinkControl (void) {
+    uint8_t _SID = UDS_Message.Data[0];                                               // Extracting SID
+    uint8_t _Suppress = (UDS_Message.Data[1] & 0x80) ? 1 : 0;                         // Checking is Positive Response Is Suppressed
+    uint8_t _SF = UDS_Message.Data[1] & 0x7F;                                         // Extracting Sub Function
+    uint32_t _Baud = 0;
+
+    switch (_SF) {
+      case 0x01 : {                                                                   // Verify Mode Transition With Fixed Parameter
+        if (UDS_Message.Length != 3) {                                                // Expected Payload Length Check
+            TP_SendNegativeResponse(UDS_NRC_IMLIF, _SID, 'P');                        // NRC : Incorrect Message Length or Invalid Format
+            UDS_Server.Status = UDS_ServerFree;                                       // UDS Server Status Set To Free
+            return 0;
+        }
+        _Baud = UDS_LinkBaudrate(UDS_Message.Data[2]);                                // Link Control Mode Identifier To Baudrate
+        break;
+      }
+      case 0x02 : {                                                                   // Verify Mode Transition With Specific Parameter
+        if (UDS_Message.Length != 5) {                                                // Expected Payload Length Check
+            TP_SendNegativeResponse(UDS_NRC_IMLIF, _SID, 'P');                        // NRC : Incorrect Message Length or Invalid Format
+            UDS_Server.Status = UDS_ServerFree;                                       // UDS Server Status Set To Free
+            return 0;
+        }
+        Number32Bit Record;
+        Record.Raw = 0;
+        Record.Byte.B2 = UDS_Message.Data[2];                                         // Link Record High Byte
+        Record.Byte.B1 = UDS_Message.Data[3];                                         // Link Record Middle Byte
+        Record.Byte.B0 = UDS_Message.Data[4];                                         // Link Record Low Byte
+        uint8_t i = UDS_LinkCAN125K;
+        while (i <= UDS_LinkCAN1M) {                                                  // Specific Baudrate Must Be One The Controller Can Run
+          if (UDS_LinkBaudrate(i) == Record.Raw) {
+            _Baud = Record.Raw;
+            break;
+          }
+          i++;
+        }
+        break;
+      }
+      case 0x03 : {                                                                   // Transition Mode
+        if (UDS_Message.Length != 2) {                                                // Expected Payload Length Check
+            TP_SendNegativeResponse(UDS_NRC_IMLIF, _SID, 'P');                        // NRC : Incorrect Message Length or Invalid Format
+            UDS_Server.Status = UDS_ServerFree;                                       // UDS Server Status Set To Free
+            return 0;
+        }
+        if (UDS_Link.VerifiedBaud == 0) {                                             // Transition Without Verification
+            TP_SendNegativeResponse(UDS_NRC_RSE, _SID, 'P');                          // NRC : Request Sequence Error
+            UDS_Server.Status = UDS_ServerFree;                                       // UDS Server Status Set To Free
+            return 0;
+        }
+        UDS_Link.Transition = 1u;                                                     // Transition Armed
+        break;
+      }
+      default : {
+        TP_SendNegativeResponse(UDS_NRC_SFNS, _SID, 'P');                             // NRC : Sub Function Not Supported
+        UDS_Server.Status = UDS_ServerFree;                                           // UDS Server Status Set To Free
+        return 0;
+      }
+    }
+
+    if (_SF != 0x03) {                                                                // Verification Sub Functions
+      if (_Baud == 0) {                                                               // Baudrate Not Supported
+          TP_SendNegativeResponse(UDS_NRC_ROOR, _SID, 'P');                           // NRC : Request Out Of Range
+          UDS_Server.Status = UDS_ServerFree;                                         // UDS Server Status Set To Free
+          return 0;
+      }
+      UDS_Link.VerifiedBaud = _Baud;                                                  // Baudrate Verified
+    }
+
+    if (_Suppress) {                                                                  // Checking if Positive Response is Suppressed
+        if (UDS_Link.Transition) {                                                    // Nothing To Wait For On The Bus
+            TP_LinkTransition();                                                      // Switching Baudrate Now
+        }
+        UDS_Server.Status = UDS_ServerFree;                                           // UDS Server Status Set To Free
+        return 1;                                                                     // Returning All OK
+    } else {                                                                          // Frame Building
+      UDS_Message.Length = 2;                                                         // TML Suggested
+      UDS_Message.Data[0] = 0xC7;                                                     // Positive Response SID
+      UDS_Message.Data[1] = _SF;                                                      // Echo Sub Function
+      TP_TxFrameUSDT('P');                                                            // Sending Response Frame
+      return 1;
+    }
+}
+/* ==================================================================================================== */
+
+
 
 
 
@@ -928,6 +991,280 @@ void UDS_Application (void) {
 
 
 
+      // UDS Service : Read Data By Identifier
+      case 0x22 : {                                                       // Read Data By Identifier Service
+        const uint8_t AllowedSecurity = UDS_SecurityNone | UDS_SecurityEnhanced | UDS_SecuritySafety | UDS_SecurityProgramming | UDS_SecurityEOL;
+        const uint8_t AllowedSession = UDS_Default | UDS_Extended | UDS_Programming | UDS_Safety | UDS_Engineering;
+        const uint8_t AllowedAddressing = UDS_FuncID1 | UDS_FuncID2;
+
+        if (UDS_AddressingCheck(UDS_Message.CANID, AllowedAddressing)) {  // UDS Service Addressing Check
+            UDS_Server.Status = UDS_ServerFree;                           // UDS Server Status Set To Free
+            return;
+        }
+
+        if (UDS_Message.Length < 3) {                                     // Minimum Payload Length Check
+            TP_SendNegativeResponse(UDS_NRC_IMLIF, _SID, 'P');            // NRC : Incorrect Message Length or Invalid Format
+            UDS_Server.Status = UDS_ServerFree;                           // UDS Server Status Set To Free
+            return;
+        }
+
+        uint8_t CheckSecurity = UDS_GetSecurity();
+        uint8_t CheckSession = UDS_GetSession();
+
+        if ((CheckSession & AllowedSession) != CheckSession) {            // Checking Session
+            TP_SendNegativeResponse(UDS_NRC_SNSIAS, _SID, 'P');           // NRC : Service Not Supported In Active Session
+            UDS_Server.Status = UDS_ServerFree;                           // UDS Server Status Set To Free
+            return;
+        }
+        if ((CheckSecurity & AllowedSecurity) != CheckSecurity) {         // Checking Security Level
+            TP_SendNegativeResponse(UDS_NRC_SAD, _SID, 'P');              // NRC : Security Access Denied
+            UDS_Server.Status = UDS_ServerFree;                           // UDS Server Status Set To Free
+            return;
+        }
+
+        uint8_t _Report = 0;
+        _Report = UDS_ReadDataIdentifier();                               // Call Function For : Read Data By Identifier
+        if (_Report) {                                                    // Check if Valid Service Executed
+          UDS_SessionTimerUpdate();                                       // Valid Service, Reseting Server Timer
+        }
+        return;
+      }
+
+      // UDS Service : Write Data By Identifier
+      case 0x2E : {                                                       // Write Data By Identifier Service
+        const uint8_t AllowedSecurity = UDS_SecurityNone | UDS_SecurityEnhanced | UDS_SecuritySafety | UDS_SecurityProgramming | UDS_SecurityEOL;
+        const uint8_t AllowedSession = UDS_Extended | UDS_Safety | UDS_Engineering;
+        const uint8_t AllowedAddressing = 0;
+
+        if (UDS_AddressingCheck(UDS_Message.CANID, AllowedAddressing)) {  // UDS Service Addressing Check
+            UDS_Server.Status = UDS_ServerFree;                           // UDS Server Status Set To Free
+            return;
+        }
+
+        if (UDS_Message.Length < 4) {                                     // Minimum Payload Length Check
+            TP_SendNegativeResponse(UDS_NRC_IMLIF, _SID, 'P');            // NRC : Incorrect Message Length or Invalid Format
+            UDS_Server.Status = UDS_ServerFree;                           // UDS Server Status Set To Free
+            return;
+        }
+
+        uint8_t CheckSecurity = UDS_GetSecurity();
+        uint8_t CheckSession = UDS_GetSession();
+
+        if ((CheckSession & AllowedSession) != CheckSession) {            // Checking Session
+            TP_SendNegativeResponse(UDS_NRC_SNSIAS, _SID, 'P');           // NRC : Service Not Supported In Active Session
+            UDS_Server.Status = UDS_ServerFree;                           // UDS Server Status Set To Free
+            return;
+        }
+        if ((CheckSecurity & AllowedSecurity) != CheckSecurity) {         // Checking Security Level
+            TP_SendNegativeResponse(UDS_NRC_SAD, _SID, 'P');              // NRC : Security Access Denied
+            UDS_Server.Status = UDS_ServerFree;                           // UDS Server Status Set To Free
+            return;
+        }
+
+        uint8_t _Report = 0;
+        _Report = UDS_WriteDataIdentifier();                              // Call Function For : Write Data By Identifier
+        if (_Report) {                                                    // Check if Valid Service Executed
+          UDS_SessionTimerUpdate();                                       // Valid Service, Reseting Server Timer
+        }
+        return;
+      }
+
+      // UDS Service : Response On Event
+      case 0x86 : {                                                       // Response On Event Service
+        const uint8_t AllowedSecurity = UDS_SecurityNone | UDS_SecurityEnhanced | UDS_SecuritySafety | UDS_SecurityProgramming | UDS_SecurityEOL;
+        const uint8_t AllowedSession = UDS_Default | UDS_Extended | UDS_Programming | UDS_Safety | UDS_Engineering;
+        const uint8_t AllowedAddressing = UDS_FuncID1 | UDS_FuncID2;
+
+        if (UDS_AddressingCheck(UDS_Message.CANID, AllowedAddressing)) {  // UDS Service Addressing Check
+            UDS_Server.Status = UDS_ServerFree;                           // UDS Server Status Set To Free
+            return;
+        }
+
+        if (UDS_Message.Length < 2) {                                     // Minimum Payload Length Check
+            TP_SendNegativeResponse(UDS_NRC_IMLIF, _SID, 'P');            // NRC : Incorrect Message Length or Invalid Format
+            UDS_Server.Status = UDS_ServerFree;                           // UDS Server Status Set To Free
+            return;
+        }
+
+        uint8_t CheckSecurity = UDS_GetSecurity();
+        uint8_t CheckSession = UDS_GetSession();
+
+        if ((CheckSession & AllowedSession) != CheckSession) {            // Checking Session
+            TP_SendNegativeResponse(UDS_NRC_SNSIAS, _SID, 'P');           // NRC : Service Not Supported In Active Session
+            UDS_Server.Status = UDS_ServerFree;                           // UDS Server Status Set To Free
+            return;
+        }
+        if ((CheckSecurity & AllowedSecurity) != CheckSecurity) {         // Checking Security Level
+            TP_SendNegativeResponse(UDS_NRC_SAD, _SID, 'P');              // NRC : Security Access Denied
+            UDS_Server.Status = UDS_ServerFree;                           // UDS Server Status Set To Free
+            return;
+        }
+
+        uint8_t _Report = 0;
+        _Report = UDS_ResponseOnEvent();                                  // Call Function For : Response On Event
+        if (_Report) {                                                    // Check if Valid Service Executed
+          UDS_SessionTimerUpdate();                                       // Valid Service, Reseting Server Timer
+        }
+        return;
+      }
+
+      // UDS Service : Authentication
+      case 0x29 : {                                                       // Authentication Service
+        const uint8_t AllowedSecurity = UDS_SecurityNone | UDS_SecurityEnhanced | UDS_SecuritySafety | UDS_SecurityProgramming | UDS_SecurityEOL;
+        const uint8_t AllowedSession = UDS_Default | UDS_Extended | UDS_Programming | UDS_Safety | UDS_Engineering;
+        const uint8_t AllowedAddressing = 0;
+
+        if (UDS_AddressingCheck(UDS_Message.CANID, AllowedAddressing)) {  // UDS Service Addressing Check
+            UDS_Server.Status = UDS_ServerFree;                           // UDS Server Status Set To Free
+            return;
+        }
+
+        if (UDS_Message.Length < 2) {                                     // Minimum Payload Length Check
+            TP_SendNegativeResponse(UDS_NRC_IMLIF, _SID, 'P');            // NRC : Incorrect Message Length or Invalid Format
+            UDS_Server.Status = UDS_ServerFree;                           // UDS Server Status Set To Free
+            return;
+        }
+
+        uint8_t CheckSecurity = UDS_GetSecurity();
+        uint8_t CheckSession = UDS_GetSession();
+
+        if ((CheckSession & AllowedSession) != CheckSession) {            // Checking Session
+            TP_SendNegativeResponse(UDS_NRC_SNSIAS, _SID, 'P');           // NRC : Service Not Supported In Active Session
+            UDS_Server.Status = UDS_ServerFree;                           // UDS Server Status Set To Free
+            return;
+        }
+        if ((CheckSecurity & AllowedSecurity) != CheckSecurity) {         // Checking Security Level
+            TP_SendNegativeResponse(UDS_NRC_SAD, _SID, 'P');              // NRC : Security Access Denied
+            UDS_Server.Status = UDS_ServerFree;                           // UDS Server Status Set To Free
+            return;
+        }
+
+        uint8_t _Report = 0;
+        _Report = UDS_Authentication();                                   // Call Function For : Authentication
+        if (_Report) {                                                    // Check if Valid Service Executed
+          UDS_SessionTimerUpdate();                                       // Valid Service, Reseting Server Timer
+        }
+        return;
+      }
+
+      // UDS Service : Secured Data Transmission
+      case 0x84 : {                                                       // Secured Data Transmission Service
+        const uint8_t AllowedSecurity = UDS_SecurityNone | UDS_SecurityEnhanced | UDS_SecuritySafety | UDS_SecurityProgramming | UDS_SecurityEOL;
+        const uint8_t AllowedSession = UDS_Default | UDS_Extended | UDS_Programming | UDS_Safety | UDS_Engineering;
+        const uint8_t AllowedAddressing = 0;
+
+        if (UDS_AddressingCheck(UDS_Message.CANID, AllowedAddressing)) {  // UDS Service Addressing Check
+            UDS_Server.Status = UDS_ServerFree;                           // UDS Server Status Set To Free
+            return;
+        }
+
+        if (UDS_Message.Length < (UDS_SecuredHeaderLength + UDS_SecuredMACLength + 1)) { // Minimum Payload Length Check
+            TP_SendNegativeResponse(UDS_NRC_IMLIF, _SID, 'P');            // NRC : Incorrect Message Length or Invalid Format
+            UDS_Server.Status = UDS_ServerFree;                           // UDS Server Status Set To Free
+            return;
+        }
+
+        uint8_t CheckSecurity = UDS_GetSecurity();
+        uint8_t CheckSession = UDS_GetSession();
+
+        if ((CheckSession & AllowedSession) != CheckSession) {            // Checking Session
+            TP_SendNegativeResponse(UDS_NRC_SNSIAS, _SID, 'P');           // NRC : Service Not Supported In Active Session
+            UDS_Server.Status = UDS_ServerFree;                           // UDS Server Status Set To Free
+            return;
+        }
+        if ((CheckSecurity & AllowedSecurity) != CheckSecurity) {         // Checking Security Level
+            TP_SendNegativeResponse(UDS_NRC_SAD, _SID, 'P');              // NRC : Security Access Denied
+            UDS_Server.Status = UDS_ServerFree;                           // UDS Server Status Set To Free
+            return;
+        }
+
+        uint8_t _Report = 0;
+        _Report = UDS_SecuredDataTransmission();                          // Call Function For : Secured Data Transmission
+        if (_Report) {                                                    // Check if Valid Secured Request
+          UDS_SessionTimerUpdate();                                       // Valid Service, Reseting Server Timer
+          UDS_Application();                                              // Dispatch Unwrapped Internal Request
+        }
+        return;
+      }
+
+      // UDS Service : Input Output Control By Identifier
+      case 0x2F : {                                                       // Input Output Control By Identifier Service
+        const uint8_t AllowedSecurity = UDS_SecurityNone | UDS_SecurityEnhanced | UDS_SecuritySafety | UDS_SecurityProgramming | UDS_SecurityEOL;
+        const uint8_t AllowedSession = UDS_Extended | UDS_Safety | UDS_Engineering;
+        const uint8_t AllowedAddressing = 0;
+
+        if (UDS_AddressingCheck(UDS_Message.CANID, AllowedAddressing)) {  // UDS Service Addressing Check
+            UDS_Server.Status = UDS_ServerFree;                           // UDS Server Status Set To Free
+            return;
+        }
+
+        if (UDS_Message.Length < 4) {                                     // Minimum Payload Length Check
+            TP_SendNegativeResponse(UDS_NRC_IMLIF, _SID, 'P');            // NRC : Incorrect Message Length or Invalid Format
+            UDS_Server.Status = UDS_ServerFree;                           // UDS Server Status Set To Free
+            return;
+        }
+
+        uint8_t CheckSecurity = UDS_GetSecurity();
+        uint8_t CheckSession = UDS_GetSession();
+
+        if ((CheckSession & AllowedSession) != CheckSession) {            // Checking Session
+            TP_SendNegativeResponse(UDS_NRC_SNSIAS, _SID, 'P');           // NRC : Service Not Supported In Active Session
+            UDS_Server.Status = UDS_ServerFree;                           // UDS Server Status Set To Free
+            return;
+        }
+        if ((CheckSecurity & AllowedSecurity) != CheckSecurity) {         // Checking Security Level
+            TP_SendNegativeResponse(UDS_NRC_SAD, _SID, 'P');              // NRC : Security Access Denied
+            UDS_Server.Status = UDS_ServerFree;                           // UDS Server Status Set To Free
+            return;
+        }
+
+        uint8_t _Report = 0;
+        _Report = UDS_InputOutputControl();                               // Call Function For : Input Output Control By Identifier
+        if (_Report) {                                                    // Check if Valid Service Executed
+          UDS_SessionTimerUpdate();                                       // Valid Service, Reseting Server Timer
+        }
+        return;
+      }
+
+      // UDS Service : Link Control
+      case 0x87 : {                                                       // Link Control Service
+        const uint8_t AllowedSecurity = UDS_SecurityNone | UDS_SecurityEnhanced | UDS_SecuritySafety | UDS_SecurityProgramming | UDS_SecurityEOL;
+        const uint8_t AllowedSession = UDS_Extended | UDS_Programming | UDS_Safety | UDS_Engineering;
+        const uint8_t AllowedAddressing = UDS_FuncID1 | UDS_FuncID2;
+
+        if (UDS_AddressingCheck(UDS_Message.CANID, AllowedAddressing)) {  // UDS Service Addressing Check
+            UDS_Server.Status = UDS_ServerFree;                           // UDS Server Status Set To Free
+            return;
+        }
+
+        if (UDS_Message.Length < 2) {                                     // Minimum Payload Length Check
+            TP_SendNegativeResponse(UDS_NRC_IMLIF, _SID, 'P');            // NRC : Incorrect Message Length or Invalid Format
+            UDS_Server.Status = UDS_ServerFree;                           // UDS Server Status Set To Free
+            return;
+        }
+
+        uint8_t CheckSecurity = UDS_GetSecurity();
+        uint8_t CheckSession = UDS_GetSession();
+
+        if ((CheckSession & AllowedSession) != CheckSession) {            // Checking Session
+            TP_SendNegativeResponse(UDS_NRC_SNSIAS, _SID, 'P');           // NRC : Service Not Supported In Active Session
+            UDS_Server.Status = UDS_ServerFree;                           // UDS Server Status Set To Free
+            return;
+        }
+        if ((CheckSecurity & AllowedSecurity) != CheckSecurity) {         // Checking Security Level
+            TP_SendNegativeResponse(UDS_NRC_SAD, _SID, 'P');              // NRC : Security Access Denied
+            UDS_Server.Status = UDS_ServerFree;                           // UDS Server Status Set To Free
+            return;
+        }
+
+        uint8_t _Report = 0;
+        _Report = UDS_LinkControl();                                      // Call Function For : Link Control
+        if (_Report) {                                                    // Check if Valid Service Executed
+          UDS_SessionTimerUpdate();                                       // Valid Service, Reseting Server Timer
+        }
+        return;
+      }
+
       case 0x7F : {
         UDS_Server.Status = UDS_ServerFree;
         return;
@@ -944,6 +1281,7 @@ void UDS_Application (void) {
 
 
 void UDS_InitApp (void) {
+	UDS_DeadlineStart();
 	TP_VariablesStart();
 	UDS_VariablesStart();
 }
@@ -951,9 +1289,33 @@ void UDS_InitApp (void) {
 
 
 void UDS_MainApp (void) {
+    UDS_MetricsTickStart();
     TP_RxDoCAN();
     UDS_Application();
+    UDS_ROEProcess();
     TP_TxDoCAN();
+    UDS_MetricsTickEnd();
+}
+
+
+
+/*
+ *  uint32_t UDS_NextDeadline (void)
+ *
+ *  TP_Clock Ticks Until UDS_MainApp Next Has Work, Zero When Due Now, TP_NoDeadline When Only A Frame Can Wake It
+ *  Timers (N_Bs, N_Cr, STmin, S3, Security, ROE Window) Are Read Off The Top Of UDS_Deadline
+ *  A Request Waiting For Its Response Is Always Due So P2 Is Never Slept Through
+ */
+uint32_t UDS_NextDeadline (void) {
+    if (UDS_Server.Status == UDS_ServerBusy) {                                        // Request Waiting For UDS_Application
+      return 0u;
+    }
+    if (UDS_ROE.Active && (UDS_Server.Status == UDS_ServerFree) &&                    // Event Response Ready To Send
+          (TP_TxControl.Process == TP_TxProcessIdle) &&
+          ((UDS_DIDDirty & UDS_ROE.DIDMask) || (UDS_ROE.QueueHead != UDS_ROE.QueueTail))) {
+      return 0u;
+    }
+    return TP_NextDeadline(TP_Clock());
 }
 
 
@@ -0,0 +1,331 @@
+/* ==================================================================================================== */
+/*
+ *  UDS_Auth.h
+ *  Unified Diagnostics Services on CAN (UDSonCAN) - Authentication
+ *    ISO: 14229 Part 1   - Diagonostics Services
+ *    ISO: 14229 Part 2   - Timing
+ *    ISO: 14229 Part 3   - CAN
+ *  Version: v1.1:0
+ */
+/* ==================================================================================================== */
+
+#ifndef _UDS_AUTH
+#define _UDS_AUTH
+
+#include "UDS.h"
+#include "UDS_Crypto.h"
+
+
+
+#ifndef UDSAuthenticationTasks                                                        // UDS Authentication Tasks
+  #define UDSAuthenticationTasks
+  #define UDS_AuthDeAuthenticate      0x00                                            // UDS Auth De-Authenticate
+  #define UDS_AuthRequestChallenge    0x05                                            // UDS Auth Request Challenge For Authentication
+  #define UDS_AuthVerifyProof         0x06                                            // UDS Auth Verify Proof Of Ownership Unidirectional
+  #define UDS_AuthConfiguration       0x08                                            // UDS Auth Authentication Configuration
+#endif
+
+#ifndef UDSAuthenticationReturn                                                       // UDS Authentication Return Parameters
+  #define UDSAuthenticationReturn
+  #define UDS_AuthReturnAccepted      0x00                                            // UDS Auth Request Accepted
+  #define UDS_AuthReturnSymmetric     0x04                                            // UDS Auth Challenge Response With Symmetric Crypto
+  #define UDS_AuthReturnDeAuth        0x10                                            // UDS Auth De-Authentication Successful
+  #define UDS_AuthReturnComplete      0x12                                            // UDS Auth Ownership Verified, Authentication Complete
+#endif
+
+#ifndef UDSAuthenticationStates                                                       // UDS Authentication States
+  #define UDSAuthenticationStates
+  #define UDS_AuthIdle                0u                                              // UDS Auth Not Authenticated
+  #define UDS_AuthChallenged          1u                                              // UDS Auth Challenge Sent, Waiting For Proof
+  #define UDS_AuthAuthenticated       2u                                              // UDS Auth Authenticated
+#endif
+
+#ifndef UDSAuthenticationFormat                                                       // UDS Authentication Message Format
+  #define UDSAuthenticationFormat
+  #define UDS_AuthAlgorithmLength     16u                                             // UDS Auth Algorithm Indicator Length
+  #define UDS_AuthChallengeLength     16u                                             // UDS Auth Server Challenge Length
+  #define UDS_AuthProofLength         16u                                             // UDS Auth Proof Of Ownership Length (CMAC)
+  #define UDS_SecuredHeaderLength     8u                                              // UDS Secured Data Header (SID, AP, SEC, Length, ARC)
+  #define UDS_SecuredMACLength        16u                                             // UDS Secured Data Signature Length (CMAC)
+  #define UDS_SecuredCMAC             0x00                                            // UDS Secured Data Signature Calculation : AES-CMAC
+  #define UDS_SecuredCounterMax       0xFFFFu                                         // UDS Secured Data Last Anti Replay Counter (16 Bit On The Wire)
+#endif
+
+
+// UDS Authentication Controller
+typedef struct {
+    uint8_t State;                                                                    // UDS Auth State
+    uint8_t Challenge[UDS_AuthChallengeLength];                                       // UDS Auth Last Server Challenge
+    uint16_t AntiReplay;                                                              // UDS Auth Last Accepted Anti Replay Counter
+    UDS_CMACContext Context;                                                          // UDS Auth CMAC Context (Key Loaded Once)
+    uint16_t RxLength;                                                                // UDS Auth Secured Request Length
+    uint16_t RxCovered;                                                               // UDS Auth Secured Request Bytes MACed
+    uint8_t RxActive;                                                                 // UDS Auth Incremental MAC Running (Active High)
+    uint8_t RxVerified;                                                               // UDS Auth Secured Request MAC Matched (Active High)
+} UDS_AuthController;
+extern UDS_AuthController UDS_Auth;
+
+
+extern const uint8_t UDS_AuthKey[UDS_CryptoKeyLength];                                // Supplied By Application
+
+extern void UDS_AuthRelease (void);
+extern uint8_t UDS_Authentication (void);
+extern uint8_t UDS_SecuredDataTransmission (void);
+
+
+
+
+
+
+
+/* ==================================================================================================== */
+/*
+ *  UDS_Auth.c
+ *  Unified Diagnostics Services on CAN (UDSonCAN) - Authentication
+ *  Version: v1.1:0
+ */
+/* ==================================================================================================== */
+
+
+UDS_AuthController UDS_Auth = {0};
+
+
+/* ==================================================================================================== */
+/*
+ *  Incremental Receive MAC
+ *
+ *  void UDS_AuthRxStart (uint16_t _Length)
+ *  void UDS_AuthRxUpdate (uint16_t _Received)
+ *  void UDS_AuthRelease (void)
+ *
+ *  Called From The DoCAN First And Consecutive Frame Handlers, Each Frame Is MACed As It Lands
+ *  So Verification Is Complete With The Last Consecutive Frame
+ *  Release Forgets The Authentication, Counter, Challenge And Key Schedule On Session Exit
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+void UDS_AuthRxStart (uint16_t _Length) {
+    UDS_Auth.RxActive = 0u;
+    UDS_Auth.RxVerified = 0u;
+    if ((UDS_Message.Data[0] != 0x84) || (UDS_Auth.State != UDS_AuthAuthenticated) || // Only Secured Requests When Authenticated
+          (_Length <= (UDS_SecuredHeaderLength + UDS_SecuredMACLength))) {
+      return;
+    }
+    UDS_Crypto->Restart(&UDS_Auth.Context);                                           // Key Schedule Reused
+    UDS_Auth.RxLength = _Length;
+    UDS_Auth.RxCovered = 0u;
+    UDS_Auth.RxActive = 1u;
+}
+/* ---------------------------------------------------------------------------------------------------- */
+void UDS_AuthRxUpdate (uint16_t _Received) {
+    if (!(UDS_Auth.RxActive)) {
+      return;
+    }
+    uint16_t _Signed = UDS_Auth.RxLength - UDS_SecuredMACLength;                      // Signature Covers All Bytes Before It
+    uint16_t _End = (_Received < _Signed) ? _Received : _Signed;
+    if (_End > UDS_Auth.RxCovered) {                                                  // Only New Bytes Are Fed
+      UDS_Crypto->Update(&UDS_Auth.Context, &UDS_Message.Data[UDS_Auth.RxCovered], _End - UDS_Auth.RxCovered);
+      UDS_Auth.RxCovered = _End;
+    }
+    if (_Received >= UDS_Auth.RxLength) {                                             // Last Frame Landed
+      uint8_t _MAC[UDS_CryptoBlockSize];
+      UDS_Crypto->Finish(&UDS_Auth.Context, _MAC);
+      UDS_Auth.RxVerified = UDS_CryptoCompare(_MAC, &UDS_Message.Data[_Signed], UDS_SecuredMACLength) ? 0u : 1u;
+      UDS_Auth.RxActive = 0u;
+    }
+}
+/* ---------------------------------------------------------------------------------------------------- */
+void UDS_AuthRelease (void) {
+    uint8_t *_Wipe = (uint8_t *)&UDS_Auth;
+    uint16_t i = 0;
+    while (i < sizeof(UDS_Auth)) {                                                    // Whole Controller Cleared, State Back To Idle
+      _Wipe[i] = 0u;
+      i++;
+    }
+}
+/* ==================================================================================================== */
+
+
+/* ==================================================================================================== */
+/*
+ *  UDS Authentication
+ *
+ *  uint8_t UDS_Authentication (void)
+ *
+ *  UDS Server Service 0x29 : Authentication (Challenge Response, AES-CMAC Proof Of Ownership)
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t UDS_Authentication (void) {
+    uint8_t _SID = UDS_Message.Data[0];                                               // Extracting SID
+    uint8_t _Suppress = (UDS_Message.Data[1] & 0x80) ? 1 : 0;                         // Checking is Positive Response Is Suppressed
+    uint8_t _SF = UDS_Message.Data[1] & 0x7F;                                         // Extracting Sub Function
+    uint8_t i = 0;
+
+    switch (_SF) {
+      case UDS_AuthDeAuthenticate : {                                                 // De-Authenticate
+        if (UDS_Message.Length != 2) {                                                // Expected Payload Length Check
+            TP_SendNegativeResponse(UDS_NRC_IMLIF, _SID, 'P');                        // NRC : Incorrect Message Length or Invalid Format
+            UDS_Server.Status = UDS_ServerFree;                                       // UDS Server Status Set To Free
+            return 0;
+        }
+        UDS_AuthRelease();                                                            // Authentication Dropped
+        UDS_Message.Length = 3;                                                       // TML Suggested
+        UDS_Message.Data[2] = UDS_AuthReturnDeAuth;                                   // Authentication Return Parameter
+        break;
+      }
+      case UDS_AuthConfiguration : {                                                  // Authentication Configuration
+        if (UDS_Message.Length != 2) {                                                // Expected Payload Length Check
+            TP_SendNegativeResponse(UDS_NRC_IMLIF, _SID, 'P');                        // NRC : Incorrect Message Length or Invalid Format
+            UDS_Server.Status = UDS_ServerFree;                                       // UDS Server Status Set To Free
+            return 0;
+        }
+        UDS_Message.Length = 3;                                                       // TML Suggested
+        UDS_Message.Data[2] = UDS_AuthReturnSymmetric;                                // Authentication Return Parameter
+        break;
+      }
+      case UDS_AuthRequestChallenge : {                                               // Request Challenge For Authentication
+        if (UDS_Message.Length != (3 + UDS_AuthAlgorithmLength)) {                    // Communication Configuration And Algorithm Indicator
+            TP_SendNegativeResponse(UDS_NRC_IMLIF, _SID, 'P');                        // NRC : Incorrect Message Length or Invalid Format
+            UDS_Server.Status = UDS_ServerFree;                                       // UDS Server Status Set To Free
+            return 0;
+        }
+        if (UDS_Crypto->Random(UDS_Auth.Challenge, UDS_AuthChallengeLength)) {        // Fresh Server Challenge
+            TP_SendNegativeResponse(UDS_NRC_CCF, _SID, 'P');                          // NRC : Challenge Calculation Failed
+            UDS_Server.Status = UDS_ServerFree;                                       // UDS Server Status Set To Free
+            return 0;
+        }
+        UDS_Auth.State = UDS_AuthChallenged;                                          // Waiting For Proof Of Ownership
+        uint8_t _Offset = 3 + UDS_AuthAlgorithmLength;                                // Algorithm Indicator Echoed In Place
+        UDS_Message.Data[_Offset++] = 0x00;                                           // Challenge Length High
+        UDS_Message.Data[_Offset++] = UDS_AuthChallengeLength;                        // Challenge Length Low
+        i = 0;
+        while (i < UDS_AuthChallengeLength) {                                         // Server Challenge
+          UDS_Message.Data[_Offset++] = UDS_Auth.Challenge[i];
+          i++;
+        }
+        UDS_Message.Data[_Offset++] = 0x00;                                           // Needed Additional Parameter Length High
+        UDS_Message.Data[_Offset++] = 0x00;                                           // Needed Additional Parameter Length Low
+        UDS_Message.Length = _Offset;                                                 // TML Suggested
+        UDS_Message.Data[2] = UDS_AuthReturnAccepted;                                 // Authentication Return Parameter
+        break;
+      }
+      case UDS_AuthVerifyProof : {                                                    // Verify Proof Of Ownership Unidirectional
+        uint8_t _Offset = 2 + UDS_AuthAlgorithmLength;                                // Proof Length Follows Algorithm Indicator
+        if ((UDS_Message.Length < (_Offset + 2 + UDS_AuthProofLength + 4)) ||         // Proof, Client Challenge And Additional Parameter
+              (UDS_Message.Data[_Offset] != 0x00) || (UDS_Message.Data[_Offset + 1] != UDS_AuthProofLength)) {
+            TP_SendNegativeResponse(UDS_NRC_IMLIF, _SID, 'P');                        // NRC : Incorrect Message Length or Invalid Format
+            UDS_Server.Status = UDS_ServerFree;                                       // UDS Server Status Set To Free
+            return 0;
+        }
+        if (UDS_Auth.State != UDS_AuthChallenged) {                                   // Challenge Must Be Requested First
+            TP_SendNegativeResponse(UDS_NRC_RSE, _SID, 'P');                          // NRC : Request Sequence Error
+            UDS_Server.Status = UDS_ServerFree;                                       // UDS Server Status Set To Free
+            return 0;
+        }
+        uint8_t _Proof[UDS_CryptoBlockSize];
+        UDS_Crypto->Start(&UDS_Auth.Context, UDS_AuthKey);                            // Key Loaded Once For Proof And Secured Data
+        UDS_Crypto->Update(&UDS_Auth.Context, UDS_Auth.Challenge, UDS_AuthChallengeLength);
+        UDS_Crypto->Finish(&UDS_Auth.Context, _Proof);
+        if (UDS_CryptoCompare(_Proof, &UDS_Message.Data[_Offset + 2], UDS_AuthProofLength)) {
+            UDS_Auth.State = UDS_AuthIdle;                                            // Challenge Is Single Use
+            TP_SendNegativeResponse(UDS_NRC_OVF, _SID, 'P');                          // NRC : Ownership Verification Failed
+            UDS_Server.Status = UDS_ServerFree;                                       // UDS Server Status Set To Free
+            return 0;
+        }
+        UDS_Auth.State = UDS_AuthAuthenticated;                                       // Authenticated
+        UDS_Auth.AntiReplay = 0u;                                                     // Secured Data Counter Restarted
+        UDS_Message.Data[3 + UDS_AuthAlgorithmLength] = 0x00;                         // Session Key Info Length High
+        UDS_Message.Data[4 + UDS_AuthAlgorithmLength] = 0x00;                         // Session Key Info Length Low
+        i = UDS_AuthAlgorithmLength;
+        while (i > 0) {                                                               // Algorithm Indicator Moved Behind Return Parameter
+          UDS_Message.Data[2 + i] = UDS_Message.Data[1 + i];
+          i--;
+        }
+        UDS_Message.Length = 5 + UDS_AuthAlgorithmLength;                             // TML Suggested
+        UDS_Message.Data[2] = UDS_AuthReturnComplete;                                 // Authentication Return Parameter
+        break;
+      }
+      default : {
+        TP_SendNegativeResponse(UDS_NRC_SFNS, _SID, 'P');                             // NRC : Sub Function Not Supported
+        UDS_Server.Status = UDS_ServerFree;                                           // UDS Server Status Set To Free
+        return 0;
+      }
+    }
+
+    if (_Suppress) {                                                                  // Checking if Positive Response is Suppressed
+        UDS_Server.Status = UDS_ServerFree;                                           // UDS Server Status Set To Free
+        return 1;                                                                     // Returning All OK
+    } else {                                                                          // Frame Building
+      UDS_Message.Data[0] = 0x69;                                                     // Positive Response SID
+      UDS_Message.Data[1] = _SF;                                                      // Echo Sub Function
+      TP_TxFrameUSDT('P');                                                            // Sending Response Frame
+      return 1;
+    }
+}
+/* ==================================================================================================== */
+
+
+/* ==================================================================================================== */
+/*
+ *  UDS Secured Data Transmission
+ *
+ *  uint8_t UDS_SecuredDataTransmission (void)
+ *
+ *  UDS Server Service 0x84 : Secured Data Transmission (AES-CMAC Signed Requests)
+ *  Verified Requests Are Unwrapped In UDS_Message For Dispatch, Responses Are Sent Unsigned
+ *  The Anti Replay Counter Is 16 Bit And Must Rise, So One Authentication Covers At Most 65535
+ *  Secured Requests. Once UDS_SecuredCounterMax Was Accepted The Authentication Is Dropped And
+ *  The Next Secured Request Gets Authentication Required Until The Tester Authenticates Again
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t UDS_SecuredDataTransmission (void) {
+    uint8_t _SID = UDS_Message.Data[0];                                               // Extracting SID
+    uint8_t _Verified = UDS_Auth.RxVerified;                                          // Result Of Receive Path MAC
+    UDS_Auth.RxVerified = 0u;                                                         // Verification Is Single Use
+
+    if (UDS_Message.Length <= (UDS_SecuredHeaderLength + UDS_SecuredMACLength)) {     // Header, Internal Request And Signature
+        TP_SendNegativeResponse(UDS_NRC_IMLIF, _SID, 'P');                            // NRC : Incorrect Message Length or Invalid Format
+        UDS_Server.Status = UDS_ServerFree;                                           // UDS Server Status Set To Free
+        return 0;
+    }
+    if (UDS_Auth.State != UDS_AuthAuthenticated) {                                    // Authentication Required
+        TP_SendNegativeResponse(UDS_NRC_AR, _SID, 'P');                               // NRC : Authentication Required
+        UDS_Server.Status = UDS_ServerFree;                                           // UDS Server Status Set To Free
+        return 0;
+    }
+    if (UDS_Auth.AntiReplay == UDS_SecuredCounterMax) {                               // Anti Replay Counter Exhausted
+        UDS_Auth.State = UDS_AuthIdle;                                                // Authentication Dropped, Counter Restarts On The Next
+        TP_SendNegativeResponse(UDS_NRC_AR, _SID, 'P');                               // NRC : Authentication Required
+        UDS_Server.Status = UDS_ServerFree;                                           // UDS Server Status Set To Free
+        return 0;
+    }
+    if ((UDS_Message.Data[3] != UDS_SecuredCMAC) || (UDS_Message.Data[4] != 0x00) ||  // Signature Calculation And Length Check
+          (UDS_Message.Data[5] != UDS_SecuredMACLength) || (UDS_Message.Data[8] == 0x84)) {
+        TP_SendNegativeResponse(UDS_NRC_ROOR, _SID, 'P');                             // NRC : Request Out Of Range
+        UDS_Server.Status = UDS_ServerFree;                                           // UDS Server Status Set To Free
+        return 0;
+    }
+
+    Number16Bit _Counter;
+    _Counter.Byte.B1 = UDS_Message.Data[6];                                           // Extracting Anti Replay Counter High
+    _Counter.Byte.B0 = UDS_Message.Data[7];                                           // Extracting Anti Replay Counter Low
+    if (!(_Verified) || (_Counter.Raw <= UDS_Auth.AntiReplay)) {                      // Signature And Freshness Check
+        TP_SendNegativeResponse(UDS_NRC_SAD, _SID, 'P');                              // NRC : Security Access Denied
+        UDS_Server.Status = UDS_ServerFree;                                           // UDS Server Status Set To Free
+        return 0;
+    }
+    UDS_Auth.AntiReplay = _Counter.Raw;                                               // Counter Accepted
+
+    uint16_t _Length = UDS_Message.Length - UDS_SecuredHeaderLength - UDS_SecuredMACLength;
+    uint16_t i = 0;
+    while (i < _Length) {                                                             // Internal Request Unwrapped
+      UDS_Message.Data[i] = UDS_Message.Data[UDS_SecuredHeaderLength + i];
+      i++;
+    }
+    UDS_Message.Length = _Length;
+    return 1;                                                                         // Internal Request Ready For Dispatch
+}
+/* ==================================================================================================== */
+
+
+
+#endif
@@ -0,0 +1,193 @@
+/* ==================================================================================================== */
+/*
+ *  UDS_Config.h
+ *  Unified Diagnostics Services on CAN (UDSonCAN) - Server Configuration
+ *    Every Build Time Setting Of The Server Lives Here : CAN IDs, Buffer Sizes, Transport And Session Timing
+ *    A Generated Or Project Header Named By UDS_ConfigFile Is Read First, Any Group It Defines Wins
+ *    Values Derived From The Settings Are Macros And Constant Tables, Bad Combinations Stop The Build
+ *  Version: v1.1:0
+ */
+/* ==================================================================================================== */
+
+#ifndef _UDS_Config
+#define _UDS_Config
+
+#ifdef UDS_ConfigFile
+  #include UDS_ConfigFile                                                             // Generated Or Project Settings
+#endif
+
+
+
+#ifndef UDSCANID                                                                      // UDS Server CAN IDs
+  #define UDSCANID
+
+  #define _UDS_RxID                   0x785                                           // UDS Server RX CAN ID
+  #define _UDS_TxID                   0x78D                                           // UDS Server TX CAN ID
+
+  #define _UDS_Fun1_RxID              0x069                                           // UDS Server Functional Rx ID 1
+  #define _UDS_Fun1_TxID              0x096                                           // UDS Server Functional Tx ID 1
+  #define _UDS_Fun2_RxID              0x0A5                                           // UDS Server Functional Rx ID 2
+  #define _UDS_Fun2_TxID              0x05A                                           // UDS Server Functional Tx ID 2
+  #define _UDS_Fun3_RxID              0x000                                           // UDS Server Functional Rx ID 3
+  #define _UDS_Fun3_TxID              0x000                                           // UDS Server Functional Tx ID 3
+  #define _UDS_Fun4_RxID              0x000                                           // UDS Server Functional Rx ID 4
+  #define _UDS_Fun4_TxID              0x000                                           // UDS Server Functional Tx ID 4
+  #define _UDS_Fun5_RxID              0x000                                           // UDS Server Functional Rx ID 5
+  #define _UDS_Fun5_TxID              0x000                                           // UDS Server Functional Tx ID 5
+  #define _UDS_Fun6_RxID              0x000                                           // UDS Server Functional Rx ID 6
+  #define _UDS_Fun6_TxID              0x000                                           // UDS Server Functional Tx ID 6
+  #define _UDS_Fun7_RxID              0x000                                           // UDS Server Functional Rx ID 7
+  #define _UDS_Fun7_TxID              0x000                                           // UDS Server Functional Tx ID 7
+  #define _UDS_Fun8_RxID              0x000                                           // UDS Server Functional Rx ID 8
+  #define _UDS_Fun8_TxID              0x000                                           // UDS Server Functional Tx ID 8
+  #define UDS_FunctionalCount         2u                                              // UDS Functional ID Pairs In Use (From Fun1)
+
+  #define UDS_FuncID1                 0x01                                            // UDS Allowed Functional Address 1
+  #define UDS_FuncID2                 0x02                                            // UDS Allowed Functional Address 2
+  #define UDS_FuncID3                 0x04                                            // UDS Allowed Functional Address 3
+  #define UDS_FuncID4                 0x08                                            // UDS Allowed Functional Address 4
+  #define UDS_FuncID5                 0x10                                            // UDS Allowed Functional Address 5
+  #define UDS_FuncID6                 0x20                                            // UDS Allowed Functional Address 6
+  #define UDS_FuncID7                 0x40                                            // UDS Allowed Functional Address 7
+  #define UDS_FuncID8                 0x80                                            // UDS Allowed Functional Address 8
+#endif
+
+#ifndef UDSParameters                                                                 // UDS Server Parameter
+  #define UDSParameters
+  #define UDS_ParaBufferSize          128u                                            // UDS Parameter Message Buffer Size
+  #define UDS_ParaS3Timeout           5000u                                           // UDS Parameter S3 Timeout
+  #define UDS_ParaP3Timeout           5000u                                           // UDS Parameter P3 Timeout
+#endif
+
+#ifndef UDSTimingParameters                                                           // UDS Server Timing
+  #define UDSTimingParameters
+  #define UDS_ParaP2Server            50u                                             // UDS P2_Server_Max Reported By Session Control
+  #define UDS_ParaP2StarServer        5000u                                           // UDS P2*_Server_Max Reported By Session Control
+  #define UDS_ParaSecurityTimeout     5000u                                           // UDS Unlocked Security Level Lifetime
+#endif
+
+#ifndef UDS_LinkDefaultBaud
+  #define UDS_LinkDefaultBaud         500000u                                         // UDS Link Default Baudrate (Power Up)
+#endif
+
+#ifndef TP_CANPadding
+  #define TP_CANPadding                               0x55                            // TP CAN Padding Character
+#endif
+
+#ifndef TP_RxBufferSize
+  #define TP_RxBufferSize                             128u                            // TP Receive Message Buffer Size
+#endif
+
+#ifndef TP_ServerParameters
+  #define TP_ServerParameters
+  #define TP_ServerWaitCountDown                      600u                            // TP Wait Count Down
+  #define TP_ServerWaitTimeout                        5000u                           // TP Wait Timeout
+  #define TP_Server_NAs                               1000u                           // TP Timeout N_As
+  #define TP_Server_NAr                               1000u                           // TP Timeout N_Ar
+  #define TP_Server_NBs                               1000u                           // TP Timeout N_Bs
+  #define TP_Server_NBr                               0u                              // TP Timeout N_Br
+  #define TP_Server_NCs                               0u                              // TP Timeout N_Cs
+  #define TP_Server_NCr                               1000u                           // TP Timeout N_Cr
+#endif
+
+#ifndef UDSDataIdentifiers                                                            // UDS Data Identifiers
+  #define UDSDataIdentifiers
+  #ifdef UDS_EnableMetrics
+    #define UDS_DIDCount              5u                                              // UDS Number of Data Identifiers (Max 32)
+  #else
+    #define UDS_DIDCount              4u                                              // UDS Number of Data Identifiers (Max 32)
+  #endif
+  #define UDS_DIDVINLength            17u                                             // UDS VIN Length
+  #define UDS_DIDStatusLength         4u                                              // UDS Status Record Length
+  #define UDS_DIDBlockLength          100u                                            // UDS Data Block Record Length
+#endif
+
+#ifndef UDSIOControlSignals                                                           // UDS Input Output Controlled Signals
+  #define UDSIOControlSignals
+  #define UDS_IOSignalCount           4u                                              // UDS Number of Controllable Signals (Max 32)
+
+  #define _UDS_IO1_DID                0x4F01                                          // UDS Signal 1 DID
+  #define _UDS_IO1_Default            0x0000                                          // UDS Signal 1 Default Value
+  #define _UDS_IO2_DID                0x4F02                                          // UDS Signal 2 DID
+  #define _UDS_IO2_Default            0x0000                                          // UDS Signal 2 Default Value
+  #define _UDS_IO3_DID                0x4F03                                          // UDS Signal 3 DID
+  #define _UDS_IO3_Default            0x0000                                          // UDS Signal 3 Default Value
+  #define _UDS_IO4_DID                0x4F04                                          // UDS Signal 4 DID
+  #define _UDS_IO4_Default            0x0000                                          // UDS Signal 4 Default Value
+#endif
+
+
+/*
+ *  Derived Values
+ *    TP_FrameCount      Frames For A Payload : One SF Up To 7 Bytes, Else FF (6 Bytes) Plus CFs (7 Bytes Each)
+ *    TP_RxFramesMax     Frames In The Longest Request The Server Takes
+ *    TP_MaxFFDL         Longest FF_DL Accepted, Anything Longer Gets FC Overflow
+ *    UDS_TxLengthMax    Longest Response TP_TxFrameUSDT Sends
+ */
+#define TP_FrameCount(_Length)        (((_Length) < 8u) ? 1u : (1u + ((_Length) / 7u)))
+#define TP_RxFramesMax                TP_FrameCount(TP_RxBufferSize)
+#define TP_MaxFFDL                    TP_RxBufferSize
+#define UDS_TxLengthMax               (UDS_ParaBufferSize - 1u)
+
+
+#ifdef __cplusplus
+  #define UDS_StaticAssert(_Check, _Name)  static_assert(_Check, #_Name)
+#elif defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+  #define UDS_StaticAssert(_Check, _Name)  _Static_assert(_Check, #_Name)
+#else
+  #define UDS_StaticAssert(_Check, _Name)  typedef char _Name[(_Check) ? 1 : -1]
+#endif
+
+UDS_StaticAssert((_UDS_RxID <= 0x7FF) && (_UDS_TxID <= 0x7FF), UDS_ConfigPhysicalIDNot11Bit);
+UDS_StaticAssert(_UDS_RxID != _UDS_TxID, UDS_ConfigPhysicalIDsEqual);
+UDS_StaticAssert(UDS_FunctionalCount <= 8u, UDS_ConfigFunctionalCountAbove8);
+UDS_StaticAssert((UDS_FunctionalCount < 1u) || (_UDS_Fun1_RxID != _UDS_RxID), UDS_ConfigFunctional1OnPhysicalID);
+UDS_StaticAssert((UDS_FunctionalCount < 2u) || (_UDS_Fun2_RxID != _UDS_RxID), UDS_ConfigFunctional2OnPhysicalID);
+UDS_StaticAssert((UDS_FunctionalCount < 3u) || (_UDS_Fun3_RxID != _UDS_RxID), UDS_ConfigFunctional3OnPhysicalID);
+UDS_StaticAssert((UDS_FunctionalCount < 4u) || (_UDS_Fun4_RxID != _UDS_RxID), UDS_ConfigFunctional4OnPhysicalID);
+UDS_StaticAssert((UDS_FunctionalCount < 5u) || (_UDS_Fun5_RxID != _UDS_RxID), UDS_ConfigFunctional5OnPhysicalID);
+UDS_StaticAssert((UDS_FunctionalCount < 6u) || (_UDS_Fun6_RxID != _UDS_RxID), UDS_ConfigFunctional6OnPhysicalID);
+UDS_StaticAssert((UDS_FunctionalCount < 7u) || (_UDS_Fun7_RxID != _UDS_RxID), UDS_ConfigFunctional7OnPhysicalID);
+UDS_StaticAssert((UDS_FunctionalCount < 8u) || (_UDS_Fun8_RxID != _UDS_RxID), UDS_ConfigFunctional8OnPhysicalID);
+UDS_StaticAssert((TP_RxBufferSize >= 8u) && (TP_MaxFFDL <= 4095u), UDS_ConfigRxBufferOutsideFFDL);
+UDS_StaticAssert(TP_RxBufferSize <= UDS_ParaBufferSize, UDS_ConfigRxBufferAboveMessageBuffer);
+UDS_StaticAssert(UDS_ParaBufferSize >= 8u, UDS_ConfigMessageBufferBelowSegmented);
+UDS_StaticAssert((UDS_ParaP2Server <= 0xFFFFu) && (UDS_ParaP2StarServer <= 0xFFFFu), UDS_ConfigP2Above16Bit);
+UDS_StaticAssert(UDS_ParaP2Server < UDS_ParaP2StarServer, UDS_ConfigP2NotBelowP2Star);
+UDS_StaticAssert(UDS_ParaS3Timeout > UDS_ParaP2Server, UDS_ConfigS3NotAboveP2);
+UDS_StaticAssert(TP_ServerWaitCountDown <= 0xFFFFu, UDS_ConfigWaitCountAbove16Bit);
+UDS_StaticAssert((UDS_DIDCount >= 1u) && (UDS_DIDCount <= 32u), UDS_ConfigDIDCountAbove32);
+UDS_StaticAssert((UDS_IOSignalCount >= 1u) && (UDS_IOSignalCount <= 32u), UDS_ConfigIOSignalCountAbove32);
+UDS_StaticAssert((3u + 7u * UDS_DIDCount + 5u) <= UDS_ParaBufferSize, UDS_ConfigROEReportAboveMessageBuffer);
+
+
+extern const uint16_t UDS_FunctionalRxID[8];                                          // UDS Functional Rx IDs (First UDS_FunctionalCount Used)
+extern const uint16_t UDS_FunctionalTxID[8];                                          // UDS Functional Tx IDs (First UDS_FunctionalCount Used)
+
+
+
+
+
+
+
+/* ==================================================================================================== */
+/*
+ *  UDS_Config.c
+ *  Unified Diagnostics Services on CAN (UDSonCAN) - Server Configuration
+ *  Version: v1.1:0
+ */
+/* ==================================================================================================== */
+
+const uint16_t UDS_FunctionalRxID[8] = {
+    _UDS_Fun1_RxID, _UDS_Fun2_RxID, _UDS_Fun3_RxID, _UDS_Fun4_RxID,
+    _UDS_Fun5_RxID, _UDS_Fun6_RxID, _UDS_Fun7_RxID, _UDS_Fun8_RxID
+};
+const uint16_t UDS_FunctionalTxID[8] = {
+    _UDS_Fun1_TxID, _UDS_Fun2_TxID, _UDS_Fun3_TxID, _UDS_Fun4_TxID,
+    _UDS_Fun5_TxID, _UDS_Fun6_TxID, _UDS_Fun7_TxID, _UDS_Fun8_TxID
+};
+/* ==================================================================================================== */
+
+
+
+#endif
@@ -0,0 +1,287 @@
+/* ==================================================================================================== */
+/*
+ *  UDS_Crypto.h
+ *  Unified Diagnostics Services on CAN (UDSonCAN) - Crypto Backend
+ *    FIPS: 197           - Advanced Encryption Standard (AES-128)
+ *    NIST: SP 800-38B    - CMAC Mode For Authentication
+ *  Version: v1.1:0
+ */
+/* ==================================================================================================== */
+
+#ifndef _UDS_CRYPTO
+#define _UDS_CRYPTO
+
+#include <stdint.h>
+
+
+
+#ifndef UDSCryptoParameters                                                           // UDS Crypto Parameters
+  #define UDSCryptoParameters
+  #define UDS_CryptoBlockSize         16u                                             // UDS Crypto AES Block Size
+  #define UDS_CryptoKeyLength         16u                                             // UDS Crypto AES-128 Key Length
+  #define UDS_CryptoRoundKeys         176u                                            // UDS Crypto AES-128 Expanded Key Length
+  #define UDS_CryptoRb                0x87                                            // UDS Crypto CMAC Subkey Constant
+#endif
+
+
+// UDS CMAC Context (Hardware Backends May Use It As Scratch)
+typedef struct {
+    uint8_t RoundKey[UDS_CryptoRoundKeys];                                            // AES Expanded Key
+    uint8_t K1[UDS_CryptoBlockSize];                                                  // CMAC Subkey For Complete Last Block
+    uint8_t K2[UDS_CryptoBlockSize];                                                  // CMAC Subkey For Padded Last Block
+    uint8_t State[UDS_CryptoBlockSize];                                               // CMAC Chaining Value
+    uint8_t Block[UDS_CryptoBlockSize];                                               // CMAC Pending Block (Held Until More Data Or Finish)
+    uint8_t Fill;                                                                     // CMAC Pending Block Bytes
+} UDS_CMACContext;
+
+// UDS Crypto Backend
+typedef struct {
+    void (*Start) (UDS_CMACContext *_Context, const uint8_t *_Key);                   // Load Key And Start MAC
+    void (*Restart) (UDS_CMACContext *_Context);                                      // Start New MAC With Loaded Key
+    void (*Update) (UDS_CMACContext *_Context, const uint8_t *_Data, uint16_t _Length);
+    void (*Finish) (UDS_CMACContext *_Context, uint8_t *_MAC);                        // Complete MAC (Block Size Bytes)
+    uint8_t (*Random) (uint8_t *_Buffer, uint8_t _Length);                            // Fill Random Bytes (Zero On Success)
+} UDS_CryptoBackend;
+
+
+extern uint8_t UDS_PlatformRandom (uint8_t *_Buffer, uint8_t _Length);                // Supplied By Platform
+
+extern const UDS_CryptoBackend UDS_CryptoSoftware;
+extern const UDS_CryptoBackend *UDS_Crypto;
+
+extern void UDS_AESEncrypt (const uint8_t *_RoundKey, uint8_t *_Block);
+extern uint8_t UDS_CryptoCompare (const uint8_t *_A, const uint8_t *_B, uint8_t _Length);
+
+
+
+
+
+
+
+/* ==================================================================================================== */
+/*
+ *  UDS_Crypto.c
+ *  Unified Diagnostics Services on CAN (UDSonCAN) - Crypto Backend
+ *  Version: v1.1:0
+ */
+/* ==================================================================================================== */
+
+
+static const uint8_t UDS_AESSbox[256] = {
+    0x63, 0x7C, 0x77, 0x7B, 0xF2, 0x6B, 0x6F, 0xC5, 0x30, 0x01, 0x67, 0x2B, 0xFE, 0xD7, 0xAB, 0x76,
+    0xCA, 0x82, 0xC9, 0x7D, 0xFA, 0x59, 0x47, 0xF0, 0xAD, 0xD4, 0xA2, 0xAF, 0x9C, 0xA4, 0x72, 0xC0,
+    0xB7, 0xFD, 0x93, 0x26, 0x36, 0x3F, 0xF7, 0xCC, 0x34, 0xA5, 0xE5, 0xF1, 0x71, 0xD8, 0x31, 0x15,
+    0x04, 0xC7, 0x23, 0xC3, 0x18, 0x96, 0x05, 0x9A, 0x07, 0x12, 0x80, 0xE2, 0xEB, 0x27, 0xB2, 0x75,
+    0x09, 0x83, 0x2C, 0x1A, 0x1B, 0x6E, 0x5A, 0xA0, 0x52, 0x3B, 0xD6, 0xB3, 0x29, 0xE3, 0x2F, 0x84,
+    0x53, 0xD1, 0x00, 0xED, 0x20, 0xFC, 0xB1, 0x5B, 0x6A, 0xCB, 0xBE, 0x39, 0x4A, 0x4C, 0x58, 0xCF,
+    0xD0, 0xEF, 0xAA, 0xFB, 0x43, 0x4D, 0x33, 0x85, 0x45, 0xF9, 0x02, 0x7F, 0x50, 0x3C, 0x9F, 0xA8,
+    0x51, 0xA3, 0x40, 0x8F, 0x92, 0x9D, 0x38, 0xF5, 0xBC, 0xB6, 0xDA, 0x21, 0x10, 0xFF, 0xF3, 0xD2,
+    0xCD, 0x0C, 0x13, 0xEC, 0x5F, 0x97, 0x44, 0x17, 0xC4, 0xA7, 0x7E, 0x3D, 0x64, 0x5D, 0x19, 0x73,
+    0x60, 0x81, 0x4F, 0xDC, 0x22, 0x2A, 0x90, 0x88, 0x46, 0xEE, 0xB8, 0x14, 0xDE, 0x5E, 0x0B, 0xDB,
+    0xE0, 0x32, 0x3A, 0x0A, 0x49, 0x06, 0x24, 0x5C, 0xC2, 0xD3, 0xAC, 0x62, 0x91, 0x95, 0xE4, 0x79,
+    0xE7, 0xC8, 0x37, 0x6D, 0x8D, 0xD5, 0x4E, 0xA9, 0x6C, 0x56, 0xF4, 0xEA, 0x65, 0x7A, 0xAE, 0x08,
+    0xBA, 0x78, 0x25, 0x2E, 0x1C, 0xA6, 0xB4, 0xC6, 0xE8, 0xDD, 0x74, 0x1F, 0x4B, 0xBD, 0x8B, 0x8A,
+    0x70, 0x3E, 0xB5, 0x66, 0x48, 0x03, 0xF6, 0x0E, 0x61, 0x35, 0x57, 0xB9, 0x86, 0xC1, 0x1D, 0x9E,
+    0xE1, 0xF8, 0x98, 0x11, 0x69, 0xD9, 0x8E, 0x94, 0x9B, 0x1E, 0x87, 0xE9, 0xCE, 0x55, 0x28, 0xDF,
+    0x8C, 0xA1, 0x89, 0x0D, 0xBF, 0xE6, 0x42, 0x68, 0x41, 0x99, 0x2D, 0x0F, 0xB0, 0x54, 0xBB, 0x16
+};
+
+
+/* ==================================================================================================== */
+/*
+ *  AES-128 Block Cipher (Encrypt Only, CMAC Needs No Inverse Cipher)
+ *
+ *  void UDS_AESKeyExpand (const uint8_t *_Key, uint8_t *_RoundKey)
+ *  void UDS_AESEncrypt (const uint8_t *_RoundKey, uint8_t *_Block)
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+static inline uint8_t UDS_AESXtime (uint8_t _Value) {
+    return (uint8_t)((_Value << 1) ^ ((_Value & 0x80) ? 0x1B : 0x00));                // GF(2^8) Multiply By 2
+}
+/* ---------------------------------------------------------------------------------------------------- */
+void UDS_AESKeyExpand (const uint8_t *_Key, uint8_t *_RoundKey) {
+    uint8_t _Rcon = 0x01;
+    uint8_t i = 0;
+    while (i < UDS_CryptoKeyLength) {                                                 // First Round Key Is The Key
+      _RoundKey[i] = _Key[i];
+      i++;
+    }
+    while (i < UDS_CryptoRoundKeys) {
+      uint8_t _Word[4];
+      _Word[0] = _RoundKey[i - 4];
+      _Word[1] = _RoundKey[i - 3];
+      _Word[2] = _RoundKey[i - 2];
+      _Word[3] = _RoundKey[i - 1];
+      if ((i % UDS_CryptoKeyLength) == 0) {                                           // RotWord, SubWord And Rcon
+        uint8_t _Temp = _Word[0];
+        _Word[0] = UDS_AESSbox[_Word[1]] ^ _Rcon;
+        _Word[1] = UDS_AESSbox[_Word[2]];
+        _Word[2] = UDS_AESSbox[_Word[3]];
+        _Word[3] = UDS_AESSbox[_Temp];
+        _Rcon = UDS_AESXtime(_Rcon);
+      }
+      uint8_t j = 0;
+      while (j < 4) {
+        _RoundKey[i] = _RoundKey[i - UDS_CryptoKeyLength] ^ _Word[j];
+        i++;
+        j++;
+      }
+    }
+}
+/* ---------------------------------------------------------------------------------------------------- */
+void UDS_AESEncrypt (const uint8_t *_RoundKey, uint8_t *_Block) {
+    uint8_t _Round = 0;
+    uint8_t i = 0;
+    while (i < UDS_CryptoBlockSize) {                                                 // Initial AddRoundKey
+      _Block[i] ^= _RoundKey[i];
+      i++;
+    }
+    for (_Round = 1; _Round <= 10; _Round++) {
+      uint8_t _Temp;
+      for (i = 0; i < UDS_CryptoBlockSize; i++) {                                     // SubBytes
+        _Block[i] = UDS_AESSbox[_Block[i]];
+      }
+      _Temp = _Block[1];                                                              // ShiftRows, Row 1
+      _Block[1] = _Block[5];
+      _Block[5] = _Block[9];
+      _Block[9] = _Block[13];
+      _Block[13] = _Temp;
+      _Temp = _Block[2];                                                              // ShiftRows, Row 2
+      _Block[2] = _Block[10];
+      _Block[10] = _Temp;
+      _Temp = _Block[6];
+      _Block[6] = _Block[14];
+      _Block[14] = _Temp;
+      _Temp = _Block[3];                                                              // ShiftRows, Row 3
+      _Block[3] = _Block[15];
+      _Block[15] = _Block[11];
+      _Block[11] = _Block[7];
+      _Block[7] = _Temp;
+      if (_Round != 10) {                                                             // MixColumns (Not In Final Round)
+        for (i = 0; i < UDS_CryptoBlockSize; i += 4) {
+          uint8_t _A0 = _Block[i];
+          uint8_t _All = _Block[i] ^ _Block[i + 1] ^ _Block[i + 2] ^ _Block[i + 3];
+          _Block[i] ^= _All ^ UDS_AESXtime(_Block[i] ^ _Block[i + 1]);
+          _Block[i + 1] ^= _All ^ UDS_AESXtime(_Block[i + 1] ^ _Block[i + 2]);
+          _Block[i + 2] ^= _All ^ UDS_AESXtime(_Block[i + 2] ^ _Block[i + 3]);
+          _Block[i + 3] ^= _All ^ UDS_AESXtime(_Block[i + 3] ^ _A0);
+        }
+      }
+      for (i = 0; i < UDS_CryptoBlockSize; i++) {                                     // AddRoundKey
+        _Block[i] ^= _RoundKey[(_Round * UDS_CryptoBlockSize) + i];
+      }
+    }
+}
+/* ==================================================================================================== */
+
+
+/* ==================================================================================================== */
+/*
+ *  AES-CMAC (Software Backend)
+ *
+ *  void UDS_CMACStart (UDS_CMACContext *_Context, const uint8_t *_Key)
+ *  void UDS_CMACRestart (UDS_CMACContext *_Context)
+ *  void UDS_CMACUpdate (UDS_CMACContext *_Context, const uint8_t *_Data, uint16_t _Length)
+ *  void UDS_CMACFinish (UDS_CMACContext *_Context, uint8_t *_MAC)
+ *
+ *  Update Accepts Any Chunk Size, So Frames Can Be Fed As They Arrive
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+static void UDS_CMACSubkey (const uint8_t *_In, uint8_t *_Out) {
+    uint8_t _Carry = (_In[0] & 0x80) ? 1 : 0;
+    uint8_t i = 0;
+    while (i < (UDS_CryptoBlockSize - 1)) {                                           // Left Shift By One Bit
+      _Out[i] = (uint8_t)((_In[i] << 1) | (_In[i + 1] >> 7));
+      i++;
+    }
+    _Out[UDS_CryptoBlockSize - 1] = (uint8_t)(_In[UDS_CryptoBlockSize - 1] << 1);
+    if (_Carry) {
+      _Out[UDS_CryptoBlockSize - 1] ^= UDS_CryptoRb;
+    }
+}
+/* ---------------------------------------------------------------------------------------------------- */
+void UDS_CMACRestart (UDS_CMACContext *_Context) {
+    uint8_t i = 0;
+    while (i < UDS_CryptoBlockSize) {
+      _Context->State[i] = 0;                                                         // Zero Chaining Value
+      i++;
+    }
+    _Context->Fill = 0;
+}
+/* ---------------------------------------------------------------------------------------------------- */
+void UDS_CMACStart (UDS_CMACContext *_Context, const uint8_t *_Key) {
+    UDS_AESKeyExpand(_Key, _Context->RoundKey);                                       // Key Schedule Computed Once Per Key
+    UDS_CMACRestart(_Context);
+    UDS_AESEncrypt(_Context->RoundKey, _Context->State);                              // L = AES(K, 0)
+    UDS_CMACSubkey(_Context->State, _Context->K1);
+    UDS_CMACSubkey(_Context->K1, _Context->K2);
+    UDS_CMACRestart(_Context);
+}
+/* ---------------------------------------------------------------------------------------------------- */
+void UDS_CMACUpdate (UDS_CMACContext *_Context, const uint8_t *_Data, uint16_t _Length) {
+    uint16_t i = 0;
+    while (i < _Length) {
+      if (_Context->Fill == UDS_CryptoBlockSize) {                                    // More Data, Pending Block Is Not Last
+        uint8_t j = 0;
+        while (j < UDS_CryptoBlockSize) {
+          _Context->State[j] ^= _Context->Block[j];
+          j++;
+        }
+        UDS_AESEncrypt(_Context->RoundKey, _Context->State);
+        _Context->Fill = 0;
+      }
+      _Context->Block[_Context->Fill++] = _Data[i];
+      i++;
+    }
+}
+/* ---------------------------------------------------------------------------------------------------- */
+void UDS_CMACFinish (UDS_CMACContext *_Context, uint8_t *_MAC) {
+    const uint8_t *_Subkey = _Context->K1;
+    if (_Context->Fill < UDS_CryptoBlockSize) {                                       // Incomplete Last Block Padded
+      _Context->Block[_Context->Fill++] = 0x80;
+      while (_Context->Fill < UDS_CryptoBlockSize) {
+        _Context->Block[_Context->Fill++] = 0x00;
+      }
+      _Subkey = _Context->K2;
+    }
+    uint8_t i = 0;
+    while (i < UDS_CryptoBlockSize) {
+      _MAC[i] = _Context->State[i] ^ _Context->Block[i] ^ _Subkey[i];
+      i++;
+    }
+    UDS_AESEncrypt(_Context->RoundKey, _MAC);
+    _Context->Fill = 0;
+}
+/* ==================================================================================================== */
+
+
+/* ==================================================================================================== */
+/*
+ *  Backend Selection
+ *
+ *  Point UDS_Crypto At Another UDS_CryptoBackend To Use A Hardware Engine
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+const UDS_CryptoBackend UDS_CryptoSoftware = {
+    UDS_CMACStart,
+    UDS_CMACRestart,
+    UDS_CMACUpdate,
+    UDS_CMACFinish,
+    UDS_PlatformRandom
+};
+const UDS_CryptoBackend *UDS_Crypto = &UDS_CryptoSoftware;
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t UDS_CryptoCompare (const uint8_t *_A, const uint8_t *_B, uint8_t _Length) {
+    uint8_t _Difference = 0;
+    uint8_t i = 0;
+    while (i < _Length) {                                                             // Constant Time Compare
+      _Difference |= _A[i] ^ _B[i];
+      i++;
+    }
+    return _Difference ? 1 : 0;                                                       // Zero When Equal
+}
+/* ==================================================================================================== */
+
+
+
+#endif
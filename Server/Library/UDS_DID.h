@@ -1,11 +1,11 @@
 /* ==================================================================================================== */
 /*
- *  UDS.h
- *  Unified Diagnostics Services on CAN (UDSonCAN)
+ *  UDS_DID.h
+ *  Unified Diagnostics Services on CAN (UDSonCAN) - Data Identifiers
  *    ISO: 14229 Part 1   - Diagonostics Services
  *    ISO: 14229 Part 2   - Timing
  *    ISO: 14229 Part 3   - CAN
- *  Version: v1.0:0
+ *  Version: v1.1:0
  */
 /* ==================================================================================================== */
 
@@ -16,6 +16,392 @@
 
 
 
+#ifndef UDSIOControlParameters                                                        // UDS Input Output Control Parameters
+  #define UDSIOControlParameters
+  #define UDS_IOReturnControlToECU    0x00                                            // UDS IOCP Return Control To ECU
+  #define UDS_IOResetToDefault        0x01                                            // UDS IOCP Reset To Default
+  #define UDS_IOFreezeCurrentState    0x02                                            // UDS IOCP Freeze Current State
+  #define UDS_IOShortTermAdjustment   0x03                                            // UDS IOCP Short Term Adjustment
+#endif
 
+#ifndef UDSDataIdentifierAccess                                                       // UDS Data Identifier Access Rights
+  #define UDSDataIdentifierAccess
+  #define UDS_DIDRead                 0x01                                            // UDS DID Readable (0x22)
+  #define UDS_DIDWrite                0x02                                            // UDS DID Writable (0x2E)
+#endif
 
-#endif
\ No newline at end of file
+
+// UDS Data Identifier Record
+typedef struct {
+    uint16_t DID;                                                                     // UDS Data Identifier
+    uint8_t Length;                                                                   // UDS Data Record Length
+    uint8_t Access;                                                                   // UDS Data Access Rights
+    uint8_t * Data;                                                                   // UDS Data Record Storage
+} UDS_DIDRecord;
+extern const UDS_DIDRecord UDS_DIDTable[UDS_DIDCount];
+extern volatile uint32_t UDS_DIDDirty;                                                // UDS Changed Bit Per DID (Set By Writers)
+
+// UDS Input Output Control Override Entry
+typedef struct {
+    uint16_t DID;                                                                     // UDS Signal Data Identifier
+    uint8_t State;                                                                    // UDS Signal Control State (Last IOCP Applied)
+    uint16_t Shadow;                                                                  // UDS Signal Shadow Value Seen By Application
+} UDS_IOControlEntry;
+extern UDS_IOControlEntry UDS_IOControlTable[UDS_IOSignalCount];
+extern const uint16_t UDS_IOControlDefault[UDS_IOSignalCount];
+extern volatile uint32_t UDS_IOOverride;                                              // UDS Override Bit Per Signal (Active High)
+
+
+extern uint16_t UDS_IOCurrentValue (uint8_t _Index);                                  // Supplied By Application : Live Signal Value
+extern uint8_t UDS_DIDIndex (uint16_t _DID);
+extern void UDS_DIDMarkChanged (uint16_t _DID);
+extern uint16_t UDS_DIDLoad (uint8_t _Index, uint16_t _Offset);
+extern uint8_t UDS_ReadDataIdentifier (void);
+extern uint8_t UDS_WriteDataIdentifier (void);
+extern void UDS_IOControlRelease (void);
+extern uint8_t UDS_IOControlIndex (uint16_t _DID);
+extern uint8_t UDS_InputOutputControl (void);
+
+
+/* ---------------------------------------------------------------------------------------------------- */
+/*
+ *  static inline void UDS_DIDChanged (uint8_t _Index)
+ *
+ *  Writer Side Change Marking, Lets Event Detection Skip Comparing Values Every Tick
+ *  Task Context Only, The Bit Update Runs Inside The Port Critical Section
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+static inline void UDS_DIDChanged (uint8_t _Index) {
+    UDS_PortEnterCritical();
+    UDS_DIDDirty |= (1UL << _Index);                                                  // Changed Bit Set
+    UDS_PortExitCritical();
+}
+/* ---------------------------------------------------------------------------------------------------- */
+/*
+ *  static inline uint16_t UDS_IOSignal (uint8_t _Index, uint16_t _Value)
+ *
+ *  Application Read Accessor, Costs A Single Bit Test While The Signal Is Not Overridden
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+static inline uint16_t UDS_IOSignal (uint8_t _Index, uint16_t _Value) {
+    if (UDS_IOOverride & (1UL << _Index)) {                                           // Override Bit Check
+        return UDS_IOControlTable[_Index].Shadow;                                     // Tester Controlled Value
+    }
+    return _Value;                                                                    // Application Value
+}
+
+
+
+
+
+
+
+/* ==================================================================================================== */
+/*
+ *  UDS_DID.c
+ *  Unified Diagnostics Services on CAN (UDSonCAN) - Data Identifiers
+ *  Version: v1.1:0
+ */
+/* ==================================================================================================== */
+
+
+uint8_t UDS_DIDVIN[UDS_DIDVINLength] = {0};
+uint8_t UDS_DIDStatus[UDS_DIDStatusLength] = {0};
+uint8_t UDS_DIDBlock[UDS_DIDBlockLength] = {0};
+
+const UDS_DIDRecord UDS_DIDTable[UDS_DIDCount] = {
+    {0xF186, 1u, UDS_DIDRead, &UDS_Server.Session},                                   // Active Diagnostic Session
+    {0xF190, UDS_DIDVINLength, UDS_DIDRead | UDS_DIDWrite, UDS_DIDVIN},               // Vehicle Identification Number
+    {0x0100, UDS_DIDStatusLength, UDS_DIDRead | UDS_DIDWrite, UDS_DIDStatus},         // Application Status Record
+    {0x0200, UDS_DIDBlockLength, UDS_DIDRead | UDS_DIDWrite, UDS_DIDBlock},           // Application Data Block (Segmented)
+#ifdef UDS_EnableMetrics
+    {UDS_MetricsDID, UDS_MetricsLength, UDS_DIDRead, UDS_MetricsRecord},              // Server Metrics (Packed On Read)
+#endif
+};
+volatile uint32_t UDS_DIDDirty = 0u;
+
+UDS_IOControlEntry UDS_IOControlTable[UDS_IOSignalCount] = {
+    {_UDS_IO1_DID, UDS_IOReturnControlToECU, _UDS_IO1_Default},
+    {_UDS_IO2_DID, UDS_IOReturnControlToECU, _UDS_IO2_Default},
+    {_UDS_IO3_DID, UDS_IOReturnControlToECU, _UDS_IO3_Default},
+    {_UDS_IO4_DID, UDS_IOReturnControlToECU, _UDS_IO4_Default},
+};
+const uint16_t UDS_IOControlDefault[UDS_IOSignalCount] = {
+    _UDS_IO1_Default, _UDS_IO2_Default, _UDS_IO3_Default, _UDS_IO4_Default,
+};
+volatile uint32_t UDS_IOOverride = 0u;
+
+
+/* ==================================================================================================== */
+/*
+ *  Data Identifier Table
+ *
+ *  uint8_t UDS_DIDIndex (uint16_t _DID)
+ *  void UDS_DIDMarkChanged (uint16_t _DID)
+ *  uint16_t UDS_DIDLoad (uint8_t _Index, uint16_t _Offset)
+ *
+ *  UDS Server Data Identifier Lookup, Change Marking & Response Loading
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t UDS_DIDIndex (uint16_t _DID) {
+    uint8_t i = 0;
+    while (i < UDS_DIDCount) {                                                        // DID Table Search Loop
+      if (UDS_DIDTable[i].DID == _DID) {
+        return i;                                                                     // DID Index Found
+      }
+      i++;
+    }
+    return 0xFF;                                                                      // DID Not Supported
+}
+/* ---------------------------------------------------------------------------------------------------- */
+void UDS_DIDMarkChanged (uint16_t _DID) {
+    uint8_t _Index = UDS_DIDIndex(_DID);                                              // Looking Up DID
+    if (_Index != 0xFF) {
+      UDS_DIDChanged(_Index);                                                         // Changed Bit Set
+      UDS_PortWake();                                                                 // Sleeping Server Woken For ROE
+    }
+}
+/* ---------------------------------------------------------------------------------------------------- */
+uint16_t UDS_DIDLoad (uint8_t _Index, uint16_t _Offset) {
+    const UDS_DIDRecord * _Record = &UDS_DIDTable[_Index];
+    if ((_Offset + 2u + _Record->Length) > UDS_ParaBufferSize) {                      // Response Buffer Space Check
+      return 0;                                                                       // Response Too Long
+    }
+    Number16Bit _DID;
+    _DID.Raw = _Record->DID;
+    UDS_MetricsLoad(_DID.Raw);                                                        // Metrics Record Packed Before Copy
+    UDS_Message.Data[_Offset++] = _DID.Byte.B1;                                       // DID High Loaded
+    UDS_Message.Data[_Offset++] = _DID.Byte.B0;                                       // DID Low Loaded
+    uint8_t i = 0;
+    while (i < _Record->Length) {
+      UDS_Message.Data[_Offset++] = _Record->Data[i];                                 // Data Record Loaded
+      i++;
+    }
+    return _Offset;                                                                   // Next Free Response Index
+}
+/* ==================================================================================================== */
+
+
+/* ==================================================================================================== */
+/*
+ *  UDS Read Data By Identifier
+ *
+ *  uint8_t UDS_ReadDataIdentifier (void)
+ *
+ *  UDS Server Service 0x22 : Read Data By Identifier
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t UDS_ReadDataIdentifier (void) {
+    uint8_t _SID = UDS_Message.Data[0];                                               // Extracting SID
+    uint16_t _Length = UDS_Message.Length;                                            // Request Length Kept
+    uint8_t _Requested[UDS_DIDCount];                                                 // DID Indexes Requested
+    uint8_t _Count = 0;
+
+    if ((_Length < 3) || ((_Length - 1) & 0x01) || ((uint16_t)((_Length - 1) >> 1) > UDS_DIDCount)) {
+        TP_SendNegativeResponse(UDS_NRC_IMLIF, _SID, 'P');                            // NRC : Incorrect Message Length or Invalid Format
+        UDS_Server.Status = UDS_ServerFree;                                           // UDS Server Status Set To Free
+        return 0;
+    }
+
+    uint16_t i = 1;
+    while (i < _Length) {                                                             // Request DIDs Are Resolved Before Buffer Is Reused
+      Number16Bit _DID;
+      _DID.Byte.B1 = UDS_Message.Data[i];                                             // Extracting DID High
+      _DID.Byte.B0 = UDS_Message.Data[i + 1];                                         // Extracting DID Low
+      uint8_t _Index = UDS_DIDIndex(_DID.Raw);
+      if ((_Index == 0xFF) || !(UDS_DIDTable[_Index].Access & UDS_DIDRead)) {         // DID Supported And Readable Check
+          TP_SendNegativeResponse(UDS_NRC_ROOR, _SID, 'P');                           // NRC : Request Out Of Range
+          UDS_Server.Status = UDS_ServerFree;                                         // UDS Server Status Set To Free
+          return 0;
+      }
+      _Requested[_Count++] = _Index;
+      i = i + 2;
+    }
+
+    uint16_t _Offset = 1;
+    UDS_Message.Data[0] = 0x62;                                                       // Positive Response SID
+    i = 0;
+    while (i < _Count) {
+      _Offset = UDS_DIDLoad(_Requested[i], _Offset);                                  // DID And Data Record Loaded
+      if (_Offset == 0) {
+          TP_SendNegativeResponse(UDS_NRC_RTL, _SID, 'P');                            // NRC : Response Too Long
+          UDS_Server.Status = UDS_ServerFree;                                         // UDS Server Status Set To Free
+          return 0;
+      }
+      i++;
+    }
+    UDS_Message.Length = _Offset;                                                     // Response Length Loaded
+    TP_TxFrameUSDT('P');                                                              // Sending Response Frame
+    return 1;
+}
+/* ==================================================================================================== */
+
+
+/* ==================================================================================================== */
+/*
+ *  UDS Write Data By Identifier
+ *
+ *  uint8_t UDS_WriteDataIdentifier (void)
+ *
+ *  UDS Server Service 0x2E : Write Data By Identifier
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t UDS_WriteDataIdentifier (void) {
+    uint8_t _SID = UDS_Message.Data[0];                                               // Extracting SID
+    if (UDS_Message.Length < 4) {                                                     // Minimum Payload Length Check, Before DID Is Read
+        TP_SendNegativeResponse(UDS_NRC_IMLIF, _SID, 'P');                            // NRC : Incorrect Message Length or Invalid Format
+        UDS_Server.Status = UDS_ServerFree;                                           // UDS Server Status Set To Free
+        return 0;
+    }
+
+    Number16Bit _DID;
+    _DID.Byte.B1 = UDS_Message.Data[1];                                               // Extracting DID High
+    _DID.Byte.B0 = UDS_Message.Data[2];                                               // Extracting DID Low
+    uint8_t _Index = UDS_DIDIndex(_DID.Raw);                                          // Looking Up DID
+
+    if ((_Index == 0xFF) || !(UDS_DIDTable[_Index].Access & UDS_DIDWrite)) {          // DID Supported And Writable Check
+        TP_SendNegativeResponse(UDS_NRC_ROOR, _SID, 'P');                             // NRC : Request Out Of Range
+        UDS_Server.Status = UDS_ServerFree;                                           // UDS Server Status Set To Free
+        return 0;
+    }
+    if (UDS_Message.Length != (3u + UDS_DIDTable[_Index].Length)) {                   // Expected Payload Length Check
+        TP_SendNegativeResponse(UDS_NRC_IMLIF, _SID, 'P');                            // NRC : Incorrect Message Length or Invalid Format
+        UDS_Server.Status = UDS_ServerFree;                                           // UDS Server Status Set To Free
+        return 0;
+    }
+
+    uint8_t i = 0;
+    while (i < UDS_DIDTable[_Index].Length) {
+      UDS_DIDTable[_Index].Data[i] = UDS_Message.Data[i + 3];                         // Data Record Stored
+      i++;
+    }
+    UDS_DIDChanged(_Index);                                                           // Writer Marks DID Changed
+
+    UDS_Message.Length = 3;                                                           // TML Suggested
+    UDS_Message.Data[0] = 0x6E;                                                       // Positive Response SID
+    TP_TxFrameUSDT('P');                                                              // Sending Response Frame (DID Echoed In Place)
+    return 1;
+}
+/* ==================================================================================================== */
+
+
+/* ==================================================================================================== */
+/*
+ *  Input Output Control Override Table
+ *
+ *  void UDS_IOControlRelease (void)
+ *  uint8_t UDS_IOControlIndex (uint16_t _DID)
+ *
+ *  UDS Server Override Table Management
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+void UDS_IOControlRelease (void) {
+    UDS_IOOverride = 0u;                                                              // All Signals Back To Application
+    uint8_t i = 0;
+    while (i < UDS_IOSignalCount) {
+      UDS_IOControlTable[i].State = UDS_IOReturnControlToECU;                         // Control State Reset
+      i++;
+    }
+}
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t UDS_IOControlIndex (uint16_t _DID) {
+    uint8_t i = 0;
+    while (i < UDS_IOSignalCount) {                                                   // Override Table Search Loop
+      if (UDS_IOControlTable[i].DID == _DID) {
+        return i;                                                                     // Signal Index Found
+      }
+      i++;
+    }
+    return 0xFF;                                                                      // DID Not Controllable
+}
+/* ==================================================================================================== */
+
+
+/* ==================================================================================================== */
+/*
+ *  UDS Input Output Control By Identifier
+ *
+ *  uint8_t UDS_InputOutputControl (void)
+ *
+ *  UDS Server Service 0x2F : Input Output Control By Identifier
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t UDS_InputOutputControl (void) {
+    uint8_t _SID = UDS_Message.Data[0];                                               // Extracting SID
+    if (UDS_Message.Length < 4) {                                                     // Minimum Payload Length Check, Before DID Is Read
+        TP_SendNegativeResponse(UDS_NRC_IMLIF, _SID, 'P');                            // NRC : Incorrect Message Length or Invalid Format
+        UDS_Server.Status = UDS_ServerFree;                                           // UDS Server Status Set To Free
+        return 0;
+    }
+
+    Number16Bit _DID;
+    _DID.Byte.B1 = UDS_Message.Data[1];                                               // Extracting DID High
+    _DID.Byte.B0 = UDS_Message.Data[2];                                               // Extracting DID Low
+    uint8_t _IOCP = UDS_Message.Data[3];                                              // Extracting Control Parameter
+    uint8_t _Index = UDS_IOControlIndex(_DID.Raw);                                    // Looking Up Override Entry
+
+    if (_Index == 0xFF) {                                                             // Checking if DID is Controllable
+        TP_SendNegativeResponse(UDS_NRC_ROOR, _SID, 'P');                             // NRC : Request Out Of Range
+        UDS_Server.Status = UDS_ServerFree;                                           // UDS Server Status Set To Free
+        return 0;
+    }
+
+    uint8_t _Length = (_IOCP == UDS_IOShortTermAdjustment) ? 6 : 4;                  // Control State Record Only For Adjustment
+    if (UDS_Message.Length != _Length) {                                              // Expected Payload Length Check
+        TP_SendNegativeResponse(UDS_NRC_IMLIF, _SID, 'P');                            // NRC : Incorrect Message Length or Invalid Format
+        UDS_Server.Status = UDS_ServerFree;                                           // UDS Server Status Set To Free
+        return 0;
+    }
+
+    UDS_IOControlEntry * _Entry = &UDS_IOControlTable[_Index];
+    uint32_t _Bit = 1UL << _Index;
+    switch (_IOCP) {
+      case UDS_IOReturnControlToECU : {                                               // Return Control To ECU
+        UDS_IOOverride &= ~_Bit;                                                      // Override Released
+        break;
+      }
+      case UDS_IOResetToDefault : {                                                   // Reset To Default
+        _Entry->Shadow = UDS_IOControlDefault[_Index];                                // Shadow Loaded With Default
+        UDS_IOOverride |= _Bit;                                                       // Override Engaged
+        break;
+      }
+      case UDS_IOFreezeCurrentState : {                                               // Freeze Current State
+        if (!(UDS_IOOverride & _Bit)) {                                               // Already Overridden Signals Stay As They Are
+          _Entry->Shadow = UDS_IOCurrentValue(_Index);                                // Shadow Loaded With Live Value
+        }
+        UDS_IOOverride |= _Bit;                                                       // Override Engaged
+        break;
+      }
+      case UDS_IOShortTermAdjustment : {                                              // Short Term Adjustment
+        Number16Bit _Value;
+        _Value.Byte.B1 = UDS_Message.Data[4];                                         // Control State High
+        _Value.Byte.B0 = UDS_Message.Data[5];                                         // Control State Low
+        _Entry->Shadow = _Value.Raw;                                                  // Shadow Loaded With Tester Value
+        UDS_IOOverride |= _Bit;                                                       // Override Engaged
+        break;
+      }
+      default : {
+        TP_SendNegativeResponse(UDS_NRC_ROOR, _SID, 'P');                             // NRC : Request Out Of Range
+        UDS_Server.Status = UDS_ServerFree;                                           // UDS Server Status Set To Free
+        return 0;
+      }
+    }
+    _Entry->State = _IOCP;                                                            // Control State Recorded
+
+    Number16Bit _State;
+    _State.Raw = UDS_IOSignal(_Index, UDS_IOCurrentValue(_Index));                    // Value Now Seen By Application
+    UDS_Message.Length = 6;                                                           // TML Suggested
+    UDS_Message.Data[0] = 0x6F;                                                       // Positive Response SID
+    UDS_Message.Data[1] = _DID.Byte.B1;                                               // Echo DID High
+    UDS_Message.Data[2] = _DID.Byte.B0;                                               // Echo DID Low
+    UDS_Message.Data[3] = _IOCP;                                                      // Echo Control Parameter
+    UDS_Message.Data[4] = _State.Byte.B1;                                             // Control State High
+    UDS_Message.Data[5] = _State.Byte.B0;                                             // Control State Low
+    TP_TxFrameUSDT('P');                                                              // Sending Response Frame
+    return 1;
+}
+/* ==================================================================================================== */
+
+
+
+#endif
@@ -0,0 +1,172 @@
+/* ==================================================================================================== */
+/*
+ *  UDS_Deadline.h
+ *  Unified Diagnostics Services on CAN (UDSonCAN) - Deadlines
+ *    Every Server Timer (S3, Security, N_Cr, N_Bs / FC.WAIT / STmin, ROE Window) Is One Slot In A Min Heap
+ *    Timers Are Armed When Their Clock Starts, Checked Only Through UDS_DeadlineDue And Never Rescanned
+ *    UDS_DeadlineNext Gives The Ticks Until The Earliest One, So The Platform Can Sleep Until Then
+ *  Version: v1.1:0
+ */
+/* ==================================================================================================== */
+
+#ifndef _UDS_Deadline
+#define _UDS_Deadline
+
+#include "UDS.h"
+
+
+
+#ifndef UDSDeadlineSlots                                                              // UDS Deadline Slots
+  #define UDSDeadlineSlots
+  #define UDS_DeadlineS3              0u                                              // Non Default Session Timeout
+  #define UDS_DeadlineSecurity        1u                                              // Unlocked Security Level Timeout
+  #define UDS_DeadlineRx              2u                                              // TP N_Cr
+  #define UDS_DeadlineTx              3u                                              // TP N_Bs, FC.WAIT Timeout Or STmin
+  #define UDS_DeadlineROE             4u                                              // ROE Event Window
+  #define UDS_DeadlineCount           5u
+#endif
+
+#ifndef UDSDeadlineParameters                                                         // UDS Deadline Parameters
+  #define UDSDeadlineParameters
+  #define UDS_DeadlineNone            0xFFFFFFFFu                                     // UDS Deadline Nothing Armed
+  #define UDS_DeadlineIdle            0xFF                                            // UDS Deadline Slot Not In Heap
+#endif
+
+
+// UDS Deadline Heap, Earliest Expiry At Heap[0]
+typedef struct {
+    uint32_t Expiry[UDS_DeadlineCount];                                               // UDS Deadline Expiry Tick Per Slot
+    uint8_t Heap[UDS_DeadlineCount];                                                  // UDS Deadline Slots In Heap Order
+    uint8_t Position[UDS_DeadlineCount];                                              // UDS Deadline Heap Index Per Slot (Idle When Off)
+    uint8_t Size;                                                                     // UDS Deadline Slots Armed
+} UDS_DeadlineHeap;
+extern UDS_DeadlineHeap UDS_Deadline;
+
+
+extern void UDS_DeadlineStart (void);
+extern void UDS_DeadlineArm (uint8_t _Slot, uint32_t _Time, uint32_t _Limit);
+extern void UDS_DeadlineCancel (uint8_t _Slot);
+extern uint8_t UDS_DeadlineDue (uint8_t _Slot, uint32_t _Time);
+extern uint32_t UDS_DeadlineNext (uint32_t _Time);
+
+
+
+
+
+
+
+/* ==================================================================================================== */
+/*
+ *  UDS_Deadline.c
+ *  Unified Diagnostics Services on CAN (UDSonCAN) - Deadlines
+ *  Version: v1.1:0
+ */
+/* ==================================================================================================== */
+
+UDS_DeadlineHeap UDS_Deadline = {0};
+
+
+/* ==================================================================================================== */
+/*
+ *  Deadline Heap
+ *
+ *  uint8_t UDS_DeadlineBefore (uint8_t _A, uint8_t _B)
+ *  void UDS_DeadlineSwap (uint8_t _I, uint8_t _J)
+ *  void UDS_DeadlineSift (uint8_t _Index)
+ *  void UDS_DeadlineStart (void)
+ *  void UDS_DeadlineArm (uint8_t _Slot, uint32_t _Time, uint32_t _Limit)
+ *  void UDS_DeadlineCancel (uint8_t _Slot)
+ *  uint8_t UDS_DeadlineDue (uint8_t _Slot, uint32_t _Time)
+ *  uint32_t UDS_DeadlineNext (uint32_t _Time)
+ *
+ *  A Timer Armed With _Limit Expires Once More Than _Limit Ticks Have Passed, Same As The Old Polled Checks
+ *  Expiry Ticks Are Compared As A Signed Difference, So The Heap Keeps Working Across Clock Wrap
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+static uint8_t UDS_DeadlineBefore (uint8_t _A, uint8_t _B) {
+    return ((int32_t)(UDS_Deadline.Expiry[UDS_Deadline.Heap[_A]] - UDS_Deadline.Expiry[UDS_Deadline.Heap[_B]]) < 0) ? 1 : 0;
+}
+/* ---------------------------------------------------------------------------------------------------- */
+static void UDS_DeadlineSwap (uint8_t _I, uint8_t _J) {
+    uint8_t _Slot = UDS_Deadline.Heap[_I];
+    UDS_Deadline.Heap[_I] = UDS_Deadline.Heap[_J];
+    UDS_Deadline.Heap[_J] = _Slot;
+    UDS_Deadline.Position[UDS_Deadline.Heap[_I]] = _I;
+    UDS_Deadline.Position[UDS_Deadline.Heap[_J]] = _J;
+}
+/* ---------------------------------------------------------------------------------------------------- */
+static void UDS_DeadlineSift (uint8_t _Index) {
+    while ((_Index > 0) && UDS_DeadlineBefore(_Index, (_Index - 1) / 2)) {            // Earlier Than Parent, Move Up
+      UDS_DeadlineSwap(_Index, (_Index - 1) / 2);
+      _Index = (_Index - 1) / 2;
+    }
+    for (;;) {                                                                        // Later Than A Child, Move Down
+      uint8_t _Least = _Index;
+      uint8_t _Child = (2 * _Index) + 1;
+      if ((_Child < UDS_Deadline.Size) && UDS_DeadlineBefore(_Child, _Least)) {
+        _Least = _Child;
+      }
+      _Child++;
+      if ((_Child < UDS_Deadline.Size) && UDS_DeadlineBefore(_Child, _Least)) {
+        _Least = _Child;
+      }
+      if (_Least == _Index) {
+        return;
+      }
+      UDS_DeadlineSwap(_Index, _Least);
+      _Index = _Least;
+    }
+}
+/* ---------------------------------------------------------------------------------------------------- */
+void UDS_DeadlineStart (void) {
+    for (uint8_t i = 0; i < UDS_DeadlineCount; i++) {
+      UDS_Deadline.Position[i] = UDS_DeadlineIdle;                                    // Every Slot Off
+    }
+    UDS_Deadline.Size = 0u;
+}
+/* ---------------------------------------------------------------------------------------------------- */
+void UDS_DeadlineArm (uint8_t _Slot, uint32_t _Time, uint32_t _Limit) {
+    UDS_Deadline.Expiry[_Slot] = _Time + _Limit + 1u;                                 // Due Once Elapsed Is Past Limit
+    uint8_t _Index = UDS_Deadline.Position[_Slot];
+    if (_Index == UDS_DeadlineIdle) {                                                 // New Slot Added At The Bottom
+      _Index = UDS_Deadline.Size++;
+      UDS_Deadline.Heap[_Index] = _Slot;
+      UDS_Deadline.Position[_Slot] = _Index;
+    }
+    UDS_DeadlineSift(_Index);                                                         // Rearmed Slot Moves Either Way
+}
+/* ---------------------------------------------------------------------------------------------------- */
+void UDS_DeadlineCancel (uint8_t _Slot) {
+    uint8_t _Index = UDS_Deadline.Position[_Slot];
+    if (_Index == UDS_DeadlineIdle) {                                                 // Already Off
+      return;
+    }
+    UDS_Deadline.Position[_Slot] = UDS_DeadlineIdle;
+    UDS_Deadline.Size--;
+    if (_Index == UDS_Deadline.Size) {                                                // Was The Last Heap Entry
+      return;
+    }
+    UDS_Deadline.Heap[_Index] = UDS_Deadline.Heap[UDS_Deadline.Size];                 // Last Entry Fills The Gap
+    UDS_Deadline.Position[UDS_Deadline.Heap[_Index]] = _Index;
+    UDS_DeadlineSift(_Index);
+}
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t UDS_DeadlineDue (uint8_t _Slot, uint32_t _Time) {
+    if (UDS_Deadline.Position[_Slot] == UDS_DeadlineIdle) {                           // Not Armed
+      return 0;
+    }
+    return ((int32_t)(_Time - UDS_Deadline.Expiry[_Slot]) >= 0) ? 1 : 0;
+}
+/* ---------------------------------------------------------------------------------------------------- */
+uint32_t UDS_DeadlineNext (uint32_t _Time) {
+    if (UDS_Deadline.Size == 0u) {                                                    // Nothing Armed
+      return UDS_DeadlineNone;
+    }
+    int32_t _Left = (int32_t)(UDS_Deadline.Expiry[UDS_Deadline.Heap[0]] - _Time);
+    return (_Left > 0) ? (uint32_t)_Left : 0u;
+}
+/* ==================================================================================================== */
+
+
+
+#endif
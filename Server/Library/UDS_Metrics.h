@@ -0,0 +1,190 @@
+/* ==================================================================================================== */
+/*
+ *  UDS_Metrics.h
+ *  Unified Diagnostics Services on CAN (UDSonCAN) - Server Metrics
+ *    Hot Path Counters For The Transport And Service Layers, Read Through A Vendor DID
+ *    Built Only With UDS_EnableMetrics Defined, Every Hook Expands To Nothing Otherwise
+ *  Version: v1.1:0
+ */
+/* ==================================================================================================== */
+
+#ifndef _UDS_Metrics
+#define _UDS_Metrics
+
+#include "UDS.h"
+
+
+
+#ifdef UDS_EnableMetrics
+
+#ifndef UDSMetricsParameters                                                          // UDS Metrics Parameters
+  #define UDSMetricsParameters
+  #define UDS_MetricsDID              0xFD00                                          // UDS Metrics Vendor Data Identifier
+  #define UDS_MetricsNRCSlots         8u                                              // UDS SIDs With Own NRC Count (Last Slot Takes The Rest)
+  #define UDS_MetricsOtherSID         0xFF                                            // UDS Metrics SID Reported For The Shared Slot
+#endif
+
+#ifndef UDSMetricsPCI                                                                 // UDS Metrics Frame Counter Index
+  #define UDSMetricsPCI
+  #define UDS_MetricsSF               0u                                              // Single Frame
+  #define UDS_MetricsFF               1u                                              // First Frame
+  #define UDS_MetricsCF               2u                                              // Consecutive Frame
+  #define UDS_MetricsFC               3u                                              // Flow Control Frame
+  #define UDS_MetricsInvalid          4u                                              // Reserved PCI
+  #define UDS_MetricsPCICount         5u
+#endif
+
+#ifndef UDS_MetricsClock                                                              // Tick Duration Clock, Finest The Platform Has
+  #ifdef _UDSonHost
+    #define UDS_MetricsClock()        ((uint32_t)Host_Micros())                       // Microseconds
+  #else
+    #define UDS_MetricsClock()        TP_Clock()                                      // Milliseconds
+  #endif
+#endif
+
+/*
+ *  Metrics Record (Big Endian), Read As DID UDS_MetricsDID
+ *    00  RX Frames  SF, FF, CF, FC, Invalid                          5 x 4 Bytes
+ *    20  TX Frames  SF, FF, CF, FC, Invalid                          5 x 4 Bytes
+ *    40  Dropped Frames (TP_MessageRX Overwritten Before Read)       4 Bytes
+ *    44  N_Bs Timeouts                                               4 Bytes
+ *    48  N_Cr Timeouts                                               4 Bytes
+ *    52  FC.WAIT Received                                            4 Bytes
+ *    56  Longest UDS_MainApp Tick (UDS_MetricsClock Units)           4 Bytes
+ *    60  ROE DTC Events Dropped On A Full Queue                      4 Bytes
+ *    64  Deepest Receive Queue                                       2 Bytes
+ *    66  NRC Slots  SID, Count                                       Slots x 3 Bytes
+ */
+#define UDS_MetricsLength             (66u + (3u * UDS_MetricsNRCSlots))              // UDS Metrics Record Length
+
+
+// UDS Server Metrics
+typedef struct {
+    uint32_t RxFrames[UDS_MetricsPCICount];                                           // Frames Accepted By CAN ID Per PCI
+    uint32_t TxFrames[UDS_MetricsPCICount];                                           // Frames Sent Per PCI
+    uint32_t Dropped;                                                                 // Frames Lost Before DoCAN Read Them
+    uint32_t TimeoutNBs;                                                              // Flow Control Never Came
+    uint32_t TimeoutNCr;                                                              // Consecutive Frame Never Came
+    uint32_t FlowWait;                                                                // FC.WAIT Received
+    uint32_t TickMax;                                                                 // Longest UDS_MainApp Tick
+    uint32_t ROEDropped;                                                              // ROE DTC Events Lost To A Full Queue
+    uint16_t QueueMax;                                                                // Deepest Platform Receive Queue
+    uint8_t NRCSID[UDS_MetricsNRCSlots];                                              // SID Owning Each NRC Slot (Zero When Free)
+    uint16_t NRCCount[UDS_MetricsNRCSlots];                                           // NRCs Sent Per Slot (Saturating)
+} UDS_MetricsBlock;
+extern UDS_MetricsBlock UDS_Metrics;
+extern uint8_t UDS_MetricsRecord[UDS_MetricsLength];
+
+
+extern void UDS_MetricsNRC (uint8_t _SID);
+extern void UDS_MetricsSnapshot (void);
+
+
+#define UDS_MetricsCount(_Field)      (UDS_Metrics._Field++)
+#define UDS_MetricsAdd(_Field, _Count) (UDS_Metrics._Field += (_Count))
+#define UDS_MetricsRxFrame(_PCI)      (UDS_Metrics.RxFrames[((_PCI) < UDS_MetricsInvalid) ? (_PCI) : UDS_MetricsInvalid]++)
+#define UDS_MetricsTxFrame(_PCI)      (UDS_Metrics.TxFrames[((_PCI) < UDS_MetricsInvalid) ? (_PCI) : UDS_MetricsInvalid]++)
+#define UDS_MetricsRxOverwrite()      do { if (TP_Status.RxFlag) { UDS_Metrics.Dropped++; } } while (0)
+#define UDS_MetricsCountNRC(_SID)     UDS_MetricsNRC(_SID)
+#define UDS_MetricsQueue(_Depth)      do { if ((_Depth) > UDS_Metrics.QueueMax) { UDS_Metrics.QueueMax = (uint16_t)(_Depth); } } while (0)
+#define UDS_MetricsTickStart()        uint32_t _MetricsTick = UDS_MetricsClock()
+#define UDS_MetricsTickEnd()          do { uint32_t _MetricsSpan = UDS_MetricsClock() - _MetricsTick;  \
+                                        if (_MetricsSpan > UDS_Metrics.TickMax) { UDS_Metrics.TickMax = _MetricsSpan; } } while (0)
+#define UDS_MetricsLoad(_DID)         do { if ((_DID) == UDS_MetricsDID) { UDS_MetricsSnapshot(); } } while (0)
+
+#else
+
+#define UDS_MetricsCount(_Field)      ((void)0)
+#define UDS_MetricsAdd(_Field, _Count) ((void)0)
+#define UDS_MetricsRxFrame(_PCI)      ((void)0)
+#define UDS_MetricsTxFrame(_PCI)      ((void)0)
+#define UDS_MetricsRxOverwrite()      ((void)0)
+#define UDS_MetricsCountNRC(_SID)     ((void)0)
+#define UDS_MetricsQueue(_Depth)      ((void)0)
+#define UDS_MetricsTickStart()        ((void)0)
+#define UDS_MetricsTickEnd()          ((void)0)
+#define UDS_MetricsLoad(_DID)         ((void)0)
+
+#endif
+
+
+
+
+
+
+
+/* ==================================================================================================== */
+/*
+ *  UDS_Metrics.c
+ *  Unified Diagnostics Services on CAN (UDSonCAN) - Server Metrics
+ *  Version: v1.1:0
+ */
+/* ==================================================================================================== */
+
+#ifdef UDS_EnableMetrics
+
+UDS_MetricsBlock UDS_Metrics = {0};
+uint8_t UDS_MetricsRecord[UDS_MetricsLength] = {0};
+
+
+/* ==================================================================================================== */
+/*
+ *  Metrics Collection & Report
+ *
+ *  void UDS_MetricsNRC (uint8_t _SID)
+ *  void UDS_MetricsSnapshot (void)
+ *
+ *  NRC Slots Are Handed Out To SIDs In The Order They First Fail
+ *  The Record Is Only Packed When The Metrics DID Is Read, Counting Stays A Plain Increment
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+void UDS_MetricsNRC (uint8_t _SID) {
+    uint8_t i = 0;
+    while (i < (UDS_MetricsNRCSlots - 1u)) {                                          // Own Slot Or First Free Slot
+      if ((UDS_Metrics.NRCSID[i] == _SID) || (UDS_Metrics.NRCCount[i] == 0u)) {
+        break;
+      }
+      i++;
+    }
+    UDS_Metrics.NRCSID[i] = (i == (UDS_MetricsNRCSlots - 1u)) ? UDS_MetricsOtherSID : _SID;
+    if (UDS_Metrics.NRCCount[i] != 0xFFFF) {                                          // Count Saturates
+      UDS_Metrics.NRCCount[i]++;
+    }
+}
+/* ---------------------------------------------------------------------------------------------------- */
+void UDS_MetricsSnapshot (void) {
+    uint8_t * _Record = UDS_MetricsRecord;
+    const uint32_t * _Words[] = {
+      &UDS_Metrics.RxFrames[0], &UDS_Metrics.RxFrames[1], &UDS_Metrics.RxFrames[2],
+      &UDS_Metrics.RxFrames[3], &UDS_Metrics.RxFrames[4],
+      &UDS_Metrics.TxFrames[0], &UDS_Metrics.TxFrames[1], &UDS_Metrics.TxFrames[2],
+      &UDS_Metrics.TxFrames[3], &UDS_Metrics.TxFrames[4],
+      &UDS_Metrics.Dropped, &UDS_Metrics.TimeoutNBs, &UDS_Metrics.TimeoutNCr,
+      &UDS_Metrics.FlowWait, &UDS_Metrics.TickMax, &UDS_Metrics.ROEDropped,
+    };
+    uint8_t i = 0;
+    while (i < (sizeof(_Words) / sizeof(_Words[0]))) {                                // Counters Packed Big Endian
+      uint32_t _Value = *_Words[i];
+      *_Record++ = (uint8_t)(_Value >> 24);
+      *_Record++ = (uint8_t)(_Value >> 16);
+      *_Record++ = (uint8_t)(_Value >> 8);
+      *_Record++ = (uint8_t)(_Value);
+      i++;
+    }
+    *_Record++ = (uint8_t)(UDS_Metrics.QueueMax >> 8);
+    *_Record++ = (uint8_t)(UDS_Metrics.QueueMax);
+    i = 0;
+    while (i < UDS_MetricsNRCSlots) {                                                 // NRC Slots Packed
+      *_Record++ = UDS_Metrics.NRCSID[i];
+      *_Record++ = (uint8_t)(UDS_Metrics.NRCCount[i] >> 8);
+      *_Record++ = (uint8_t)(UDS_Metrics.NRCCount[i]);
+      i++;
+    }
+}
+/* ==================================================================================================== */
+
+#endif
+
+
+
+#endif
@@ -0,0 +1,344 @@
+/* ==================================================================================================== */
+/*
+ *  UDS_ROE.h
+ *  Unified Diagnostics Services on CAN (UDSonCAN) - Response On Event
+ *    ISO: 14229 Part 1   - Diagonostics Services
+ *    ISO: 14229 Part 2   - Timing
+ *    ISO: 14229 Part 3   - CAN
+ *  Version: v1.1:0
+ */
+/* ==================================================================================================== */
+
+#ifndef _UDS_ROE
+#define _UDS_ROE
+
+#include "UDS.h"
+
+
+
+#ifndef UDSResponseOnEvent                                                            // UDS Response On Event Types
+  #define UDSResponseOnEvent
+  #define UDS_ROEStop                 0x00                                            // UDS ROE Stop Response On Event
+  #define UDS_ROEOnDTCStatusChange    0x01                                            // UDS ROE On DTC Status Change
+  #define UDS_ROEOnChangeOfDID        0x03                                            // UDS ROE On Change Of Data Identifier
+  #define UDS_ROEReportActivated      0x04                                            // UDS ROE Report Activated Events
+  #define UDS_ROEStart                0x05                                            // UDS ROE Start Response On Event
+  #define UDS_ROEClear                0x06                                            // UDS ROE Clear Response On Event
+  #define UDS_ROEStoreEvent           0x40                                            // UDS ROE Storage State Bit
+  #define UDS_ROEWindowInfinite       0x02                                            // UDS ROE Infinite Event Window
+  #define UDS_ROEWindowUnit           1000u                                           // UDS ROE Event Window Time Unit (TP_Clock Ticks)
+  #define UDS_ROEQueueSize            4u                                              // UDS ROE DTC Event Queue Depth (Power of 2)
+#endif
+
+UDS_StaticAssert((UDS_ROEQueueSize >= 2u) && (UDS_ROEQueueSize <= 256u) &&
+    ((UDS_ROEQueueSize & (UDS_ROEQueueSize - 1u)) == 0u), UDS_ConfigROEQueueNotPowerOf2);
+
+
+// UDS Response On Event Controller
+typedef struct {
+    uint8_t Active;                                                                   // UDS ROE Events Started (Active High)
+    uint8_t Stored;                                                                   // UDS ROE Events Survive Session Change (Active High)
+    uint8_t Window;                                                                   // UDS ROE Event Window Time
+    uint32_t WindowStart;                                                             // UDS ROE Event Window Start Time
+    uint32_t DIDMask;                                                                 // UDS ROE Watched DIDs (Bit Per DID Table Index)
+    uint8_t DTCMask;                                                                  // UDS ROE DTC Status Mask (Zero When Not Set Up)
+    uint8_t DTCReport;                                                                // UDS ROE Service To Respond To Report Type (0x19)
+    uint8_t QueueHead;                                                                // UDS ROE DTC Queue Read Index
+    uint8_t QueueTail;                                                                // UDS ROE DTC Queue Write Index
+    uint32_t Queue[UDS_ROEQueueSize];                                                 // UDS ROE DTC Queue (DTC << 8 | Status)
+} UDS_ROEController;
+extern UDS_ROEController UDS_ROE;
+
+
+extern void UDS_DTCStatusChanged (uint32_t _DTC, uint8_t _Old, uint8_t _New);         // Called By Application On DTC Status Update
+extern void UDS_ROERelease (void);
+extern void UDS_ROEProcess (void);
+extern uint8_t UDS_ResponseOnEvent (void);
+
+
+
+
+
+
+
+/* ==================================================================================================== */
+/*
+ *  UDS_ROE.c
+ *  Unified Diagnostics Services on CAN (UDSonCAN) - Response On Event
+ *  Version: v1.1:0
+ */
+/* ==================================================================================================== */
+
+
+UDS_ROEController UDS_ROE = {0};
+
+
+/* ==================================================================================================== */
+/*
+ *  Event Detection & Dispatch
+ *
+ *  void UDS_DTCStatusChanged (uint32_t _DTC, uint8_t _Old, uint8_t _New)
+ *  void UDS_ROERelease (void)
+ *  void UDS_ROEProcess (void)
+ *
+ *  DID Events Come From Writer Set Changed Bits, DTC Events From The Application Status Update
+ *  Event Responses Are Only Sent While No USDT Transfer Owns The Server
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+void UDS_DTCStatusChanged (uint32_t _DTC, uint8_t _Old, uint8_t _New) {
+    if (!(UDS_ROE.Active) || !(UDS_ROE.DTCMask)) {                                    // DTC Event Not Running
+      return;
+    }
+    if (!((_Old ^ _New) & _New & UDS_ROE.DTCMask)) {                                  // Only Rising Edges Of Masked Status Bits
+      return;
+    }
+    uint8_t _Next = (UDS_ROE.QueueTail + 1) & (UDS_ROEQueueSize - 1);
+    if (_Next == UDS_ROE.QueueHead) {                                                 // Queue Full, Oldest Event Kept
+      UDS_MetricsCount(ROEDropped);                                                   // Lost Event Counted
+      return;
+    }
+    UDS_ROE.Queue[UDS_ROE.QueueTail] = (_DTC << 8) | _New;                            // DTC Event Queued
+    UDS_ROE.QueueTail = _Next;
+    UDS_PortWake();                                                                   // Sleeping Server Woken For ROE
+}
+/* ---------------------------------------------------------------------------------------------------- */
+void UDS_ROERelease (void) {
+    if (UDS_ROE.Stored) {                                                             // Stored Events Survive Session Change
+      return;
+    }
+    UDS_ROE.Active = 0u;                                                              // Events Stopped
+    UDS_DeadlineCancel(UDS_DeadlineROE);                                              // Event Window Off
+    UDS_ROE.DIDMask = 0u;                                                             // DID Events Cleared
+    UDS_ROE.DTCMask = 0u;                                                             // DTC Event Cleared
+    UDS_ROE.QueueHead = UDS_ROE.QueueTail;                                            // DTC Queue Flushed
+}
+/* ---------------------------------------------------------------------------------------------------- */
+void UDS_ROEProcess (void) {
+    if (!(UDS_ROE.Active)) {                                                          // Nothing Started
+      return;
+    }
+    if (UDS_DeadlineDue(UDS_DeadlineROE, TP_Clock())) {                               // Finite Event Window Check
+      UDS_DeadlineCancel(UDS_DeadlineROE);
+      UDS_ROE.Active = 0u;                                                            // Event Window Closed
+      return;
+    }
+    if ((UDS_Server.Status != UDS_ServerFree) ||                                      // Queued Behind Requests And USDT Transfers
+          (TP_TxControl.Process != TP_TxProcessIdle)) {
+      return;
+    }
+
+    uint32_t _Pending = UDS_DIDDirty & UDS_ROE.DIDMask;                               // Changed And Watched DIDs
+    if (_Pending) {
+      uint8_t _Index = 0;
+      while (!(_Pending & 0x01)) {                                                    // Lowest Pending DID First
+        _Pending = _Pending >> 1;
+        _Index++;
+      }
+      UDS_PortEnterCritical();
+      UDS_DIDDirty &= ~(1UL << _Index);                                               // Changed Bit Consumed
+      UDS_PortExitCritical();
+      UDS_Message.Data[0] = 0x62;                                                     // Read Data By Identifier Response SID
+      UDS_Message.Length = UDS_DIDLoad(_Index, 1);                                    // DID And Data Record Loaded
+      if (UDS_Message.Length) {
+        TP_TxFrameUSDT('P');                                                          // Sending Event Response
+      }
+      return;
+    }
+
+    if (UDS_ROE.QueueHead != UDS_ROE.QueueTail) {                                     // DTC Event Pending
+      Number32Bit _Event;
+      _Event.Raw = UDS_ROE.Queue[UDS_ROE.QueueHead];
+      UDS_ROE.QueueHead = (UDS_ROE.QueueHead + 1) & (UDS_ROEQueueSize - 1);           // DTC Event Consumed
+      UDS_Message.Length = 7;                                                         // TML Suggested
+      UDS_Message.Data[0] = 0x59;                                                     // Read DTC Information Response SID
+      UDS_Message.Data[1] = UDS_ROE.DTCReport;                                        // Report Type
+      UDS_Message.Data[2] = UDS_ROE.DTCMask;                                          // DTC Status Availability Mask
+      UDS_Message.Data[3] = _Event.Byte.B3;                                           // DTC High Byte
+      UDS_Message.Data[4] = _Event.Byte.B2;                                           // DTC Middle Byte
+      UDS_Message.Data[5] = _Event.Byte.B1;                                           // DTC Low Byte
+      UDS_Message.Data[6] = _Event.Byte.B0;                                           // DTC Status
+      TP_TxFrameUSDT('P');                                                            // Sending Event Response
+    }
+}
+/* ==================================================================================================== */
+
+
+/* ==================================================================================================== */
+/*
+ *  UDS Response On Event
+ *
+ *  uint8_t UDS_ResponseOnEvent (void)
+ *
+ *  UDS Server Service 0x86 : Response On Event
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t UDS_ResponseOnEvent (void) {
+    uint8_t _SID = UDS_Message.Data[0];                                               // Extracting SID
+    uint8_t _Suppress = (UDS_Message.Data[1] & 0x80) ? 1 : 0;                         // Checking is Positive Response Is Suppressed
+    uint8_t _Store = (UDS_Message.Data[1] & UDS_ROEStoreEvent) ? 1 : 0;               // Extracting Storage State
+    uint8_t _SF = UDS_Message.Data[1] & 0x3F;                                         // Extracting Event Type
+    uint8_t _Window = (UDS_Message.Length > 2) ? UDS_Message.Data[2] : UDS_ROEWindowInfinite;
+    uint16_t _Length = 4;                                                             // Response Length Without Event Records
+
+    switch (_SF) {
+      case UDS_ROEStop : {                                                            // Stop Response On Event
+        if (UDS_Message.Length > 3) {                                                 // Expected Payload Length Check
+            TP_SendNegativeResponse(UDS_NRC_IMLIF, _SID, 'P');                        // NRC : Incorrect Message Length or Invalid Format
+            UDS_Server.Status = UDS_ServerFree;                                       // UDS Server Status Set To Free
+            return 0;
+        }
+        UDS_ROE.Active = 0u;                                                          // Events Stopped, Set Up Kept
+        UDS_DeadlineCancel(UDS_DeadlineROE);                                          // Event Window Off
+        break;
+      }
+      case UDS_ROEStart : {                                                           // Start Response On Event
+        if (UDS_Message.Length > 3) {                                                 // Expected Payload Length Check
+            TP_SendNegativeResponse(UDS_NRC_IMLIF, _SID, 'P');                        // NRC : Incorrect Message Length or Invalid Format
+            UDS_Server.Status = UDS_ServerFree;                                       // UDS Server Status Set To Free
+            return 0;
+        }
+        if (!(UDS_ROE.DIDMask) && !(UDS_ROE.DTCMask)) {                               // Nothing Set Up To Start
+            TP_SendNegativeResponse(UDS_NRC_RSE, _SID, 'P');                          // NRC : Request Sequence Error
+            UDS_Server.Status = UDS_ServerFree;                                       // UDS Server Status Set To Free
+            return 0;
+        }
+        UDS_PortEnterCritical();
+        UDS_DIDDirty &= ~UDS_ROE.DIDMask;                                             // Only Changes From Now On Are Events
+        UDS_PortExitCritical();
+        UDS_ROE.QueueHead = UDS_ROE.QueueTail;                                        // DTC Queue Flushed
+        UDS_ROE.WindowStart = TP_Clock();                                             // Event Window Opened
+        UDS_ROE.Active = 1u;                                                          // Events Started
+        if (UDS_ROE.Window != UDS_ROEWindowInfinite) {                                // Finite Event Window Timed
+          UDS_DeadlineArm(UDS_DeadlineROE, UDS_ROE.WindowStart, (uint32_t)UDS_ROE.Window * UDS_ROEWindowUnit);
+        } else {
+          UDS_DeadlineCancel(UDS_DeadlineROE);
+        }
+        break;
+      }
+      case UDS_ROEClear : {                                                           // Clear Response On Event
+        if (UDS_Message.Length > 3) {                                                 // Expected Payload Length Check
+            TP_SendNegativeResponse(UDS_NRC_IMLIF, _SID, 'P');                        // NRC : Incorrect Message Length or Invalid Format
+            UDS_Server.Status = UDS_ServerFree;                                       // UDS Server Status Set To Free
+            return 0;
+        }
+        UDS_ROE.Stored = 0u;                                                          // Storage Dropped
+        UDS_ROERelease();                                                             // Events Cleared
+        break;
+      }
+      case UDS_ROEOnDTCStatusChange : {                                               // On DTC Status Change
+        if ((UDS_Message.Length != 6) || (UDS_Message.Data[4] != 0x19)) {             // Event And Service To Respond To Record Check
+            TP_SendNegativeResponse(UDS_NRC_IMLIF, _SID, 'P');                        // NRC : Incorrect Message Length or Invalid Format
+            UDS_Server.Status = UDS_ServerFree;                                       // UDS Server Status Set To Free
+            return 0;
+        }
+        if (UDS_Message.Data[3] == 0) {                                               // Empty Status Mask Never Fires
+            TP_SendNegativeResponse(UDS_NRC_ROOR, _SID, 'P');                         // NRC : Request Out Of Range
+            UDS_Server.Status = UDS_ServerFree;                                       // UDS Server Status Set To Free
+            return 0;
+        }
+        UDS_ROE.DTCMask = UDS_Message.Data[3];                                        // DTC Status Mask Loaded
+        UDS_ROE.DTCReport = UDS_Message.Data[5];                                      // Report Type Loaded
+        UDS_ROE.Window = _Window;                                                     // Event Window Loaded
+        UDS_ROE.Stored = _Store;                                                      // Storage State Loaded
+        UDS_Message.Data[4] = UDS_ROE.DTCMask;                                        // Echo Event Type Record
+        UDS_Message.Data[5] = 0x19;                                                   // Echo Service To Respond To
+        UDS_Message.Data[6] = UDS_ROE.DTCReport;                                      // Echo Report Type
+        _Length = 7;
+        break;
+      }
+      case UDS_ROEOnChangeOfDID : {                                                   // On Change Of Data Identifier
+        if ((UDS_Message.Length != 8) || (UDS_Message.Data[5] != 0x22) ||             // Event And Service To Respond To Record Check
+              (UDS_Message.Data[3] != UDS_Message.Data[6]) || (UDS_Message.Data[4] != UDS_Message.Data[7])) {
+            TP_SendNegativeResponse(UDS_NRC_IMLIF, _SID, 'P');                        // NRC : Incorrect Message Length or Invalid Format
+            UDS_Server.Status = UDS_ServerFree;                                       // UDS Server Status Set To Free
+            return 0;
+        }
+        Number16Bit _DID;
+        _DID.Byte.B1 = UDS_Message.Data[3];                                           // Extracting DID High
+        _DID.Byte.B0 = UDS_Message.Data[4];                                           // Extracting DID Low
+        uint8_t _Index = UDS_DIDIndex(_DID.Raw);
+        if ((_Index == 0xFF) || !(UDS_DIDTable[_Index].Access & UDS_DIDRead)) {       // DID Supported And Readable Check
+            TP_SendNegativeResponse(UDS_NRC_ROOR, _SID, 'P');                         // NRC : Request Out Of Range
+            UDS_Server.Status = UDS_ServerFree;                                       // UDS Server Status Set To Free
+            return 0;
+        }
+        UDS_ROE.DIDMask |= (1UL << _Index);                                           // DID Watched
+        UDS_PortEnterCritical();
+        UDS_DIDDirty &= ~(1UL << _Index);                                             // Old Changes Are Not Events
+        UDS_PortExitCritical();
+        UDS_ROE.Window = _Window;                                                     // Event Window Loaded
+        UDS_ROE.Stored = _Store;                                                      // Storage State Loaded
+        UDS_Message.Data[4] = _DID.Byte.B1;                                           // Echo Event Type Record DID High
+        UDS_Message.Data[5] = _DID.Byte.B0;                                           // Echo Event Type Record DID Low
+        UDS_Message.Data[6] = 0x22;                                                   // Echo Service To Respond To
+        UDS_Message.Data[7] = _DID.Byte.B1;                                           // Echo Service To Respond To DID High
+        UDS_Message.Data[8] = _DID.Byte.B0;                                           // Echo Service To Respond To DID Low
+        _Length = 9;
+        break;
+      }
+      case UDS_ROEReportActivated : {                                                 // Report Activated Events
+        if (UDS_Message.Length != 2) {                                                // Expected Payload Length Check
+            TP_SendNegativeResponse(UDS_NRC_IMLIF, _SID, 'P');                        // NRC : Incorrect Message Length or Invalid Format
+            UDS_Server.Status = UDS_ServerFree;                                       // UDS Server Status Set To Free
+            return 0;
+        }
+        uint16_t _Offset = 3;
+        uint8_t _Events = 0;
+        if (UDS_ROE.Active) {
+          uint8_t i = 0;
+          while (i < UDS_DIDCount) {                                                  // One Record Per Watched DID
+            if (UDS_ROE.DIDMask & (1UL << i)) {
+              Number16Bit _DID;
+              _DID.Raw = UDS_DIDTable[i].DID;
+              UDS_Message.Data[_Offset++] = UDS_ROEOnChangeOfDID;                     // Event Type
+              UDS_Message.Data[_Offset++] = UDS_ROE.Window;                           // Event Window Time
+              UDS_Message.Data[_Offset++] = _DID.Byte.B1;                             // Event Type Record DID High
+              UDS_Message.Data[_Offset++] = _DID.Byte.B0;                             // Event Type Record DID Low
+              UDS_Message.Data[_Offset++] = 0x22;                                     // Service To Respond To
+              UDS_Message.Data[_Offset++] = _DID.Byte.B1;                             // Service To Respond To DID High
+              UDS_Message.Data[_Offset++] = _DID.Byte.B0;                             // Service To Respond To DID Low
+              _Events++;
+            }
+            i++;
+          }
+          if (UDS_ROE.DTCMask) {                                                      // DTC Event Record
+            UDS_Message.Data[_Offset++] = UDS_ROEOnDTCStatusChange;                   // Event Type
+            UDS_Message.Data[_Offset++] = UDS_ROE.Window;                             // Event Window Time
+            UDS_Message.Data[_Offset++] = UDS_ROE.DTCMask;                            // Event Type Record
+            UDS_Message.Data[_Offset++] = 0x19;                                       // Service To Respond To
+            UDS_Message.Data[_Offset++] = UDS_ROE.DTCReport;                          // Report Type
+            _Events++;
+          }
+        }
+        UDS_Message.Length = _Offset;                                                 // Response Length Loaded
+        UDS_Message.Data[0] = 0xC6;                                                   // Positive Response SID
+        UDS_Message.Data[1] = UDS_ROEReportActivated;                                 // Echo Event Type
+        UDS_Message.Data[2] = _Events;                                                // Number Of Activated Events
+        TP_TxFrameUSDT('P');                                                          // Sending Response Frame
+        return 1;
+      }
+      default : {
+        TP_SendNegativeResponse(UDS_NRC_SFNS, _SID, 'P');                             // NRC : Sub Function Not Supported
+        UDS_Server.Status = UDS_ServerFree;                                           // UDS Server Status Set To Free
+        return 0;
+      }
+    }
+
+    if (_Suppress) {                                                                  // Checking if Positive Response is Suppressed
+        UDS_Server.Status = UDS_ServerFree;                                           // UDS Server Status Set To Free
+        return 1;                                                                     // Returning All OK
+    } else {                                                                          // Frame Building
+      UDS_Message.Length = _Length;                                                   // TML Suggested
+      UDS_Message.Data[0] = 0xC6;                                                     // Positive Response SID
+      UDS_Message.Data[1] = _SF | (_Store ? UDS_ROEStoreEvent : 0);                   // Echo Event Type
+      UDS_Message.Data[2] = 0x00;                                                     // Number Of Identified Events
+      UDS_Message.Data[3] = _Window;                                                  // Echo Event Window Time
+      TP_TxFrameUSDT('P');                                                            // Sending Response Frame
+      return 1;
+    }
+}
+/* ==================================================================================================== */
+
+
+
+#endif
@@ -0,0 +1,195 @@
+/* ==================================================================================================== */
+/*
+ *  UDS_Trace.h
+ *  Unified Diagnostics Services on CAN (UDSonCAN) - Frame Trace
+ *    Every CAN Frame In And Out Of DoCAN Is Copied Into A Binary Ring, Nothing Is Formatted Inline
+ *    UDS_TraceDrain Empties The Ring From Idle Time (Main Loop Or Idle Priority Task) Through UDS_TracePut
+ *    Built Only With UDS_EnableTrace Defined, Every Hook Expands To Nothing Otherwise
+ *  Version: v1.1:0
+ */
+/* ==================================================================================================== */
+
+#ifndef _UDS_Trace
+#define _UDS_Trace
+
+#include "UDS.h"
+
+
+
+#ifdef UDS_EnableTrace
+
+#ifndef UDSTraceParameters                                                            // UDS Trace Parameters
+  #define UDSTraceParameters
+  #define UDS_TraceDepth              16u                                             // UDS Trace Records Buffered (Power of 2, Max 128)
+  #define UDS_TraceMarker             0xA7                                            // UDS Trace Record Start Byte On The Wire
+#endif
+
+#ifndef UDSTraceDirection                                                             // UDS Trace Record Direction
+  #define UDSTraceDirection
+  #define UDS_TraceRX                 'R'                                             // Frame Received By DoCAN
+  #define UDS_TraceTX                 'T'                                             // Frame Sent By DoCAN
+  #define UDS_TraceLost               'L'                                             // Records Lost To A Full Ring (Count In Time)
+#endif
+
+#ifndef UDS_TraceBarrier                                                              // UDS Trace Record Before Index Ordering
+  #if defined(__GNUC__) || defined(__clang__)
+    #define UDS_TraceBarrier()        __asm__ __volatile__("" ::: "memory")           // Compiler Keeps Record Access On Its Side Of The Index
+  #else
+    #define UDS_TraceBarrier()        ((void)0)                                       // Platform Defines One For Other Compilers
+  #endif
+#endif
+
+/*
+ *  Trace Record On The Wire (Big Endian), 17 Bytes
+ *    00  UDS_TraceMarker
+ *    01  Direction
+ *    02  Time (TP_Clock)                                             4 Bytes
+ *    06  CAN ID                                                      2 Bytes
+ *    08  Data                                                        8 Bytes
+ *    16  Sum Of Bytes 01 - 15
+ */
+#define UDS_TraceLength               17u                                             // UDS Trace Record Length On The Wire
+
+
+// UDS Trace Record
+typedef struct {
+    uint32_t Time;                                                                    // UDS Trace TP_Clock When Seen
+    uint16_t CANID;                                                                   // UDS Trace CAN ID
+    uint8_t Direction;                                                                // UDS Trace Direction
+    uint8_t Data[8];                                                                  // UDS Trace CAN Data
+} UDS_TraceRecord;
+
+// UDS Trace Ring, One Writer (DoCAN) And One Reader (Drain)
+typedef struct {
+    UDS_TraceRecord Record[UDS_TraceDepth];
+    volatile uint8_t Head;                                                            // UDS Trace Read Index (Drain Only)
+    volatile uint8_t Tail;                                                            // UDS Trace Write Index (DoCAN Only)
+    volatile uint16_t Lost;                                                           // UDS Trace Records Dropped (DoCAN Only)
+    uint16_t Reported;                                                                // UDS Trace Losses Already Sent (Drain Only)
+} UDS_TraceRing;
+extern UDS_TraceRing UDS_Trace;
+
+
+extern void UDS_TracePut (uint8_t _Byte);                                             // Supplied By Platform
+extern uint32_t TP_Clock (void);                                                      // Supplied By DoCAN
+extern void UDS_TraceFrame (uint8_t _Direction, uint16_t _CANID, const uint8_t *_Data);
+extern uint8_t UDS_TraceDrain (uint8_t _Records);
+
+
+#define UDS_TraceReceive()            UDS_TraceFrame(UDS_TraceRX, TP_MessageRX.CANID.Raw, TP_MessageRX.Data)
+#define UDS_TraceSend(_CANID, _D0, _D1, _D2, _D3, _D4, _D5, _D6, _D7)  \
+                                      do { const uint8_t _Trace[8] = {_D0, _D1, _D2, _D3, _D4, _D5, _D6, _D7};  \
+                                        UDS_TraceFrame(UDS_TraceTX, _CANID, _Trace); } while (0)
+
+#else
+
+#define UDS_TraceReceive()            ((void)0)
+#define UDS_TraceSend(_CANID, _D0, _D1, _D2, _D3, _D4, _D5, _D6, _D7)  ((void)0)
+
+#endif
+
+
+
+
+
+
+
+/* ==================================================================================================== */
+/*
+ *  UDS_Trace.c
+ *  Unified Diagnostics Services on CAN (UDSonCAN) - Frame Trace
+ *  Version: v1.1:0
+ */
+/* ==================================================================================================== */
+
+#ifdef UDS_EnableTrace
+
+UDS_TraceRing UDS_Trace = {0};
+
+
+/* ==================================================================================================== */
+/*
+ *  Trace Capture & Drain
+ *
+ *  void UDS_TraceFrame (uint8_t _Direction, uint16_t _CANID, const uint8_t *_Data)
+ *  void UDS_TraceEmit (uint8_t _Direction, uint32_t _Time, uint16_t _CANID, const uint8_t *_Data)
+ *  uint8_t UDS_TraceDrain (uint8_t _Records)
+ *
+ *  Capture Is A Copy Into The Ring, A Full Ring Drops The New Record And Counts It
+ *  The Drain Sends Whole Records, Up To _Records Per Call, And Reports Losses As Their Own Record
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+void UDS_TraceFrame (uint8_t _Direction, uint16_t _CANID, const uint8_t *_Data) {
+    uint8_t _Tail = UDS_Trace.Tail;
+    if ((uint8_t)(_Tail - UDS_Trace.Head) >= UDS_TraceDepth) {                        // Ring Full, Drain Behind
+      UDS_Trace.Lost++;
+      return;
+    }
+    UDS_TraceRecord * _Record = &UDS_Trace.Record[_Tail & (UDS_TraceDepth - 1)];
+    _Record->Time = TP_Clock();                                                       // Record Time Stamped
+    _Record->CANID = _CANID;
+    _Record->Direction = _Direction;
+    uint8_t i = 0;
+    while (i < 8) {
+      _Record->Data[i] = _Data[i];                                                    // Frame Data Copied
+      i++;
+    }
+    UDS_TraceBarrier();                                                               // Record Stored Before It Is Published
+    UDS_Trace.Tail = _Tail + 1;                                                       // Record Published To Drain
+}
+/* ---------------------------------------------------------------------------------------------------- */
+static void UDS_TraceEmit (uint8_t _Direction, uint32_t _Time, uint16_t _CANID, const uint8_t *_Data) {
+    uint8_t _Wire[UDS_TraceLength];
+    _Wire[0] = UDS_TraceMarker;
+    _Wire[1] = _Direction;
+    _Wire[2] = (uint8_t)(_Time >> 24);
+    _Wire[3] = (uint8_t)(_Time >> 16);
+    _Wire[4] = (uint8_t)(_Time >> 8);
+    _Wire[5] = (uint8_t)(_Time);
+    _Wire[6] = (uint8_t)(_CANID >> 8);
+    _Wire[7] = (uint8_t)(_CANID);
+    uint8_t _Sum = 0;
+    uint8_t i = 0;
+    while (i < 8) {
+      _Wire[i + 8] = _Data[i];
+      i++;
+    }
+    i = 1;
+    while (i < (UDS_TraceLength - 1)) {                                               // Sum Over Everything After The Marker
+      _Sum += _Wire[i];
+      i++;
+    }
+    _Wire[UDS_TraceLength - 1] = _Sum;
+    i = 0;
+    while (i < UDS_TraceLength) {
+      UDS_TracePut(_Wire[i]);                                                         // Record Out Through The Platform
+      i++;
+    }
+}
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t UDS_TraceDrain (uint8_t _Records) {
+    uint8_t _Sent = 0;
+    uint16_t _Lost = UDS_Trace.Lost;
+    if (_Lost != UDS_Trace.Reported) {                                                // Losses Since Last Report
+      const uint8_t _None[8] = {0};
+      UDS_TraceEmit(UDS_TraceLost, (uint16_t)(_Lost - UDS_Trace.Reported), 0u, _None);
+      UDS_Trace.Reported = _Lost;
+      _Sent++;
+    }
+    while ((_Sent < _Records) && (UDS_Trace.Head != UDS_Trace.Tail)) {                // Records Waiting
+      UDS_TraceBarrier();                                                             // Record Read After Its Index
+      const UDS_TraceRecord * _Record = &UDS_Trace.Record[UDS_Trace.Head & (UDS_TraceDepth - 1)];
+      UDS_TraceEmit(_Record->Direction, _Record->Time, _Record->CANID, _Record->Data);
+      UDS_TraceBarrier();                                                             // Record Sent Before Its Slot Is Freed
+      UDS_Trace.Head++;                                                               // Slot Handed Back To DoCAN
+      _Sent++;
+    }
+    return _Sent;
+}
+/* ==================================================================================================== */
+
+#endif
+
+
+
+#endif
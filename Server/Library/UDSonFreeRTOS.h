@@ -0,0 +1,147 @@
+/* ==================================================================================================== */
+/*
+ *  Section
+ *  Task Port
+ *
+ *  FreeRTOS Task Port, Built Only With UDS_EnableRTOSTask Defined
+ *    The CAN Receive Interrupt Hands Frames To RTOS_ReceiveFromISR, Which Queues Them And Notifies The Task
+ *    RTOS_Task Owns The Server : It Feeds DoCAN From The Queue, Runs UDS_MainApp And Then Sleeps
+ *      Until A Frame, An RTOS_Notify Or The Deadline From UDS_NextDeadline, Whichever Comes First
+ *    Nothing Polls, An Idle Server Stays Blocked Until S3 Or The Security Timeout Is Due
+ *    With UDS_EnableTrace, RTOS_TraceTask Drains The Trace Ring At Idle Priority
+ *
+ *  void RTOS_ReceiveFromISR (uint16_t _CANID, const uint8_t *_Data)
+ *  void RTOS_Notify (void)
+ *  void RTOS_Task (void *_Parameter)
+ *  void RTOS_TraceTask (void *_Parameter)
+ *  BaseType_t RTOS_Start (UBaseType_t _Priority)
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+#ifdef UDS_EnableRTOSTask
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+
+#ifndef RTOSTaskParameters                                                            // RTOS Task Parameters
+  #define RTOSTaskParameters
+  #define RTOS_RxDepth                32u                                             // RTOS Frames Queued From The CAN Interrupt
+  #define RTOS_StackDepth             512u                                            // RTOS UDS Task Stack (Words)
+  #define RTOS_TraceStackDepth        256u                                            // RTOS Trace Task Stack (Words)
+  #define RTOS_TraceBatch             4u                                              // RTOS Trace Records Sent Per Pass
+  #define RTOS_TracePeriod            10u                                             // RTOS Trace Task Sleep When Ring Empty (Ticks)
+#endif
+
+#define UDS_PortWake()                RTOS_Notify()                                   // DID And DTC Events Wake The UDS Task
+#define UDS_PortEnterCritical()       taskENTER_CRITICAL()                            // Shared Change Bits Updated Across Tasks
+#define UDS_PortExitCritical()        taskEXIT_CRITICAL()
+
+
+typedef struct {
+    uint16_t CANID;
+    uint8_t Data[8];
+} RTOS_CANFrame;
+
+typedef struct {
+    QueueHandle_t RxQueue;                                                            // RTOS Interrupt To Task Frames
+    TaskHandle_t Task;                                                                // RTOS UDS Task
+    volatile uint32_t Dropped;                                                        // RTOS Frames Lost To A Full Queue
+} RTOS_Platform;
+
+
+RTOS_Platform RTOS_State = {NULL, NULL, 0u};
+
+extern void UDS_InitApp (void);                                                       // Supplied By UDS
+extern void UDS_MainApp (void);                                                       // Supplied By UDS
+extern uint32_t UDS_NextDeadline (void);                                              // Supplied By UDS
+void RTOS_Notify (void);
+
+
+
+void RTOS_ReceiveFromISR (uint16_t _CANID, const uint8_t *_Data);
+void RTOS_ReceiveFromISR (uint16_t _CANID, const uint8_t *_Data) {
+    if ((RTOS_State.RxQueue == NULL) || (RTOS_State.Task == NULL)) {                  // Port Not Started
+      return;
+    }
+    RTOS_CANFrame _Frame;
+    _Frame.CANID = _CANID;
+    uint8_t i = 0;
+    while (i < 8) {
+      _Frame.Data[i] = _Data[i];
+      i++;
+    }
+    BaseType_t _Woken = pdFALSE;
+    if (xQueueSendFromISR(RTOS_State.RxQueue, &_Frame, &_Woken) != pdPASS) {          // Queue Full Check
+      RTOS_State.Dropped++;
+    }
+    vTaskNotifyGiveFromISR(RTOS_State.Task, &_Woken);                                 // UDS Task Woken
+    portYIELD_FROM_ISR(_Woken);
+}
+
+
+void RTOS_Notify (void) {
+    if (RTOS_State.Task != NULL) {                                                    // Application Side Wake (Task Context Only)
+      xTaskNotifyGive(RTOS_State.Task);
+    }
+}
+
+
+void RTOS_Task (void *_Parameter);
+void RTOS_Task (void *_Parameter) {
+    (void)_Parameter;
+    UDS_InitApp();
+    for (;;) {
+      if (!TP_Status.RxFlag) {                                                        // DoCAN Ready For The Next Frame
+        RTOS_CANFrame _Frame;
+        UDS_MetricsQueue(uxQueueMessagesWaiting(RTOS_State.RxQueue));                 // Receive Queue Depth Seen By The Server
+        if (xQueueReceive(RTOS_State.RxQueue, &_Frame, 0) == pdPASS) {
+          TP_ReceiveDataCAN(_Frame.CANID, _Frame.Data[0], _Frame.Data[1], _Frame.Data[2],
+                _Frame.Data[3], _Frame.Data[4], _Frame.Data[5], _Frame.Data[6], _Frame.Data[7]);
+        }
+      }
+      UDS_MainApp();
+      if (TP_Status.RxFlag || uxQueueMessagesWaiting(RTOS_State.RxQueue)) {           // More Frames Already Waiting
+        continue;
+      }
+      uint32_t _Wait = UDS_NextDeadline();
+      if (_Wait == 0u) {                                                              // Work Due Now
+        continue;
+      }
+      ulTaskNotifyTake(pdTRUE, (_Wait == TP_NoDeadline) ? portMAX_DELAY : (TickType_t)_Wait);
+    }
+}
+
+
+#ifdef UDS_EnableTrace
+void RTOS_TraceTask (void *_Parameter);
+void RTOS_TraceTask (void *_Parameter) {
+    (void)_Parameter;
+    for (;;) {
+      if (UDS_TraceDrain(RTOS_TraceBatch) == 0u) {                                    // Ring Empty, Sleep
+        vTaskDelay(RTOS_TracePeriod);
+      }
+    }
+}
+#endif
+
+
+BaseType_t RTOS_Start (UBaseType_t _Priority);
+BaseType_t RTOS_Start (UBaseType_t _Priority) {
+    RTOS_State.RxQueue = xQueueCreate(RTOS_RxDepth, sizeof(RTOS_CANFrame));
+    if (RTOS_State.RxQueue == NULL) {
+      return pdFAIL;
+    }
+    if (xTaskCreate(RTOS_Task, "UDS", RTOS_StackDepth, NULL, _Priority, &RTOS_State.Task) != pdPASS) {
+      return pdFAIL;
+    }
+#ifdef UDS_EnableTrace
+    if (xTaskCreate(RTOS_TraceTask, "UDSTrace", RTOS_TraceStackDepth, NULL, tskIDLE_PRIORITY, NULL) != pdPASS) {
+      return pdFAIL;
+    }
+#endif
+    return pdPASS;
+}
+
+#endif
+/* ==================================================================================================== */
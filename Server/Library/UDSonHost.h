@@ -0,0 +1,186 @@
+/* ==================================================================================================== */
+/*
+ *  Section
+ *  Physical Layer
+ *
+ *  Physical Layer Implemented On A Workstation (POSIX) With An In Memory CAN Bus
+ *
+ *  uint64_t Host_Micros (void)
+ *  uint32_t Host_Clock (void)
+ *  void Host_ClockVirtual (uint8_t _Enable)
+ *  void Host_ClockAdvance (uint32_t _Time)
+ *  uint8_t Host_QueuePush (Host_CANQueue *_Queue, uint16_t _CANID, const uint8_t *_Data)
+ *  uint8_t Host_QueuePop (Host_CANQueue *_Queue, Host_CANFrame *_Frame)
+ *  void Host_BusSend (uint16_t _CANID, uint8_t _D0, uint8_t _D1, uint8_t _D2, uint8_t _D3,
+ *        uint8_t _D4, uint8_t _D5, uint8_t _D6, uint8_t _D7)
+ *  uint8_t Host_BusInject (uint16_t _CANID, const uint8_t *_Data)
+ *  uint8_t Host_BusPoll (void)
+ *  uint8_t Host_SetBaudrate (uint32_t _Baud)
+ *  uint8_t UDS_PlatformRandom (uint8_t *_Buffer, uint8_t _Length)
+ *  void UDS_TracePut (uint8_t _Byte)
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+#ifdef _UDSonHost
+
+#include <stdio.h>
+#include <time.h>
+
+
+#ifndef HostBusParameters                                                             // Host Bus Parameters
+  #define HostBusParameters
+  #define Host_BusDepth               256u                                            // Host Bus Frames Per Direction (Power of 2)
+  #define Host_RandomSource           "/dev/urandom"                                  // Host Random Source
+#endif
+
+
+typedef struct {
+    uint16_t CANID;
+    uint8_t Data[8];
+    uint32_t Baud;                                                                    // Host Bus Baudrate When Queued
+} Host_CANFrame;
+
+typedef struct {
+    Host_CANFrame Frame[Host_BusDepth];
+    uint32_t Head;                                                                    // Host Queue Read Index
+    uint32_t Tail;                                                                    // Host Queue Write Index
+    uint32_t Dropped;                                                                 // Host Queue Frames Lost To Overflow
+} Host_CANQueue;
+
+typedef struct {
+    uint8_t Virtual;                                                                  // Host Virtual Clock Selected (Active High)
+    uint32_t Time;                                                                    // Host Virtual Time (ms)
+    uint64_t Origin;                                                                  // Host Monotonic Start Time (us)
+    uint32_t Baudrate;                                                                // Host Bus Baudrate
+    FILE *Trace;                                                                      // Host Trace Output (Null When Off)
+} Host_Platform;
+
+
+Host_CANQueue Host_BusToServer = {0};                                                 // Tester To Server Frames
+Host_CANQueue Host_BusFromServer = {0};                                               // Server To Tester Frames
+Host_Platform Host_State = {0, 0, 0, 500000u, NULL};
+
+
+
+uint64_t Host_Micros (void);
+uint64_t Host_Micros (void) {
+    struct timespec _Now;
+    clock_gettime(CLOCK_MONOTONIC, &_Now);                                            // Host Monotonic Clock
+    uint64_t _Micros = ((uint64_t)_Now.tv_sec * 1000000u) + ((uint64_t)_Now.tv_nsec / 1000u);
+    if (Host_State.Origin == 0) {                                                     // First Call Sets Origin
+        Host_State.Origin = _Micros;
+    }
+    return _Micros - Host_State.Origin;
+}
+
+
+uint32_t Host_Clock (void);
+uint32_t Host_Clock (void) {
+    if (Host_State.Virtual) {                                                         // Virtual Clock Only Moves When Advanced
+        return Host_State.Time;
+    }
+    return (uint32_t)(Host_Micros() / 1000u);                                         // Monotonic Milliseconds
+}
+
+
+void Host_ClockVirtual (uint8_t _Enable);
+void Host_ClockVirtual (uint8_t _Enable) {
+    Host_State.Virtual = _Enable ? 1 : 0;
+    Host_State.Time = 0u;
+}
+
+
+void Host_ClockAdvance (uint32_t _Time);
+void Host_ClockAdvance (uint32_t _Time) {
+    Host_State.Time += _Time;                                                         // Virtual Time Advanced
+}
+
+
+uint8_t Host_QueuePush (Host_CANQueue *_Queue, uint16_t _CANID, const uint8_t *_Data);
+uint8_t Host_QueuePush (Host_CANQueue *_Queue, uint16_t _CANID, const uint8_t *_Data) {
+    if ((_Queue->Tail - _Queue->Head) >= Host_BusDepth) {                             // Queue Full Check
+        _Queue->Dropped++;
+        return 1;
+    }
+    Host_CANFrame *_Frame = &_Queue->Frame[_Queue->Tail & (Host_BusDepth - 1)];
+    _Frame->CANID = _CANID;
+    _Frame->Baud = Host_State.Baudrate;                                               // Baudrate Changes Apply To Later Frames Only
+    uint8_t i = 0;
+    while (i < 8) {
+      _Frame->Data[i] = _Data[i];
+      i++;
+    }
+    _Queue->Tail++;
+    return 0;
+}
+
+
+uint8_t Host_QueuePop (Host_CANQueue *_Queue, Host_CANFrame *_Frame);
+uint8_t Host_QueuePop (Host_CANQueue *_Queue, Host_CANFrame *_Frame) {
+    if (_Queue->Head == _Queue->Tail) {                                               // Queue Empty Check
+        return 1;
+    }
+    *_Frame = _Queue->Frame[_Queue->Head & (Host_BusDepth - 1)];
+    _Queue->Head++;
+    return 0;
+}
+
+
+void Host_BusSend (uint16_t _CANID, uint8_t _D0, uint8_t _D1, uint8_t _D2, uint8_t _D3,
+  uint8_t _D4, uint8_t _D5, uint8_t _D6, uint8_t _D7);
+void Host_BusSend (uint16_t _CANID, uint8_t _D0, uint8_t _D1, uint8_t _D2, uint8_t _D3,
+  uint8_t _D4, uint8_t _D5, uint8_t _D6, uint8_t _D7) {
+    uint8_t _Data[8] = {_D0, _D1, _D2, _D3, _D4, _D5, _D6, _D7};
+    Host_QueuePush(&Host_BusFromServer, _CANID, _Data);                               // Server Frame Put On Bus
+}
+
+
+uint8_t Host_BusInject (uint16_t _CANID, const uint8_t *_Data);
+uint8_t Host_BusInject (uint16_t _CANID, const uint8_t *_Data) {
+    return Host_QueuePush(&Host_BusToServer, _CANID, _Data);                          // Tester Frame Put On Bus
+}
+
+
+uint8_t Host_BusPoll (void);
+uint8_t Host_BusPoll (void) {
+    if (TP_Status.RxFlag) {                                                           // Server Still Holds Last Frame
+        return 0;
+    }
+    Host_CANFrame _Frame;
+    UDS_MetricsQueue(Host_BusToServer.Tail - Host_BusToServer.Head);                  // Receive Queue Depth Seen By The Server
+    if (Host_QueuePop(&Host_BusToServer, &_Frame)) {                                  // Nothing On Bus
+        return 0;
+    }
+    TP_ReceiveDataCAN(_Frame.CANID, _Frame.Data[0], _Frame.Data[1], _Frame.Data[2],   // Frame Delivered To DoCAN
+          _Frame.Data[3], _Frame.Data[4], _Frame.Data[5], _Frame.Data[6], _Frame.Data[7]);
+    return 1;
+}
+
+
+uint8_t Host_SetBaudrate (uint32_t _Baud);
+uint8_t Host_SetBaudrate (uint32_t _Baud) {
+    Host_State.Baudrate = _Baud;                                                      // In Memory Bus Has No Bit Timing
+    return 0;
+}
+
+
+uint8_t UDS_PlatformRandom (uint8_t *_Buffer, uint8_t _Length) {
+    FILE *_Source = fopen(Host_RandomSource, "rb");
+    if (_Source == NULL) {
+        return 1;
+    }
+    size_t _Read = fread(_Buffer, 1, _Length, _Source);
+    fclose(_Source);
+    return (_Read == _Length) ? 0 : 1;
+}
+
+
+#ifdef UDS_EnableTrace
+void UDS_TracePut (uint8_t _Byte) {
+    if (Host_State.Trace != NULL) {
+        fputc(_Byte, Host_State.Trace);                                               // Binary Trace Stream
+    }
+}
+#endif
+
+#endif
+/* ==================================================================================================== */
@@ -4,15 +4,26 @@
  *  Physical Layer
  *
  *  Physical Layer Implemented Using SPI as CAN
+ *    One Packet Carries Up To SPI_BatchFrames CAN Frames, Packets Run Back To Back In One Chip Select
+ *      Sync 0, Sync 1, Frame Count, Sequence, Count x (CAN ID High, CAN ID Low, Data 0 - 7), CRC High, CRC Low
+ *    CRC-16/CCITT (0x1021, Start 0xFFFF) Covers Frame Count Up To The Last Data Byte
+ *    Any Bad Byte Sends The Receiver Back To Sync Hunting, So The Next Byte May Already Start A Packet
+ *    The SPI Interrupt Moves Bytes Straight Into And Out Of Frame Rings, The Main Loop Only Sees Frames
+ *    Link Faults Are Counted In SPI_Stats
  *
+ *  inline uint16_t SPI_CRC16 (uint16_t _CRC, uint8_t _Data)
+ *  inline void SPI_SlaveMode (void)
+ *  inline void SPI_MasterMode (void)
  *  inline void SPI_Start (void)
  *  inline void SPI_ResetTimeout (void)
+ *  inline uint8_t SPI_TransmitByte (void)
+ *  inline void SPI_TransmitStart (void)
+ *  inline void SPI_TransmitNext (void)
  *  inline void SPI_TransmitFrame (void)
- *  inline void SPI_TransmitFrameShow (void)
- *  inline void SPI_TransmitFrameBuild (uint16_t _CAN, uint8_t _D0, uint8_t _D1, uint8_t _D2, uint8_t _D3, 
+ *  inline void SPI_TransmitFrameBuild (uint16_t _CAN, uint8_t _D0, uint8_t _D1, uint8_t _D2, uint8_t _D3,
           uint8_t _D4, uint8_t _D5, uint8_t _D6, uint8_t _D7)
  *  inline void SPI_ReceiveFrame (void)
- *  inline void SPI_ReceiveFrameShow (void)
+ *  void UDS_TracePut (uint8_t _Byte)
  *  inline uint8_t SPI_ReceiveFrameBuild (void)
  */
  /* ---------------------------------------------------------------------------------------------------- */
@@ -22,44 +33,105 @@
 #include "SansaadhanUDS.h"
 
 
+#ifndef SPIBridgeParameters                                                           // SPI Bridge Parameters
+  #define SPIBridgeParameters
+  #define SPI_Sync0                   0xA5                                            // SPI Packet Sync Word High
+  #define SPI_Sync1                   0xC3                                            // SPI Packet Sync Word Low
+  #define SPI_RecordData              10u                                             // SPI Record CAN ID And Data Bytes
+  #define SPI_RingDepth               8u                                              // SPI Frames Buffered Per Direction (Power of 2)
+  #define SPI_BatchFrames             4u                                              // SPI Frames Per Packet (At Most SPI_RingDepth)
+  #define SPI_PacketTimeout           20u                                             // SPI Partial Packet Timeout
+#endif
+
+#ifndef SPIPacketState                                                                // SPI Packet Byte Position
+  #define SPIPacketState
+  #define SPI_StateSync0              0u                                              // SPI Sync Word High (Idle When Receiving)
+  #define SPI_StateSync1              1u                                              // SPI Sync Word Low
+  #define SPI_StateCount              2u                                              // SPI Frame Count
+  #define SPI_StateSequence           3u                                              // SPI Sequence Number
+  #define SPI_StateBody               4u                                              // SPI Records
+  #define SPI_StateCRCHigh            5u                                              // SPI CRC High Byte
+  #define SPI_StateCRCLow             6u                                              // SPI CRC Low Byte
+  #define SPI_StateEnd                7u                                              // SPI Last Packet Sent (Transmit Only)
+#endif
+
+
 typedef struct {
     Number16Bit CANID;
-    uint8_t Counter;
-    uint32_t Time;
-    uint8_t Flag;
     uint8_t Data[8];
-} SPI_MessageBufferRX;
+} SPI_CANFrame;
 
 typedef struct {
-    Number16Bit CANID;
-    uint8_t Data[8];
-} SPI_MessageBufferTX;
+    uint8_t Record[SPI_RingDepth][SPI_RecordData];                                    // SPI Records Without Delimiters
+    volatile uint8_t Head;                                                            // SPI Ring Read Index
+    volatile uint8_t Tail;                                                            // SPI Ring Write Index
+} SPI_FrameRing;
 
+typedef struct {
+    uint8_t State;                                                                    // SPI Packet Byte Position
+    uint8_t Count;                                                                    // SPI Frames In Packet
+    uint8_t Sequence;                                                                 // SPI Packet Sequence Number
+    uint8_t Record;                                                                   // SPI Record Position In Packet
+    uint8_t Byte;                                                                     // SPI Byte Position In Record
+    uint8_t Keep;                                                                     // SPI Ring Has Room For The Packet (Receive Only)
+    uint16_t CRC;                                                                     // SPI Running CRC
+} SPI_PacketState;
+
+typedef struct {
+    volatile uint8_t Master;                                                          // SPI Server Drives The Link (Active High)
+    uint8_t Synced;                                                                   // SPI First Packet Received (Active High)
+    uint8_t Expected;                                                                 // SPI Sequence Number Expected Next
+    volatile uint32_t RxTime;                                                         // SPI Packet Start Time
+    SPI_PacketState Rx;                                                               // SPI Packet Being Received
+    SPI_PacketState Tx;                                                               // SPI Packet Being Sent
+} SPI_LinkState;
 
-SPI_MessageBufferTX SPI_FrameTX = {
+typedef struct {
+    uint32_t RxPackets;                                                               // SPI Packets Accepted
+    uint32_t RxFrames;                                                                // SPI Frames Accepted
+    uint32_t TxPackets;                                                               // SPI Packets Sent
+    uint32_t TxFrames;                                                                // SPI Frames Sent
+    uint16_t SyncErrors;                                                              // SPI Bytes Skipped Hunting For Sync Or Bad Count
+    uint16_t CRCErrors;                                                               // SPI Packets Failing CRC
+    uint16_t SequenceGaps;                                                            // SPI Packets Missing By Sequence Number
+    uint16_t Overflows;                                                               // SPI Frames Lost To A Full Receive Ring
+    uint16_t Timeouts;                                                                // SPI Partial Packets Expired
+} SPI_LinkStats;
+
+
+SPI_CANFrame SPI_FrameTX = {
     0x0000,
     {0x00},
 };
 
-SPI_MessageBufferRX SPI_FrameRX = {
+SPI_CANFrame SPI_FrameRX = {
     0x0000,
-    0x00,
-    0x00000000,
-    0x00,
     {0x00},
 };
 
+SPI_FrameRing SPI_RxRing = {{{0x00}}, 0x00, 0x00};
+SPI_FrameRing SPI_TxRing = {{{0x00}}, 0x00, 0x00};
+SPI_LinkState SPI_Link = {0};
+SPI_LinkStats SPI_Stats = {0};
+
+const uint16_t SPI_CRCTable[16] = {                                                   // SPI CRC-16/CCITT Per Nibble
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+};
+
 
 
-inline void SPI_Start (void);   
-inline void SPI_Start (void) {
-    // SPI Setting
-    SPR0(SPI_DIV128);                                                                 // SPI Clock Setting
-    CPOL0(0);                                                                         // SPI Clock Polarity 0
-    CPHA0(0);                                                                         // SPI Clock Phase 0
-    DORD0(SPI_MSB);                                                                   // SPI Data Order MSB to LSB
-    // SPI Slave Mode
-    MSTR0(0);                                                                         // SPI Slave Mode 
+inline uint16_t SPI_CRC16 (uint16_t _CRC, uint8_t _Data);
+inline uint16_t SPI_CRC16 (uint16_t _CRC, uint8_t _Data) {
+    _CRC = (_CRC << 4) ^ SPI_CRCTable[(_CRC >> 12) ^ (_Data >> 4)];                   // SPI High Nibble
+    _CRC = (_CRC << 4) ^ SPI_CRCTable[(_CRC >> 12) ^ (_Data & 0x0F)];                 // SPI Low Nibble
+    return _CRC;
+}
+
+
+inline void SPI_SlaveMode (void);
+inline void SPI_SlaveMode (void) {
+    MSTR0(0);                                                                         // SPI Slave Mode
     PB2Mode(0);                                                                       // SPI SS Input Mode
     PB2PullUP(1);                                                                     // SPI SS Pulled Up
     PB3Mode(0);                                                                       // SPI MOSI Input Mode
@@ -67,6 +139,29 @@ inline void SPI_Start (void) {
     PB4Mode(1);                                                                       // SPI MISO Output Mode
     PB5Mode(1);                                                                       // SPI SCK Input Mode
     PB5PullUP(0);                                                                     // SPI SCK Pulled Dwon
+}
+
+
+inline void SPI_MasterMode (void);
+inline void SPI_MasterMode (void) {
+    MSTR0(1);                                                                         // SPI Master Mode
+    PB2Mode(1);                                                                       // SPI SS Output Mode
+    PB2(1);                                                                           // SPI SS Idle High
+    PB3Mode(1);                                                                       // SPI MOSI Output Mode
+    PB4Mode(0);                                                                       // SPI MISO Input Mode
+    PB4PullUP(1);                                                                     // SPI MISO Pulled Up
+    PB5Mode(1);                                                                       // SPI SCK Output Mode
+}
+
+
+inline void SPI_Start (void);
+inline void SPI_Start (void) {
+    // SPI Setting
+    SPR0(SPI_DIV128);                                                                 // SPI Clock Setting
+    CPOL0(0);                                                                         // SPI Clock Polarity 0
+    CPHA0(0);                                                                         // SPI Clock Phase 0
+    DORD0(SPI_MSB);                                                                   // SPI Data Order MSB to LSB
+    SPI_SlaveMode();                                                                  // SPI Slave Mode
     // SPI Start
     SPIE0(1);                                                                         // SPI Interrupt Enabled
     SPE0(1);                                                                          // SPI Peripheral Enabled
@@ -77,93 +172,127 @@ inline void SPI_Start (void) {
 
 inline void SPI_ResetTimeout (void);
 inline void SPI_ResetTimeout (void) {
-    if (SPI_FrameRX.Counter != 0) {                                                   // SPI Checking If Session Was Open
-        if ((Tools.Clock() - SPI_FrameRX.Time ) > 1000) {                             // SPI Session Timeout Check
-            SPI_FrameRX.Counter = 0;                                                  // SPI Counter Reset
-            Tools.ConsolePrint("\n:(");                                               // SPI Session Expired Indication
+    if (SPI_Link.Rx.State != SPI_StateSync0) {                                        // SPI Checking If Packet Was Open
+        if ((Tools.Clock() - SPI_Link.RxTime) > SPI_PacketTimeout) {                  // SPI Packet Timeout Check
+            SPI_Link.Rx.State = SPI_StateSync0;                                       // SPI Packet Dropped, Back To Sync Hunting
+            SPI_Stats.Timeouts++;                                                     // SPI Packet Expiry Counted
         }
     }
 }
 
 
-inline void SPI_TransmitFrame (void);
-inline void SPI_TransmitFrame (void) {
-    // SPI Master Mode
-    SPE0(0);                                                                          // SPI Peripheral Disabled
+inline uint8_t SPI_TransmitByte (void);
+inline uint8_t SPI_TransmitByte (void) {
+    SPI_PacketState * _Tx = &SPI_Link.Tx;
+    uint8_t _Data = 0;
+    if (_Tx->State == SPI_StateBody) {                                                // SPI Records, Most Bytes Of A Packet
+        _Data = SPI_TxRing.Record[(SPI_TxRing.Head + _Tx->Record) & (SPI_RingDepth - 1)][_Tx->Byte];
+        _Tx->CRC = SPI_CRC16(_Tx->CRC, _Data);
+        if (++_Tx->Byte >= SPI_RecordData) {                                          // SPI Record Done
+          _Tx->Byte = 0;
+          if (++_Tx->Record >= _Tx->Count) {                                          // SPI Last Record Done
+            _Tx->State = SPI_StateCRCHigh;
+          }
+        }
+        return _Data;
+    }
+    switch (_Tx->State) {
+        case SPI_StateSync0 : {
+            _Tx->State = SPI_StateSync1;
+            return SPI_Sync0;                                                         // SPI Sync Word High
+        }
+        case SPI_StateSync1 : {
+            _Tx->State = SPI_StateCount;
+            return SPI_Sync1;                                                         // SPI Sync Word Low
+        }
+        case SPI_StateCount : {
+            _Data = SPI_TxRing.Tail - SPI_TxRing.Head;                                // SPI Frames Queued Right Now
+            _Tx->Count = (_Data > SPI_BatchFrames) ? SPI_BatchFrames : _Data;
+            _Tx->CRC = SPI_CRC16(0xFFFF, _Tx->Count);
+            _Tx->State = SPI_StateSequence;
+            return _Tx->Count;                                                        // SPI Frame Count
+        }
+        case SPI_StateSequence : {
+            _Tx->CRC = SPI_CRC16(_Tx->CRC, _Tx->Sequence);
+            _Tx->Record = 0;
+            _Tx->Byte = 0;
+            _Tx->State = SPI_StateBody;
+            return _Tx->Sequence;                                                     // SPI Sequence Number
+        }
+        case SPI_StateCRCHigh : {
+            _Tx->State = SPI_StateCRCLow;
+            return (uint8_t)(_Tx->CRC >> 8);                                          // SPI CRC High Byte
+        }
+        default : {
+            SPI_TxRing.Head += _Tx->Count;                                            // SPI Ring Slots Freed
+            SPI_Stats.TxPackets++;
+            SPI_Stats.TxFrames += _Tx->Count;
+            _Tx->Sequence++;                                                          // SPI Next Packet Number
+            _Tx->State = (SPI_TxRing.Head == SPI_TxRing.Tail) ? SPI_StateEnd : SPI_StateSync0;
+            return (uint8_t)(_Tx->CRC);                                               // SPI CRC Low Byte
+        }
+    }
+}
+
+
+inline void SPI_TransmitStart (void);
+inline void SPI_TransmitStart (void) {
+    if (SPI_Link.Master || (SPI_Link.Rx.State != SPI_StateSync0) || (rPB2 == 0)) {    // SPI Link Busy Or Bridge Holds Chip Select
+        return;
+    }
+    if (SPI_TxRing.Head == SPI_TxRing.Tail) {                                         // SPI Nothing Queued
+        return;
+    }
     SPIE0(0);                                                                         // SPI Interrupt Disabled
-    MSTR0(1);                                                                         // SPI Master Mode 
-    PB2Mode(1);                                                                       // SPI SS Output Mode
-    PB2(1);                                                                           // SPI SS Idle High
-    PB3Mode(1);                                                                       // SPI MOSI Output Mode
-    PB4Mode(0);                                                                       // SPI MISO Input Mode
-    PB4PullUP(1);                                                                     // SPI MISO Pulled Up
-    PB5Mode(1);                                                                       // SPI SCK Output Mode
+    SPE0(0);                                                                          // SPI Peripheral Disabled
+    SPI_MasterMode();                                                                 // SPI Master Mode
+    SPI_Link.Master = 1;                                                              // SPI Server Drives The Link
+    SPI_Link.Tx.State = SPI_StateSync0;                                               // SPI First Packet Starts
     SPE0(1);                                                                          // SPI Peripheral Enabled
-    // SPI Data Sharing
-    NOP(); NOP();                                                                     // SPI Delay
     PB2(0);                                                                           // SPI SS Driven Low
-    NOP(); NOP();                                                                     // SPI Delay
-      SPDR0('#');                                                                     // SPI Data Loaded
-      NOP();                                                                          // SPI Delay
-      while(!rSPIF0);                                                                 // SPI Waiting For Data Transfer
-    NOP(); NOP();                                                                     // SPI Delay
-      SPDR0(SPI_FrameTX.CANID.Byte.B1);                                               // SPI Data Loaded
-      NOP();                                                                          // SPI Delay
-      while(!rSPIF0);                                                                 // SPI Waiting For Data Transfer
-    NOP(); NOP();                                                                     // SPI Delay
-      SPDR0(SPI_FrameTX.CANID.Byte.B0);                                               // SPI Data Loaded
-      NOP();                                                                          // SPI Delay
-      while(!rSPIF0);                                                                 // SPI Waiting For Data Transfer
-    uint8_t i = 0;
-    while (i < 8) {
-      NOP(); NOP();                                                                   // SPI Delay
-      SPDR0(SPI_FrameTX.Data[i]);                                                     // SPI Data Loaded
-      NOP();                                                                          // SPI Delay
-      while(!rSPIF0);                                                                 // SPI Waiting For Data Transfer
-      i++;
-    }
-    NOP(); NOP();                                                                     // SPI Delay
-      SPDR0('#');                                                                     // SPI Data Loaded
-      NOP();                                                                          // SPI Delay
-      while(!rSPIF0);                                                                 // SPI Waiting For Data Transfer
-    NOP(); NOP();                                                                     // SPI Delay
-    PB2(1);                                                                           // SPI SS Driven High
-    // SPI Slave Mode
-    
-    SPE0(0);                                                                          // SPI Peripheral Disabled
-    i = rSPIF0;
-    i = rSPDR0;
-    MSTR0(0);                                                                         // SPI Slave Mode 
-    PB2Mode(0);                                                                       // SPI SS Input Mode
-    PB2PullUP(1);                                                                     // SPI SS Pulled Up
-    PB3Mode(0);                                                                       // SPI MOSI Input Mode
-    PB3PullUP(1);                                                                     // SPI MOSI Pulled Up
-    PB4Mode(1);                                                                       // SPI MISO Output Mode
-    PB5Mode(1);                                                                       // SPI SCK Input Mode
-    PB5PullUP(0);                                                                     // SPI SCK Pulled Dwon
     SPIE0(1);                                                                         // SPI Interrupt Enabled
-    SPE0(1);                                                                          // SPI Peripheral Enabled
+    SPDR0(SPI_TransmitByte());                                                        // SPI First Byte Loaded, Rest From Interrupt
 }
 
 
-inline void SPI_TransmitFrameShow (void);
-inline void SPI_TransmitFrameShow (void) {
-    Tools.ConsoleLine();                                                              // SPI Show Line Break
-    Tools.ConsolePrint("Tx: 0x");                                                     // SPI Show Header
-    Tools.ConsoleHEX(SPI_FrameTX.CANID.Raw);                                          // SPI Show CAN ID
-    Tools.ConsolePrint(" :");                                                         // SPI Show Data Separater
+inline void SPI_TransmitNext (void);
+inline void SPI_TransmitNext (void) {
+    uint8_t _Data = rSPDR0;                                                           // SPI Clearing Transfer Flag
+    (void)_Data;
+    if (SPI_Link.Tx.State == SPI_StateEnd) {                                          // SPI Batch Done
+        PB2(1);                                                                       // SPI SS Driven High
+        SPE0(0);                                                                      // SPI Peripheral Disabled
+        SPI_SlaveMode();                                                              // SPI Slave Mode
+        SPI_Link.Master = 0;                                                          // SPI Bridge Drives The Link
+        SPE0(1);                                                                      // SPI Peripheral Enabled
+        return;
+    }
+    SPDR0(SPI_TransmitByte());                                                        // SPI Data Loaded
+}
+
+
+inline void SPI_TransmitFrame (void);
+inline void SPI_TransmitFrame (void) {
+    while ((uint8_t)(SPI_TxRing.Tail - SPI_TxRing.Head) >= SPI_RingDepth) {           // SPI Ring Full, Interrupt Drains It
+        SPI_ResetTimeout();                                                           // SPI Packet Cut By The Bridge Cannot Block The Start
+        SPI_TransmitStart();
+    }
+    uint8_t * _Record = SPI_TxRing.Record[SPI_TxRing.Tail & (SPI_RingDepth - 1)];
+    _Record[0] = SPI_FrameTX.CANID.Byte.B1;                                           // SPI CAN ID High Byte Queued
+    _Record[1] = SPI_FrameTX.CANID.Byte.B0;                                           // SPI CAN ID Low Byte Queued
     uint8_t i = 0;
     while (i < 8) {
-      Tools.ConsolePrint(' ');                                                        // SPI Show Data Space
-      Tools.ConsoleHEX(SPI_FrameTX.Data[i]);                                          // SPI Show Data
+      _Record[i + 2] = SPI_FrameTX.Data[i];                                           // SPI Data Queued
       i++;
     }
+    SPI_TxRing.Tail++;                                                                // SPI Record Committed
+    SPI_TransmitStart();                                                              // SPI Sent Now, Or Joins The Running Batch
 }
 
 
-inline void SPI_TransmitFrameBuild (uint16_t _CAN, uint8_t _D0, uint8_t _D1, uint8_t _D2, uint8_t _D3, 
+inline void SPI_TransmitFrameBuild (uint16_t _CAN, uint8_t _D0, uint8_t _D1, uint8_t _D2, uint8_t _D3,
   uint8_t _D4, uint8_t _D5, uint8_t _D6, uint8_t _D7);
-inline void SPI_TransmitFrameBuild (uint16_t _CAN, uint8_t _D0, uint8_t _D1, uint8_t _D2, uint8_t _D3, 
+inline void SPI_TransmitFrameBuild (uint16_t _CAN, uint8_t _D0, uint8_t _D1, uint8_t _D2, uint8_t _D3,
   uint8_t _D4, uint8_t _D5, uint8_t _D6, uint8_t _D7) {
     SPI_FrameTX.CANID.Raw = _CAN;                                                     // SPI TX Frame CAN ID
     SPI_FrameTX.Data[0] = _D0;                                                        // SPI TX Frame Data Byte 0
@@ -179,121 +308,129 @@ inline void SPI_TransmitFrameBuild (uint16_t _CAN, uint8_t _D0, uint8_t _D1, uin
 
 inline void SPI_ReceiveFrame (void);
 inline void SPI_ReceiveFrame (void) {
-    uint8_t Data = 0;
-    switch (SPI_FrameRX.Counter) {                                                    // SPI Checking SPI Counter
-        case 0 : {
-            Data = rSPDR0;                                                            // SPI Data Read
-            SPI_FrameRX.Time = Tools.Clock();                                         // SPI Timer Expire
-            SPI_FrameRX.Flag = ((Data == '#') ? 0x01 : 0x00);                         // SPI Flag Set
-            SPI_FrameRX.Counter++;                                                    // SPI Counter Increment
-            return;
-        } 
-        case 1 : {
-            Data = rSPDR0;                                                            // SPI Data Read
-            SPI_FrameRX.CANID.Byte.B1 = Data;                                         // SPI CAN ID High Byte Loaded
-            SPI_FrameRX.Counter++;                                                    // SPI Counter Increment
-            return;
+    uint8_t _Data = rSPDR0;                                                           // SPI Data Read
+    SPI_PacketState * _Rx = &SPI_Link.Rx;
+    if (_Rx->State == SPI_StateBody) {                                                // SPI Records, Most Bytes Of A Packet
+        _Rx->CRC = SPI_CRC16(_Rx->CRC, _Data);
+        if (_Rx->Keep) {
+          SPI_RxRing.Record[(SPI_RxRing.Tail + _Rx->Record) & (SPI_RingDepth - 1)][_Rx->Byte] = _Data;
         }
-        case 2 : {
-            Data = rSPDR0;                                                            // SPI Data Read
-            SPI_FrameRX.CANID.Byte.B0 = Data;                                         // SPI CAN ID Low Byte Loaded
-            SPI_FrameRX.Counter++;                                                    // SPI Counter Increment
-            return;
-        }
-        case 3 : {
-            Data = rSPDR0;                                                            // SPI Data Read
-            SPI_FrameRX.Data[0] = Data;                                               // SPI Data Loaded
-            SPI_FrameRX.Counter++;                                                    // SPI Counter Increment
-            return;
-        }
-        case 4 : {
-            Data = rSPDR0;                                                            // SPI Data Read
-            SPI_FrameRX.Data[1] = Data;                                               // SPI Data Loaded
-            SPI_FrameRX.Counter++;                                                    // SPI Counter Increment
-            return;
-        }
-        case 5 : {
-            Data = rSPDR0;                                                            // SPI Data Read
-            SPI_FrameRX.Data[2] = Data;                                               // SPI Data Loaded
-            SPI_FrameRX.Counter++;                                                    // SPI Counter Increment
-            return;
+        if (++_Rx->Byte >= SPI_RecordData) {                                          // SPI Record Done
+          _Rx->Byte = 0;
+          if (++_Rx->Record >= _Rx->Count) {                                          // SPI Last Record Done
+            _Rx->State = SPI_StateCRCHigh;
+          }
         }
-        case 6 : {
-            Data = rSPDR0;                                                            // SPI Data Read
-            SPI_FrameRX.Data[3] = Data;                                               // SPI Data Loaded
-            SPI_FrameRX.Counter++;                                                    // SPI Counter Increment
-            return;
-        }
-        case 7 : {
-            Data = rSPDR0;                                                            // SPI Data Read
-            SPI_FrameRX.Data[4] = Data;                                               // SPI Data Loaded
-            SPI_FrameRX.Counter++;                                                    // SPI Counter Increment
+        return;
+    }
+    switch (_Rx->State) {
+        case SPI_StateSync0 : {                                                       // SPI Hunting For Sync
+            if (_Data == SPI_Sync0) {
+              SPI_Link.RxTime = Tools.Clock();                                        // SPI Packet Timer Started
+              _Rx->State = SPI_StateSync1;
+            } else {
+              SPI_Stats.SyncErrors++;
+            }
             return;
         }
-        case 8 : {
-            Data = rSPDR0;                                                            // SPI Data Read
-            SPI_FrameRX.Data[5] = Data;                                               // SPI Data Loaded
-            SPI_FrameRX.Counter++;                                                    // SPI Counter Increment
+        case SPI_StateSync1 : {
+            if (_Data == SPI_Sync1) {
+              _Rx->State = SPI_StateCount;
+            } else if (_Data != SPI_Sync0) {                                          // SPI Repeated Sync High Keeps Its Place
+              _Rx->State = SPI_StateSync0;
+              SPI_Stats.SyncErrors++;
+            }
             return;
         }
-        case 9 : {
-            Data = rSPDR0;                                                            // SPI Data Read
-            SPI_FrameRX.Data[6] = Data;                                               // SPI Data Loaded
-            SPI_FrameRX.Counter++;                                                    // SPI Counter Increment
+        case SPI_StateCount : {
+            if ((_Data == 0) || (_Data > SPI_BatchFrames)) {                          // SPI Count Check, False Sync
+              _Rx->State = (_Data == SPI_Sync0) ? SPI_StateSync1 : SPI_StateSync0;
+              SPI_Stats.SyncErrors++;
+              return;
+            }
+            _Rx->Count = _Data;
+            _Rx->Keep = ((uint8_t)(SPI_RxRing.Tail - SPI_RxRing.Head) <= (SPI_RingDepth - _Data));
+            _Rx->CRC = SPI_CRC16(0xFFFF, _Data);
+            _Rx->State = SPI_StateSequence;
             return;
         }
-        case 10 : {
-            Data = rSPDR0;                                                            // SPI Data Read
-            SPI_FrameRX.Data[7] = Data;                                               // SPI Data Loaded
-            SPI_FrameRX.Counter++;                                                    // SPI Counter Increment
+        case SPI_StateSequence : {
+            _Rx->Sequence = _Data;
+            _Rx->CRC = SPI_CRC16(_Rx->CRC, _Data);
+            _Rx->Record = 0;
+            _Rx->Byte = 0;
+            _Rx->State = SPI_StateBody;
             return;
         }
-        case 11 : {
-            Data = rSPDR0;                                                            // SPI Data Read
-            SPI_FrameRX.Flag = ((Data == '#') ? (SPI_FrameRX.Flag + 1) : 0x00);       // SPI Flag Acknowledgment
-            SPI_FrameRX.Counter++;                                                    // SPI Counter Increment
+        case SPI_StateCRCHigh : {
+            _Rx->CRC ^= ((uint16_t)_Data << 8);                                       // SPI CRC High Byte Folded In
+            _Rx->State = SPI_StateCRCLow;
             return;
         }
         default : {
-            SPI_FrameRX.Counter = 0;                                                  // SPI Counter Reset
+            _Rx->State = SPI_StateSync0;                                              // SPI Next Byte Hunts For Sync
+            if ((_Rx->CRC ^ _Data) != 0) {                                            // SPI CRC Check
+              SPI_Stats.CRCErrors++;
+              return;
+            }
+            if (SPI_Link.Synced) {                                                    // SPI Sequence Gap Check
+              SPI_Stats.SequenceGaps += (uint8_t)(_Rx->Sequence - SPI_Link.Expected);
+            }
+            SPI_Link.Synced = 1;
+            SPI_Link.Expected = _Rx->Sequence + 1;
+            if (!(_Rx->Keep)) {                                                       // SPI Ring Full, Packet Lost
+              SPI_Stats.Overflows += _Rx->Count;
+              UDS_MetricsAdd(Dropped, _Rx->Count);
+              return;
+            }
+            SPI_RxRing.Tail += _Rx->Count;                                            // SPI Records Committed
+            SPI_Stats.RxPackets++;
+            SPI_Stats.RxFrames += _Rx->Count;
             return;
         }
     }
 }
 
 
-inline void SPI_ReceiveFrameShow (void);
-inline void SPI_ReceiveFrameShow (void) {
-    Tools.ConsoleLine();                                                              // SPI Show Line Break
-    Tools.ConsolePrint("Rx: 0x");                                                     // SPI Show Header
-    Tools.ConsoleHEX(SPI_FrameRX.CANID.Raw);                                          // SPI Show CAN ID
-    Tools.ConsolePrint(" :");                                                         // SPI Show Data Separater
+inline uint8_t SPI_ReceiveFrameBuild (void);
+inline uint8_t SPI_ReceiveFrameBuild (void) {
+    SPI_TransmitStart();                                                              // SPI Queued Frames Sent Once The Bridge Lets Go
+    if (TP_Status.RxFlag) {                                                           // SPI DoCAN Still Holds Last Frame
+        return 0;
+    }
+    uint8_t _Depth = SPI_RxRing.Tail - SPI_RxRing.Head;
+    if (_Depth == 0) {                                                                // SPI Not Received Any Frame
+        return 0;
+    }
+    UDS_MetricsQueue(_Depth);                                                         // SPI Receive Ring Depth Seen By The Server
+    const uint8_t * _Record = SPI_RxRing.Record[SPI_RxRing.Head & (SPI_RingDepth - 1)];
+    SPI_FrameRX.CANID.Byte.B1 = _Record[0];                                           // SPI CAN ID High Byte Loaded
+    SPI_FrameRX.CANID.Byte.B0 = _Record[1];                                           // SPI CAN ID Low Byte Loaded
     uint8_t i = 0;
     while (i < 8) {
-      Tools.ConsolePrint(' ');                                                        // SPI Show Data Space
-      Tools.ConsoleHEX(SPI_FrameRX.Data[i]);                                          // SPI Show Data
+      SPI_FrameRX.Data[i] = _Record[i + 2];                                           // SPI Data Loaded
       i++;
     }
+    SPI_RxRing.Head++;                                                                // SPI Ring Slot Freed
+    TP_ReceiveDataCAN(SPI_FrameRX.CANID.Raw, SPI_FrameRX.Data[0],                     // SPI To TP Transfer
+        SPI_FrameRX.Data[1], SPI_FrameRX.Data[2], SPI_FrameRX.Data[3],
+        SPI_FrameRX.Data[4], SPI_FrameRX.Data[5], SPI_FrameRX.Data[6],
+        SPI_FrameRX.Data[7]);
+    return 1;                                                                         // SPI Received A Frame
 }
 
-
-inline uint8_t SPI_ReceiveFrameBuild (void);
-inline uint8_t SPI_ReceiveFrameBuild (void) {
-    if (SPI_FrameRX.Flag == 0x02) {                                                   // SPI Check If All OK
-        SPI_FrameRX.Flag = 0x00;                                                      // SPI Flag Reset
-        SPI_FrameRX.Counter = 0;                                                      // SPI Counter Reset
-        SPI_ReceiveFrameShow();                                                       // SPI receive Frame Show
-        TP_ReceiveDataCAN(SPI_FrameRX.CANID.Raw, SPI_FrameRX.Data[0],                 // SPI To TP Transfer
-            SPI_FrameRX.Data[1], SPI_FrameRX.Data[2], SPI_FrameRX.Data[3], 
-            SPI_FrameRX.Data[4], SPI_FrameRX.Data[5], SPI_FrameRX.Data[6],
-            SPI_FrameRX.Data[7]);
-        return 1;                                                                     // SPI Received A Frame
-    }
-    return 0;                                                                         // SPI Not Received Any Frame
+#ifdef UDS_EnableTrace
+void UDS_TracePut (uint8_t _Byte) {
+    Tools.ConsolePrint((char)_Byte);                                                  // Trace Bytes Out Through The Console UART
 }
+#endif
 
 Interrupt(INT_SPI0_STC) {
-    SPI_ReceiveFrame();                                                               // SPI ReceiveFrame Interrupt Function
+    if (SPI_Link.Master) {                                                            // SPI Server Sending A Batch
+        SPI_TransmitNext();                                                           // SPI Next Byte Out
+    } else {
+        SPI_ReceiveFrame();                                                           // SPI Byte Into Receive Ring
+    }
 }
 
 inline void SPI_Reset (void);
@@ -307,4 +444,3 @@ inline void SPI_Reset (void) {
     }
 }
 #endif
-/* ==================================================================================================== */
\ No newline at end of file
@@ -0,0 +1,26 @@
+/* ==================================================================================================== */
+/*
+ *  windows.h
+ *  Unified Diagnostics Services on CAN (UDSonCAN) - Simulation Shim
+ *    Windows Types And Calls The Client Library And PCANBasic.h Use, Nothing Else
+ *    Sleep Is Served By The Simulation And Advances Virtual Time
+ */
+/* ==================================================================================================== */
+
+#ifndef _SimWindows
+#define _SimWindows
+
+#include <stdint.h>
+
+typedef uint8_t BYTE;
+typedef uint16_t WORD;
+typedef uint32_t DWORD;
+typedef uint64_t UINT64;
+typedef char * LPSTR;
+
+#define __stdcall
+
+void Sleep (DWORD Milliseconds);
+
+#endif  // _SimWindows
+/* ==================================================================================================== */
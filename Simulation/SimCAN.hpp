@@ -0,0 +1,402 @@
+/* ==================================================================================================== */
+/*
+ *  SimCAN.h
+ *  Discrete Event CAN Bus Simulation
+ *    ISO: 11898 Part 1 - Controller Area Network (CAN)
+ *  Version: v1.0:0
+ */
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @file        SimCAN.h
+ * @brief       Virtual Time CAN Bus Between the Server Node and the Tester Node
+ *
+ * Time is in NanoSeconds and only moves from one event to the next. A frame holds the bus for its
+ * real length in bits (stuff bits from the real CRC included, plus EOF and intermission) at the bit
+ * rate of its sender, so bus utilization is counted exactly. Lowest identifier wins arbitration.
+ */
+/* ==================================================================================================== */
+
+#ifndef _SimCAN
+#define _SimCAN
+
+#include <stdint.h>
+#include <deque>
+#include <queue>
+#include <vector>
+#include "SimServer.h"
+
+#define SimCAN_NODE_SERVER                0
+#define SimCAN_NODE_TESTER                1
+#define SimCAN_NODES                      2
+
+#define SimCAN_EVENT_FRAMEEND             0
+#define SimCAN_EVENT_SERVERLOOP           1
+
+#define SimCAN_TXDEPTH                    32768
+
+
+
+/* ==================================================================================================== */
+/**
+ * @class       SimCAN
+ * @brief       CAN Bus and Event Scheduler of the Simulation
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+class SimCAN {
+
+  public :
+
+    struct SimFRAME {
+      uint32_t ID;
+      uint8_t EXT;
+      uint8_t LEN;
+      uint8_t DATA[8];
+      uint32_t BAUD;
+      uint64_t TIME;
+    };
+
+    struct SimNODE {
+      std::deque<SimFRAME> TX;
+      std::deque<SimFRAME> RX;
+      uint32_t BAUD;
+      uint32_t FILTER_LOW;
+      uint32_t FILTER_HIGH;
+      uint64_t FRAMES;
+      uint64_t BITS;
+    }; SimNODE NODE[SimCAN_NODES];
+
+    struct {
+      uint64_t BUSY;
+      uint64_t BITS;
+      uint64_t STUFF;
+      uint64_t FRAMES;
+      uint64_t ERRORS;
+      uint64_t EVENTS;
+    } STATS;
+
+  private :
+
+    struct SimEVENT {
+      uint64_t TIME;
+      uint64_t SEQUENCE;
+      uint8_t TYPE;
+      bool operator> (const SimEVENT &Other) const {
+        return (TIME != Other.TIME) ? (TIME > Other.TIME) : (SEQUENCE > Other.SEQUENCE);
+      }
+    };
+
+    std::priority_queue<SimEVENT, std::vector<SimEVENT>, std::greater<SimEVENT>> EVENTS;
+    uint64_t SEQUENCE;
+    uint64_t NOW;
+    uint64_t LOOP;
+    uint8_t ACTIVE;
+    uint8_t OWNER;
+    SimFRAME CURRENT;
+
+    void Schedule (uint64_t Time, uint8_t Type);
+    void Arbitrate (void);
+    void FrameEnd (void);
+    void ServerLoop (void);
+
+  public :
+
+    SimCAN (uint32_t Baud, uint64_t LoopTime) {
+      SEQUENCE = 0; NOW = 0; LOOP = LoopTime; ACTIVE = 0; OWNER = 0;
+      STATS = {};
+      for (uint8_t I = 0; I < SimCAN_NODES; I++) {
+        NODE[I].BAUD = Baud; NODE[I].FILTER_LOW = 0; NODE[I].FILTER_HIGH = 0x1FFFFFFF;
+        NODE[I].FRAMES = 0; NODE[I].BITS = 0;
+      }
+      Sim_ServerInit(Baud);
+      Schedule(0, SimCAN_EVENT_SERVERLOOP);
+    }
+
+    static uint32_t FrameBits (const SimFRAME &Frame, uint32_t &Stuff);
+
+    uint64_t Now (void) { return NOW; }
+    uint8_t Transmit (uint8_t Node, uint32_t ID, uint8_t EXT, uint8_t LEN, const uint8_t * Data);
+    void Step (void);
+    void RunUntil (uint64_t Time);
+    double Utilization (void);
+};
+/* ==================================================================================================== */
+
+
+/* ==================================================================================================== */
+/**
+ * @name        FrameBits
+ * @class       SimCAN (Public)
+ * @brief       Length of a Data Frame on the Wire in Bits (ISO 11898-1 Bit Stuffing, CRC-15)
+ * @param [Frame]     CAN Frame
+ * @param [Stuff]     Stuff Bits Inside the Frame
+ * @return      Bits From SOF to the End of Intermission
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint32_t SimCAN::FrameBits (const SimFRAME &Frame, uint32_t &Stuff) {
+  uint8_t Bits[128];
+  uint8_t Count = 0;
+  auto Put = [&] (uint32_t Value, uint8_t Width) {
+    while (Width) {
+      Width--;
+      Bits[Count++] = (Value >> Width) & 0x01;
+    }
+  };
+
+  Put(0, 1);                                    // SOF
+  if (Frame.EXT) {
+    Put(Frame.ID >> 18, 11);                    // Base Identifier
+    Put(1, 1); Put(1, 1);                       // SRR, IDE
+    Put(Frame.ID & 0x3FFFF, 18);                // Extended Identifier
+    Put(0, 1); Put(0, 2);                       // RTR, r1 r0
+  } else {
+    Put(Frame.ID, 11);                          // Identifier
+    Put(0, 1); Put(0, 1); Put(0, 1);            // RTR, IDE, r0
+  }
+  Put(Frame.LEN, 4);                            // DLC
+  for (uint8_t I = 0; I < Frame.LEN; I++) {
+    Put(Frame.DATA[I], 8);
+  }
+  uint16_t CRC = 0;
+  for (uint8_t I = 0; I < Count; I++) {
+    uint8_t Next = Bits[I] ^ ((CRC >> 14) & 0x01);
+    CRC = (CRC << 1) & 0x7FFF;
+    if (Next) {
+      CRC ^= 0x4599;
+    }
+  }
+  Put(CRC, 15);                                 // CRC Sequence, Last Stuffed Field
+
+  Stuff = 0;
+  uint8_t Last = 2, Run = 0;
+  for (uint8_t I = 0; I < Count; I++) {
+    if (Bits[I] == Last) {
+      Run++;
+    } else {
+      Last = Bits[I];
+      Run = 1;
+    }
+    if (Run == 5) {                             // Complement Bit Inserted, Starts the Next Run
+      Stuff++;
+      Last ^= 0x01;
+      Run = 1;
+    }
+  }
+  return Count + Stuff + 1 + 2 + 7 + 3;         // CRC Delimiter, ACK, EOF, Intermission
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Schedule
+ * @class       SimCAN (Private)
+ * @brief       Queue an Event, Equal Times Keep Their Insertion Order
+ * @param [Time]      Event Time in NanoSeconds
+ * @param [Type]      Event Type
+ * @return      Nothing
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+void SimCAN::Schedule (uint64_t Time, uint8_t Type) {
+  EVENTS.push({Time, SEQUENCE++, Type});
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Arbitrate
+ * @class       SimCAN (Private)
+ * @brief       Start the Pending Frame With the Lowest Identifier When the Bus Is Idle
+ * @param []    Nothing
+ * @return      Nothing
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+void SimCAN::Arbitrate (void) {
+  if (ACTIVE) {
+    return;
+  }
+  uint8_t Winner = SimCAN_NODES;
+  uint32_t Priority = 0;
+  for (uint8_t I = 0; I < SimCAN_NODES; I++) {
+    if (NODE[I].TX.empty()) {
+      continue;
+    }
+    const SimFRAME &Frame = NODE[I].TX.front();
+    uint32_t Value = Frame.EXT ? ((Frame.ID & 0x1FFFFFFF) | 0x20000000) : (Frame.ID << 18);
+    if ((Winner == SimCAN_NODES) || (Value < Priority)) {
+      Winner = I;
+      Priority = Value;
+    }
+  }
+  if (Winner == SimCAN_NODES) {
+    return;
+  }
+  CURRENT = NODE[Winner].TX.front();
+  NODE[Winner].TX.pop_front();
+  OWNER = Winner;
+  ACTIVE = 1;
+
+  uint32_t Stuff = 0;
+  uint32_t Bits = FrameBits(CURRENT, Stuff);
+  uint64_t Duration = (((uint64_t)Bits * 1000000000ULL) + (CURRENT.BAUD / 2)) / CURRENT.BAUD;
+  STATS.BUSY += Duration;
+  STATS.BITS += Bits;
+  STATS.STUFF += Stuff;
+  NODE[Winner].BITS += Bits;
+  Schedule(NOW + Duration, SimCAN_EVENT_FRAMEEND);
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        FrameEnd
+ * @class       SimCAN (Private)
+ * @brief       Deliver the Frame on the Bus to Every Other Node Running the Same Bit Rate
+ * @param []    Nothing
+ * @return      Nothing
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+void SimCAN::FrameEnd (void) {
+  ACTIVE = 0;
+  CURRENT.TIME = NOW;
+  uint8_t Acknowledged = 0;
+  for (uint8_t I = 0; I < SimCAN_NODES; I++) {
+    if ((I == OWNER) || (NODE[I].BAUD != CURRENT.BAUD)) {
+      continue;
+    }
+    Acknowledged = 1;                           // Acceptance Filters Sit Behind the ACK
+    if ((CURRENT.ID < NODE[I].FILTER_LOW) || (CURRENT.ID > NODE[I].FILTER_HIGH)) {
+      continue;
+    }
+    if (I == SimCAN_NODE_SERVER) {
+      Sim_ServerDeliver(CURRENT.ID, CURRENT.DATA);
+    } else {
+      NODE[I].RX.push_back(CURRENT);
+    }
+  }
+  if (Acknowledged) {
+    STATS.FRAMES++;
+    NODE[OWNER].FRAMES++;
+  } else {
+    STATS.ERRORS++;                             // Bit Rate Mismatch, Nobody Could Acknowledge
+  }
+  Arbitrate();
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        ServerLoop
+ * @class       SimCAN (Private)
+ * @brief       Run One Server Main Loop and Hand Its Frames to the Controller
+ * @param []    Nothing
+ * @return      Nothing
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+void SimCAN::ServerLoop (void) {
+  Sim_ServerStep((uint32_t)(NOW / 1000000ULL));
+  uint32_t ID = 0, Baud = 0;
+  uint8_t Data[8];
+  while (Sim_ServerCollect(&ID, Data, &Baud) == 0) {
+    NODE[SimCAN_NODE_SERVER].BAUD = Baud;       // A Frame Keeps the Bit Rate It Was Sent At
+    Transmit(SimCAN_NODE_SERVER, ID, 0, 8, Data);
+  }
+  NODE[SimCAN_NODE_SERVER].BAUD = Sim_ServerBaudrate();
+  Schedule(NOW + LOOP, SimCAN_EVENT_SERVERLOOP);
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Transmit
+ * @class       SimCAN (Public)
+ * @brief       Load a Frame Into the Transmit Queue of a Node at Its Current Bit Rate
+ * @param [Node]      Sending Node
+ * @param [ID]        CAN ID
+ * @param [EXT]       Extended Identifier When Set
+ * @param [LEN]       Data Length
+ * @param [Data]      Data Bytes
+ * @return      Zero on Success, One When the Transmit Queue Is Full
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t SimCAN::Transmit (uint8_t Node, uint32_t ID, uint8_t EXT, uint8_t LEN, const uint8_t * Data) {
+  if (NODE[Node].TX.size() >= SimCAN_TXDEPTH) {
+    return 1;
+  }
+  SimFRAME Frame = {};
+  Frame.ID = ID;
+  Frame.EXT = EXT;
+  Frame.LEN = (LEN > 8) ? 8 : LEN;
+  for (uint8_t I = 0; I < Frame.LEN; I++) {
+    Frame.DATA[I] = Data[I];
+  }
+  Frame.BAUD = NODE[Node].BAUD;
+  NODE[Node].TX.push_back(Frame);
+  Arbitrate();
+  return 0;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Step
+ * @class       SimCAN (Public)
+ * @brief       Advance Virtual Time to the Next Event and Process It
+ * @param []    Nothing
+ * @return      Nothing
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+void SimCAN::Step (void) {
+  SimEVENT Event = EVENTS.top();
+  EVENTS.pop();
+  NOW = Event.TIME;
+  STATS.EVENTS++;
+  if (Event.TYPE == SimCAN_EVENT_FRAMEEND) {
+    FrameEnd();
+  } else {
+    ServerLoop();
+  }
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        RunUntil
+ * @class       SimCAN (Public)
+ * @brief       Process Every Event Up To a Time and Stop There
+ * @param [Time]      Target Time in NanoSeconds
+ * @return      Nothing
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+void SimCAN::RunUntil (uint64_t Time) {
+  while (EVENTS.top().TIME <= Time) {
+    Step();
+  }
+  if (Time > NOW) {
+    NOW = Time;
+  }
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Utilization
+ * @class       SimCAN (Public)
+ * @brief       Share of Elapsed Virtual Time the Bus Carried a Frame
+ * @param []    Nothing
+ * @return      Utilization in Percent
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+double SimCAN::Utilization (void) {
+  return (NOW == 0) ? 0.0 : (100.0 * (double)STATS.BUSY / (double)NOW);
+}
+/* ==================================================================================================== */
+
+
+/* ==================================================================================================== */
+/**
+ * @end       End of File SimCAN.h
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+#endif  // _SimCAN
+/* ==================================================================================================== */
@@ -0,0 +1,17 @@
+/* ==================================================================================================== */
+/*
+ *  SimConfig.h
+ *  Unified Diagnostics Services on CAN (UDSonCAN) - Simulated Server Configuration
+ *    Read By UDS_Config.h Through UDS_ConfigFile, Ahead Of The Library Defaults
+ *    The Bus Baudrate Is A Command Line Option Here, So The Power Up Baudrate Comes From SimServer.c
+ */
+/* ==================================================================================================== */
+
+#ifndef _SimConfig
+#define _SimConfig
+
+extern uint32_t Sim_LinkDefaultBaud;                                                  // Set By Sim_ServerInit
+#define UDS_LinkDefaultBaud           Sim_LinkDefaultBaud                             // UDS Link Default Baudrate (This Bus)
+
+#endif
+/* ==================================================================================================== */
@@ -0,0 +1,192 @@
+/* ==================================================================================================== */
+/*
+ *  SimPCAN.h
+ *  Simulated PCAN-Basic API
+ *  Version: v1.0:0
+ */
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @file        SimPCAN.h
+ * @brief       PCAN-Basic Calls Used by DriverPCAN, Served by the Tester Node of SimCAN
+ *
+ * Every call the client makes while it waits (an empty CAN_Read, Sleep, or a DoCAN delay through
+ * the virtual clock) advances the simulation, so the unmodified client loops run in virtual time.
+ */
+/* ==================================================================================================== */
+
+#ifndef _SimPCAN
+#define _SimPCAN
+
+#include "DriverPCAN.hpp"
+#include "SimCAN.hpp"
+
+SimCAN * SimPCANBus = nullptr;
+uint8_t SimPCANReady = 0;
+
+
+
+/* ==================================================================================================== */
+/**
+ * @name        SimPCANBaudrate
+ * @brief       PCAN BTR0BTR1 Code to Bit Rate
+ * @param [Btr0Btr1]    PCAN Baudrate Code
+ * @return      Bit Rate, Zero When Unknown
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint32_t SimPCANBaudrate (TPCANBaudrate Btr0Btr1) {
+  switch (Btr0Btr1) {
+    case PCAN_BAUD_1M :   { return 1000000; }
+    case PCAN_BAUD_800K : { return 800000; }
+    case PCAN_BAUD_500K : { return 500000; }
+    case PCAN_BAUD_250K : { return 250000; }
+    case PCAN_BAUD_125K : { return 125000; }
+    case PCAN_BAUD_100K : { return 100000; }
+    case PCAN_BAUD_50K :  { return 50000; }
+    case PCAN_BAUD_20K :  { return 20000; }
+    case PCAN_BAUD_10K :  { return 10000; }
+    default :             { return 0; }
+  }
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        SimPCANNow / SimPCANWait
+ * @brief       Virtual Clock Handed to ISO_DoCAN
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint64_t SimPCANNow (void) {
+  return SimPCANBus->Now() / 1000;
+}
+
+void SimPCANWait (uint64_t Time) {
+  SimPCANBus->RunUntil(SimPCANBus->Now() + (Time * 1000));
+}
+
+void Sleep (DWORD Milliseconds) {
+  SimPCANWait((uint64_t)Milliseconds * 1000);
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        PCAN-Basic
+ * @brief       Channel Handle Is Ignored, the Simulation Has a Single Tester Channel
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+TPCANStatus __stdcall CAN_Initialize (TPCANHandle Channel, TPCANBaudrate Btr0Btr1, TPCANType HwType,
+    DWORD IOPort, WORD Interrupt) {
+  (void)Channel; (void)HwType; (void)IOPort; (void)Interrupt;
+  uint32_t Baud = SimPCANBaudrate(Btr0Btr1);
+  if (Baud == 0) {
+    return PCAN_ERROR_ILLPARAMVAL;
+  }
+  SimCAN::SimNODE &Node = SimPCANBus->NODE[SimCAN_NODE_TESTER];
+  Node.BAUD = Baud;
+  Node.FILTER_LOW = 0;
+  Node.FILTER_HIGH = 0x1FFFFFFF;
+  Node.RX.clear();
+  Node.TX.clear();
+  SimPCANReady = 1;
+  return PCAN_ERROR_OK;
+}
+
+TPCANStatus __stdcall CAN_Uninitialize (TPCANHandle Channel) {
+  (void)Channel;
+  SimPCANReady = 0;
+  SimPCANBus->NODE[SimCAN_NODE_TESTER].RX.clear();
+  SimPCANBus->NODE[SimCAN_NODE_TESTER].TX.clear();
+  return PCAN_ERROR_OK;
+}
+
+TPCANStatus __stdcall CAN_Reset (TPCANHandle Channel) {
+  (void)Channel;
+  SimPCANBus->NODE[SimCAN_NODE_TESTER].RX.clear();
+  SimPCANBus->NODE[SimCAN_NODE_TESTER].TX.clear();
+  return PCAN_ERROR_OK;
+}
+
+TPCANStatus __stdcall CAN_FilterMessages (TPCANHandle Channel, DWORD FromID, DWORD ToID, TPCANMode Mode) {
+  (void)Channel; (void)Mode;
+  if (!SimPCANReady) {
+    return PCAN_ERROR_INITIALIZE;
+  }
+  SimPCANBus->NODE[SimCAN_NODE_TESTER].FILTER_LOW = FromID;
+  SimPCANBus->NODE[SimCAN_NODE_TESTER].FILTER_HIGH = ToID;
+  return PCAN_ERROR_OK;
+}
+
+TPCANStatus __stdcall CAN_Write (TPCANHandle Channel, TPCANMsg* MessageBuffer) {
+  (void)Channel;
+  if (!SimPCANReady) {
+    return PCAN_ERROR_INITIALIZE;
+  }
+  if (SimPCANBus->Transmit(SimCAN_NODE_TESTER, MessageBuffer->ID,
+        (MessageBuffer->MSGTYPE & PCAN_MESSAGE_EXTENDED) ? 1 : 0, MessageBuffer->LEN, MessageBuffer->DATA)) {
+    return PCAN_ERROR_QXMTFULL;
+  }
+  return PCAN_ERROR_OK;
+}
+
+TPCANStatus __stdcall CAN_Read (TPCANHandle Channel, TPCANMsg* MessageBuffer, TPCANTimestamp* TimestampBuffer) {
+  (void)Channel;
+  if (!SimPCANReady) {
+    return PCAN_ERROR_INITIALIZE;
+  }
+  std::deque<SimCAN::SimFRAME> &RX = SimPCANBus->NODE[SimCAN_NODE_TESTER].RX;
+  if (RX.empty()) {
+    SimPCANBus->Step();                         // Polling an Empty Queue Lets the Bus Move On
+    if (RX.empty()) {
+      return PCAN_ERROR_QRCVEMPTY;
+    }
+  }
+  SimCAN::SimFRAME Frame = RX.front();
+  RX.pop_front();
+  MessageBuffer->ID = Frame.ID;
+  MessageBuffer->MSGTYPE = Frame.EXT ? PCAN_MESSAGE_EXTENDED : PCAN_MESSAGE_STANDARD;
+  MessageBuffer->LEN = Frame.LEN;
+  for (uint8_t I = 0; I < 8; I++) {
+    MessageBuffer->DATA[I] = Frame.DATA[I];
+  }
+  if (TimestampBuffer) {
+    uint64_t Micros = Frame.TIME / 1000;
+    TimestampBuffer->micros = (WORD)(Micros % 1000);
+    TimestampBuffer->millis = (DWORD)((Micros / 1000) & 0xFFFFFFFF);
+    TimestampBuffer->millis_overflow = (WORD)((Micros / 1000) >> 32);
+  }
+  return PCAN_ERROR_OK;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        PCAN-Basic FD
+ * @brief       SimCAN Models a Classic CAN Bus, an FD Channel Cannot Be Opened on It
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+TPCANStatus __stdcall CAN_InitializeFD (TPCANHandle Channel, TPCANBitrateFD BitrateFD) {
+  (void)Channel; (void)BitrateFD;
+  return PCAN_ERROR_ILLOPERATION;
+}
+
+TPCANStatus __stdcall CAN_WriteFD (TPCANHandle Channel, TPCANMsgFD* MessageBuffer) {
+  (void)Channel; (void)MessageBuffer;
+  return PCAN_ERROR_INITIALIZE;
+}
+
+TPCANStatus __stdcall CAN_ReadFD (TPCANHandle Channel, TPCANMsgFD* MessageBuffer, TPCANTimestampFD* TimestampBuffer) {
+  (void)Channel; (void)MessageBuffer; (void)TimestampBuffer;
+  return PCAN_ERROR_INITIALIZE;
+}
+/* ==================================================================================================== */
+
+
+/* ==================================================================================================== */
+/**
+ * @end       End of File SimPCAN.h
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+#endif  // _SimPCAN
+/* ==================================================================================================== */
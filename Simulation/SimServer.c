@@ -0,0 +1,110 @@
+/* ==================================================================================================== */
+/*
+ *  SimServer.c
+ *  Unified Diagnostics Services on CAN (UDSonCAN) - Simulated Server Node
+ *    Server Library Built For The Host Port On The Virtual Clock
+ *    The Simulation Sets The Clock Before Every Server Loop, The Server Never Advances It
+ */
+/* ==================================================================================================== */
+
+#include "UDS.h"
+#include "SimServer.h"
+
+
+
+const uint8_t UDS_AuthKey[UDS_CryptoKeyLength] = {
+    0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6, 0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C
+};
+
+uint16_t UDS_IOCurrentValue (uint8_t _Index) {
+    return (uint16_t)(_Index * 100u);                                                 // Simulated Signals Read Back Their Index
+}
+
+
+static uint8_t Sim_Transport = Sim_TransportOff;
+uint32_t Sim_LinkDefaultBaud = 500000u;
+
+
+/* ---------------------------------------------------------------------------------------------------- */
+void Sim_ServerInit (uint32_t _Baud) {
+    Host_ClockVirtual(1);                                                             // Time Owned By The Simulation
+    Sim_LinkDefaultBaud = _Baud;                                                      // Power Up Baudrate Of This Bus
+    UDS_InitApp();
+    TP_SetBaudrateCAN(_Baud);
+}
+/* ---------------------------------------------------------------------------------------------------- */
+void Sim_ServerStep (uint32_t _Time) {
+    Host_ClockAdvance(_Time - Host_Clock());                                          // Virtual Time (ms) Of This Loop
+    Host_BusPoll();                                                                   // One Frame Into DoCAN
+    if (Sim_Transport == Sim_TransportOff) {
+        UDS_MainApp();                                                                // One Server Loop
+        return;
+    }
+    TP_RxDoCAN();                                                                     // Transport Only Loop
+    if ((Sim_Transport == Sim_TransportEcho) && (UDS_Server.Status == UDS_ServerBusy)) {
+        TP_TxFrameUSDT('P');                                                          // Request Bytes Sent Back Unchanged
+    }
+    TP_TxDoCAN();
+}
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t Sim_ServerDeliver (uint32_t _CANID, const uint8_t *_Data) {
+    return Host_BusInject((uint16_t)_CANID, _Data);                                   // Frame Into Controller FIFO
+}
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t Sim_ServerCollect (uint32_t *_CANID, uint8_t *_Data, uint32_t *_Baud) {
+    Host_CANFrame _Frame;
+    if (Host_QueuePop(&Host_BusFromServer, &_Frame)) {                                // Nothing Left To Send
+        return 1;
+    }
+    *_CANID = _Frame.CANID;
+    *_Baud = _Frame.Baud;                                                             // Bit Rate The Server Sent It At
+    uint8_t i = 0;
+    while (i < 8) {
+      _Data[i] = _Frame.Data[i];
+      i++;
+    }
+    return 0;
+}
+/* ---------------------------------------------------------------------------------------------------- */
+uint32_t Sim_ServerBaudrate (void) {
+    return Host_State.Baudrate;
+}
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t Sim_ServerSession (void) {
+    return UDS_Server.Session;
+}
+/* ---------------------------------------------------------------------------------------------------- */
+uint32_t Sim_ServerDropped (void) {
+    return Host_BusToServer.Dropped + Host_BusFromServer.Dropped;
+}
+/* ---------------------------------------------------------------------------------------------------- */
+void Sim_ServerTransport (uint8_t _Mode) {
+    Sim_Transport = _Mode;
+}
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t Sim_ServerSend (const uint8_t *_Data, uint16_t _Length) {
+    if ((UDS_Server.Status != UDS_ServerFree) || (_Length == 0) || (_Length >= UDS_ParaBufferSize)) {
+        return 1;
+    }
+    uint16_t i = 0;
+    while (i < _Length) {
+      UDS_Message.Data[i] = _Data[i];
+      i++;
+    }
+    UDS_Message.Length = _Length;
+    TP_TxFrameUSDT('P');                                                              // Segmented By TP_TxDoCAN From Next Loop
+    return 0;
+}
+/* ---------------------------------------------------------------------------------------------------- */
+uint16_t Sim_ServerReceived (const uint8_t **_Data) {
+    if (UDS_Server.Status != UDS_ServerBusy) {                                        // No Complete Request Held
+        return 0;
+    }
+    *_Data = UDS_Message.Data;
+    return UDS_Message.Length;
+}
+/* ---------------------------------------------------------------------------------------------------- */
+void Sim_ServerRelease (void) {
+    UDS_Server.Status = UDS_ServerFree;
+}
+/* ==================================================================================================== */
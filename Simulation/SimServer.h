@@ -0,0 +1,51 @@
+/* ==================================================================================================== */
+/*
+ *  SimServer.h
+ *  Unified Diagnostics Services on CAN (UDSonCAN) - Simulated Server Node
+ *    The Server Library Is One C Translation Unit With Globals, The Simulation Reaches It Only Here
+ *
+ *  void Sim_ServerInit (uint32_t _Baud)
+ *  void Sim_ServerStep (uint32_t _Time)
+ *  uint8_t Sim_ServerDeliver (uint32_t _CANID, const uint8_t *_Data)
+ *  uint8_t Sim_ServerCollect (uint32_t *_CANID, uint8_t *_Data, uint32_t *_Baud)
+ *  uint32_t Sim_ServerBaudrate (void)
+ *  uint8_t Sim_ServerSession (void)
+ *  uint32_t Sim_ServerDropped (void)
+ *  void Sim_ServerTransport (uint8_t _Mode)
+ *  uint8_t Sim_ServerSend (const uint8_t *_Data, uint16_t _Length)
+ *  uint16_t Sim_ServerReceived (const uint8_t **_Data)
+ *  void Sim_ServerRelease (void)
+ */
+/* ==================================================================================================== */
+
+#ifndef _SimServer
+#define _SimServer
+
+#include <stdint.h>
+
+#define Sim_TransportOff                  0u                                          // Full Server, UDS_MainApp
+#define Sim_TransportHold                 1u                                          // DoCAN Only, Requests Held Until Released
+#define Sim_TransportEcho                 2u                                          // DoCAN Only, Requests Sent Back As Responses
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void Sim_ServerInit (uint32_t _Baud);
+void Sim_ServerStep (uint32_t _Time);
+uint8_t Sim_ServerDeliver (uint32_t _CANID, const uint8_t *_Data);
+uint8_t Sim_ServerCollect (uint32_t *_CANID, uint8_t *_Data, uint32_t *_Baud);
+uint32_t Sim_ServerBaudrate (void);
+uint8_t Sim_ServerSession (void);
+uint32_t Sim_ServerDropped (void);
+void Sim_ServerTransport (uint8_t _Mode);
+uint8_t Sim_ServerSend (const uint8_t *_Data, uint16_t _Length);
+uint16_t Sim_ServerReceived (const uint8_t **_Data);
+void Sim_ServerRelease (void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // _SimServer
+/* ==================================================================================================== */
@@ -0,0 +1,348 @@
+/* ==================================================================================================== */
+/*
+ *  bench.cpp
+ *  Unified Diagnostics Services on CAN (UDSonCAN) - DoCAN Transport Benchmark
+ *    Sweeps Payload, Block Size and STmin Over the Simulated Loopback Bus
+ *      ServerTx  : TP_TxFrameUSDT / TP_TxDoCAN Into ISO_DoCAN::Receive
+ *      ServerRx  : ISO_DoCAN::Transmit Segmented Request Into TP_RxFrameFF / TP_RxFrameCF
+ *      RoundTrip : Request Echoed by the Server Transport, Request to Final Response
+ *    Latency and Bytes/s Are Virtual (Deterministic), Host Time Is the Wall Cost of the Transfer
+ *
+ *  Usage: UDSonBench [-o CSV] [-c Thresholds] [-w Thresholds] [-n Repetitions] [-b KBPS] [-p LoopMicros]
+ *    -o  Write Results as CSV (Default Standard Output)
+ *    -c  Compare Against a Threshold File, Exit Non Zero on Regression
+ *    -w  Write a Threshold File From This Run (Latency Exact, Host Time x4)
+ *    -n  Repetitions per Point, Fastest Host Time Kept (Default 3)
+ *    -b  Bus Bit Rate (Default 500)
+ *    -p  Server Main Loop Period in MicroSeconds (Default 100)
+ */
+/* ==================================================================================================== */
+
+#include <unistd.h>
+#include <stdlib.h>
+#include <map>
+#include <string>
+#include "UDS.hpp"
+#include "SimPCAN.hpp"
+
+#define SimBench_HOSTFACTOR               4
+#define SimBench_HOSTSLACK                50000
+
+static const uint16_t SimBenchPayload[] = {1, 7, 8, 62, 63, 256, 1024, 2048, 4095};
+static const uint8_t SimBenchBlock[] = {0, 1, 8, 32};
+static const uint32_t SimBenchSTmin[] = {0, 500, 1000, 5000};
+
+
+
+/* ==================================================================================================== */
+/**
+ * @class       SimBench
+ * @brief       One Bus, One Server, One Tester for the Whole Sweep
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+class SimBench {
+  public :
+
+    struct SimBenchPOINT {
+      const char * DIRECTION;
+      uint16_t PAYLOAD;
+      uint8_t BS;
+      uint32_t STMIN;
+      uint64_t LATENCY;
+      uint64_t FRAMES;
+      double UTILIZATION;
+      uint64_t HOST;
+      uint8_t FAILED;
+    };
+
+  private :
+
+    SimCAN & BUS;
+    ISO_DoCAN DoCAN;
+    uint8_t PATTERN[4095];
+
+    struct {
+      uint8_t DATA[4095];
+      uint16_t LEN;
+      uint32_t ID;
+    } MESSAGE;
+
+    void Align (void);
+    uint8_t Send (uint16_t Length);
+    uint8_t Received (uint16_t Length);
+
+  public :
+
+    SimBench (SimCAN & Bus, uint16_t KBPS) : BUS(Bus) {
+      for (uint16_t I = 0; I < sizeof(PATTERN); I++) {
+        PATTERN[I] = (uint8_t)((I * 7) + (I >> 8));
+      }
+      DoCAN.SetBuffer (&MESSAGE.ID, &MESSAGE.LEN, MESSAGE.DATA);
+      DoCAN.SetUDSParameter (0x00, 0, 0, 4095);
+      DoCAN.SetTiming (1000000, 5000000);
+      DoCAN.SetCANID (0x785, 0x78D, 0x7DF);
+      DoCAN.Start();
+      if (KBPS != 500) {
+        DoCAN.SetBaudrate(KBPS);                // DriverPCAN Starts at 500 KBPS
+      }
+    }
+
+    uint8_t Run (SimBenchPOINT &Point);
+};
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Align
+ * @class       SimBench (Private)
+ * @brief       Start Every Point on an Idle Bus at a Millisecond Boundary, Independent of Sweep Order
+ * @param []    Nothing
+ * @return      Nothing
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+void SimBench::Align (void) {
+  BUS.RunUntil(((BUS.Now() / 1000000ULL) + 2) * 1000000ULL);
+  BUS.NODE[SimCAN_NODE_TESTER].RX.clear();
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Send
+ * @class       SimBench (Private)
+ * @brief       Tester Request Through ISO_DoCAN::Transmit, Segmented per the Flow Control of the Server
+ * @param [Length]    Payload Length
+ * @return      Zero When Every Frame Is Queued
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t SimBench::Send (uint16_t Length) {
+  for (uint16_t I = 0; I < Length; I++) {
+    MESSAGE.DATA[I] = PATTERN[I];
+  }
+  MESSAGE.LEN = Length;
+  return (DoCAN.Transmit() == DoCAN_TX_COMPLETE) ? 0 : 1;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Received
+ * @class       SimBench (Private)
+ * @brief       Check the Message Reassembled by ISO_DoCAN Against the Pattern
+ * @param [Length]    Expected Length
+ * @return      Zero When Equal
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t SimBench::Received (uint16_t Length) {
+  if (MESSAGE.LEN != Length) {
+    return 1;
+  }
+  for (uint16_t I = 0; I < Length; I++) {
+    if (MESSAGE.DATA[I] != PATTERN[I]) {
+      return 1;
+    }
+  }
+  return 0;
+}
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Run
+ * @class       SimBench (Public)
+ * @brief       Measure One Point of the Sweep
+ * @param [Point]     Direction, Payload, BS and STmin In, Measurements Out
+ * @return      Zero on Success
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t SimBench::Run (SimBenchPOINT &Point) {
+  std::string Direction = Point.DIRECTION;
+  DoCAN.SetUDSParameter (0x00, Point.STMIN, Point.BS, 4095);
+  Align();
+  uint64_t Start = BUS.Now();
+  uint64_t Frames = BUS.STATS.FRAMES;
+  uint64_t Busy = BUS.STATS.BUSY;
+  auto Wall = std::chrono::steady_clock::now();
+  uint8_t Failed = 0;
+
+  if (Direction == "ServerTx") {
+    Sim_ServerTransport(Sim_TransportHold);
+    Failed = Sim_ServerSend(PATTERN, Point.PAYLOAD);
+    Failed = Failed || (DoCAN.Receive(0, 1) != DoCAN_RX_COMPLETE) || Received(Point.PAYLOAD);
+  } else if (Direction == "ServerRx") {
+    Sim_ServerTransport(Sim_TransportHold);
+    Failed = Send(Point.PAYLOAD);
+    const uint8_t * Data = nullptr;
+    uint16_t Length = 0;
+    uint64_t Limit = BUS.Now() + 1000000000ULL;
+    while (!Failed && ((Length = Sim_ServerReceived(&Data)) == 0) && (BUS.Now() < Limit)) {
+      BUS.Step();
+    }
+    Failed = Failed || (Length != Point.PAYLOAD);
+    for (uint16_t I = 0; !Failed && (I < Length); I++) {
+      Failed = (Data[I] != PATTERN[I]);
+    }
+    Sim_ServerRelease();
+  } else {
+    Sim_ServerTransport(Sim_TransportEcho);
+    Failed = Send(Point.PAYLOAD);
+    Failed = Failed || (DoCAN.Receive(0, 1) != DoCAN_RX_COMPLETE) || Received(Point.PAYLOAD);
+  }
+
+  Point.HOST = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Wall).count();
+  Point.LATENCY = (BUS.Now() - Start) / 1000;
+  Point.FRAMES = BUS.STATS.FRAMES - Frames;
+  Point.UTILIZATION = (BUS.Now() > Start) ? (100.0 * (double)(BUS.STATS.BUSY - Busy) / (double)(BUS.Now() - Start)) : 0.0;
+  Point.FAILED = Failed;
+  Sim_ServerRelease();
+  Sim_ServerTransport(Sim_TransportHold);
+  return Failed;
+}
+/* ==================================================================================================== */
+
+
+/* ==================================================================================================== */
+/**
+ * @name        main
+ * @brief       Sweep, CSV Output, Threshold Compare or Write
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+int main (int argc, char **argv) {
+  const char * Output = nullptr;
+  const char * Check = nullptr;
+  const char * Write = nullptr;
+  uint32_t Repetitions = 3, KBPS = 500, Loop = 100;
+  int Option;
+  while ((Option = getopt(argc, argv, "o:c:w:n:b:p:")) != -1) {
+    switch (Option) {
+      case 'o' : { Output = optarg; break; }
+      case 'c' : { Check = optarg; break; }
+      case 'w' : { Write = optarg; break; }
+      case 'n' : { Repetitions = (uint32_t)strtoul(optarg, NULL, 0); break; }
+      case 'b' : { KBPS = (uint32_t)strtoul(optarg, NULL, 0); break; }
+      case 'p' : { Loop = (uint32_t)strtoul(optarg, NULL, 0); break; }
+      default : {
+        fprintf(stderr, "Usage: %s [-o CSV] [-c Thresholds] [-w Thresholds] [-n Repetitions] [-b KBPS]"
+            " [-p LoopMicros]\n", argv[0]);
+        return 2;
+      }
+    }
+  }
+  if ((KBPS == 0) || (Loop == 0) || (Repetitions == 0)) {
+    fprintf(stderr, "Bit Rate, Loop Period and Repetitions Must Be Non Zero\n");
+    return 2;
+  }
+
+  SimCAN Bus(KBPS * 1000, (uint64_t)Loop * 1000);
+  SimPCANBus = &Bus;
+  ISO_DoCAN::SetVirtualClock(&SimPCANNow, &SimPCANWait);
+  Sim_ServerTransport(Sim_TransportHold);
+  SimBench Bench(Bus, (uint16_t)KBPS);
+
+  std::vector<SimBench::SimBenchPOINT> Points;
+  const char * Directions[] = {"ServerTx", "ServerRx", "RoundTrip"};
+  for (const char * Direction : Directions) {
+    for (uint16_t Payload : SimBenchPayload) {
+      for (uint8_t BS : SimBenchBlock) {
+        for (uint32_t STmin : SimBenchSTmin) {
+          if ((std::string(Direction) == "ServerRx") && (BS || STmin)) {
+            continue;                           // Server Flow Control Is Fixed, Tester Values Do Not Apply
+          }
+          Points.push_back({Direction, Payload, BS, STmin, 0, 0, 0.0, 0, 0});
+        }
+      }
+    }
+  }
+
+  uint8_t Failed = 0;
+  for (SimBench::SimBenchPOINT &Point : Points) {
+    SimBench::SimBenchPOINT Best = Point;
+    for (uint32_t R = 0; R < Repetitions; R++) {
+      SimBench::SimBenchPOINT Trial = Point;
+      Bench.Run(Trial);
+      if ((R == 0) || (Trial.HOST < Best.HOST)) {
+        uint8_t Earlier = Best.FAILED;
+        Best = Trial;
+        Best.FAILED |= Earlier;
+      }
+    }
+    Point = Best;
+    Failed |= Point.FAILED;
+  }
+
+  FILE * CSV = Output ? fopen(Output, "w") : stdout;
+  if (CSV == nullptr) {
+    fprintf(stderr, "Cannot Write %s\n", Output);
+    return 2;
+  }
+  fprintf(CSV, "direction,payload,bs,stmin_us,baud,loop_us,latency_us,bytes_per_s,frames,bus_util_pct,host_ns,status\n");
+  for (const SimBench::SimBenchPOINT &Point : Points) {
+    double Rate = Point.LATENCY ? (Point.PAYLOAD * 1e6 / (double)Point.LATENCY) : 0.0;
+    fprintf(CSV, "%s,%u,%u,%u,%u,%u,%llu,%.0f,%llu,%.3f,%llu,%s\n", Point.DIRECTION, Point.PAYLOAD, Point.BS,
+        Point.STMIN, KBPS * 1000, Loop, (unsigned long long)Point.LATENCY, Rate, (unsigned long long)Point.FRAMES,
+        Point.UTILIZATION, (unsigned long long)Point.HOST, Point.FAILED ? "FAILED" : "OK");
+  }
+  if (Output) {
+    fclose(CSV);
+  }
+
+  if (Write) {
+    FILE * File = fopen(Write, "w");
+    if (File == nullptr) {
+      fprintf(stderr, "Cannot Write %s\n", Write);
+      return 2;
+    }
+    fprintf(File, "# DoCAN Transport Regression Thresholds (make -C Simulation bench)\n");
+    fprintf(File, "# Latency Is Virtual and Exact, Host Time Allows x%d Plus %d ns for Machine Noise\n",
+        SimBench_HOSTFACTOR, SimBench_HOSTSLACK);
+    fprintf(File, "# Bus %u bit/s, Server Loop %u us\n", KBPS * 1000, Loop);
+    fprintf(File, "direction,payload,bs,stmin_us,max_latency_us,max_host_ns\n");
+    for (const SimBench::SimBenchPOINT &Point : Points) {
+      fprintf(File, "%s,%u,%u,%u,%llu,%llu\n", Point.DIRECTION, Point.PAYLOAD, Point.BS, Point.STMIN,
+          (unsigned long long)Point.LATENCY,
+          (unsigned long long)((Point.HOST * SimBench_HOSTFACTOR) + SimBench_HOSTSLACK));
+    }
+    fclose(File);
+  }
+
+  if (Check) {
+    FILE * File = fopen(Check, "r");
+    if (File == nullptr) {
+      fprintf(stderr, "Cannot Read %s\n", Check);
+      return 2;
+    }
+    std::map<std::string, std::pair<uint64_t, uint64_t>> Limits;
+    char Line[256], Direction[32];
+    unsigned Payload, BS, STmin;
+    unsigned long long Latency, Host;
+    while (fgets(Line, sizeof(Line), File)) {
+      if (sscanf(Line, "%31[^,],%u,%u,%u,%llu,%llu", Direction, &Payload, &BS, &STmin, &Latency, &Host) == 6) {
+        Limits[std::string(Direction) + "," + std::to_string(Payload) + "," + std::to_string(BS) + "," +
+            std::to_string(STmin)] = {Latency, Host};
+      }
+    }
+    fclose(File);
+    uint32_t Regressions = 0;
+    for (const SimBench::SimBenchPOINT &Point : Points) {
+      std::string Key = std::string(Point.DIRECTION) + "," + std::to_string(Point.PAYLOAD) + "," +
+          std::to_string(Point.BS) + "," + std::to_string(Point.STMIN);
+      auto Limit = Limits.find(Key);
+      if (Limit == Limits.end()) {
+        continue;                               // New Point, No Threshold Yet
+      }
+      if ((Point.LATENCY > Limit->second.first) || (Point.HOST > Limit->second.second)) {
+        fprintf(stderr, "Regression %s : Latency %llu us (Max %llu), Host %llu ns (Max %llu)\n", Key.c_str(),
+            (unsigned long long)Point.LATENCY, (unsigned long long)Limit->second.first,
+            (unsigned long long)Point.HOST, (unsigned long long)Limit->second.second);
+        Regressions++;
+      }
+    }
+    fprintf(stderr, "%zu Points, %u Regressions Against %s\n", Points.size(), Regressions, Check);
+    Failed |= (Regressions != 0);
+  }
+  if (Failed) {
+    fprintf(stderr, "Benchmark FAILED\n");
+  }
+  return Failed;
+}
+/* ==================================================================================================== */
@@ -0,0 +1,248 @@
+/* ==================================================================================================== */
+/*
+ *  main.cpp
+ *  Unified Diagnostics Services on CAN (UDSonCAN) - Virtual Time Simulation
+ *    Server Library (UDS_MainApp) and Client ISO_DoCAN on One Simulated CAN Bus
+ *    Long Tester Sessions Run in Seconds, Bus Utilization Is Counted Bit by Bit
+ *
+ *  Usage: UDSonSim [-b KBPS] [-t Seconds] [-p LoopMicros] [-s STminMicros] [-k BlockSize]
+ *                  [-g GapMillis] [-l KBPS]
+ *    -b  Bus Bit Rate at Start (Default 500)
+ *    -t  Length of the Extended Session Scenario in Virtual Seconds (Default 600)
+ *    -p  Server Main Loop Period in MicroSeconds (Default 100)
+ *    -s  Tester STmin in Flow Control, MicroSeconds (Default 0)
+ *    -k  Tester Block Size in Flow Control (Default 0)
+ *    -g  Tester Pause Between Requests in MilliSeconds (Default 0)
+ *    -l  Switch the Link to This Bit Rate With LinkControl (0x87) After Entering Extended Session
+ */
+/* ==================================================================================================== */
+
+#include <unistd.h>
+#include <stdlib.h>
+#include "UDS.hpp"
+#include "SimPCAN.hpp"
+
+#define SimTester_TESTERPRESENT           2000
+#define SimTester_S3                      5000
+
+
+
+/* ==================================================================================================== */
+/**
+ * @class       SimTester
+ * @brief       Request and Response Loop Over ISO_DoCAN, as ISO_UDS::Exchange Does It
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+class SimTester {
+  public :
+    ISO_DoCAN DoCAN;
+
+    struct {
+      uint8_t DATA[4095];
+      uint16_t LEN;
+      uint32_t ID;
+    } MESSAGE;
+
+    struct {
+      uint64_t REQUESTS;
+      uint64_t FAILURES;
+      uint64_t BYTES;
+      uint64_t LATENCY_TOTAL;
+      uint64_t LATENCY_MAX;
+    } STATS;
+
+    SimTester (uint32_t STMin, uint8_t Block) {
+      STATS = {};
+      DoCAN.SetBuffer (&MESSAGE.ID, &MESSAGE.LEN, MESSAGE.DATA);
+      DoCAN.SetUDSParameter (0x00, STMin, Block, 4095);
+      DoCAN.SetTiming (1000000, 5000000);
+      DoCAN.SetCANID (0x785, 0x78D, 0x7DF);
+      DoCAN.Start();
+    }
+
+    uint8_t Exchange (const uint8_t * Request, uint16_t Length);
+};
+/* ==================================================================================================== */
+
+/* ==================================================================================================== */
+/**
+ * @name        Exchange
+ * @class       SimTester (Public)
+ * @brief       Send a Single Frame Request and Wait for the Final Response in MESSAGE
+ * @param [Request]     Request Bytes
+ * @param [Length]      Request Length
+ * @return      Zero on Positive Response, NRC on Negative Response, 0xFF on DoCAN Failure
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+uint8_t SimTester::Exchange (const uint8_t * Request, uint16_t Length) {
+  uint8_t SID = Request[0];
+  for (uint16_t I = 0; I < Length; I++) {
+    MESSAGE.DATA[I] = Request[I];
+  }
+  MESSAGE.LEN = Length;
+  uint64_t Start = DoCAN.MicroClock();
+  STATS.REQUESTS++;
+
+  uint8_t Status = 0xFF;
+  if (DoCAN.Transmit() == DoCAN_TX_COMPLETE) {
+    uint8_t Time = 1;
+    while (DoCAN.Receive(0, Time) == DoCAN_RX_COMPLETE) {
+      if ((MESSAGE.LEN == 3) && (MESSAGE.DATA[0] == 0x7F) && (MESSAGE.DATA[1] == SID)) {
+        if (MESSAGE.DATA[2] == 0x78) {
+          Time = 0;
+          continue;
+        }
+        Status = MESSAGE.DATA[2];
+        break;
+      }
+      if ((MESSAGE.LEN > 0) && (MESSAGE.DATA[0] == (SID | 0x40))) {
+        Status = 0;
+        break;
+      }
+    }
+  }
+
+  uint64_t Latency = DoCAN.MicroClock() - Start;
+  if (Status) {
+    STATS.FAILURES++;
+    return Status;
+  }
+  STATS.BYTES += Length + MESSAGE.LEN;
+  STATS.LATENCY_TOTAL += Latency;
+  if (Latency > STATS.LATENCY_MAX) {
+    STATS.LATENCY_MAX = Latency;
+  }
+  return 0;
+}
+/* ==================================================================================================== */
+
+
+/* ==================================================================================================== */
+/**
+ * @name        main
+ * @brief       Default Session Check, Extended Session Under Load, S3 Expiry Check, Report
+ */
+/* ---------------------------------------------------------------------------------------------------- */
+int main (int argc, char **argv) {
+  uint32_t KBPS = 500, Seconds = 600, Loop = 100, STMin = 0, Gap = 0, Link = 0;
+  uint8_t Block = 0;
+  int Option;
+  while ((Option = getopt(argc, argv, "b:t:p:s:k:g:l:")) != -1) {
+    switch (Option) {
+      case 'b' : { KBPS = (uint32_t)strtoul(optarg, NULL, 0); break; }
+      case 't' : { Seconds = (uint32_t)strtoul(optarg, NULL, 0); break; }
+      case 'p' : { Loop = (uint32_t)strtoul(optarg, NULL, 0); break; }
+      case 's' : { STMin = (uint32_t)strtoul(optarg, NULL, 0); break; }
+      case 'k' : { Block = (uint8_t)strtoul(optarg, NULL, 0); break; }
+      case 'g' : { Gap = (uint32_t)strtoul(optarg, NULL, 0); break; }
+      case 'l' : { Link = (uint32_t)strtoul(optarg, NULL, 0); break; }
+      default : {
+        fprintf(stderr, "Usage: %s [-b KBPS] [-t Seconds] [-p LoopMicros] [-s STminMicros] [-k BlockSize]"
+            " [-g GapMillis] [-l KBPS]\n", argv[0]);
+        return 2;
+      }
+    }
+  }
+  if ((KBPS == 0) || (Loop == 0)) {
+    fprintf(stderr, "Bit Rate and Loop Period Must Be Non Zero\n");
+    return 2;
+  }
+
+  auto WallStart = std::chrono::steady_clock::now();
+  SimCAN Bus(KBPS * 1000, (uint64_t)Loop * 1000);
+  SimPCANBus = &Bus;
+  ISO_DoCAN::SetVirtualClock(&SimPCANNow, &SimPCANWait);
+
+  SimTester Tester(STMin, Block);
+  if (KBPS != 500) {
+    Tester.DoCAN.SetBaudrate(KBPS);             // DriverPCAN Starts at 500 KBPS
+  }
+  uint8_t Failed = 0;
+
+  const uint8_t ReadSession[] = {0x22, 0xF1, 0x86};
+  const uint8_t Extended[] = {0x10, 0x03};
+  const uint8_t Present[] = {0x3E, 0x00};
+  const uint8_t ReadBlock[] = {0x22, 0x02, 0x00};
+  uint64_t Reads = 0, Presents = 0;
+
+  if (Tester.Exchange(ReadSession, sizeof(ReadSession)) || (Tester.MESSAGE.DATA[3] != 0x01)) {
+    Failed = 1;
+  }
+  if (Tester.Exchange(Extended, sizeof(Extended))) {
+    Failed = 1;
+  }
+  if (Link) {
+    uint8_t Fixed = (Link == 125) ? 0x10 : (Link == 250) ? 0x11 : (Link == 500) ? 0x12 : (Link == 1000) ? 0x13 : 0x00;
+    const uint8_t Verify[] = {0x87, 0x01, Fixed};
+    const uint8_t Transition[] = {0x87, 0x03};
+    if (Tester.Exchange(Verify, sizeof(Verify)) || Tester.Exchange(Transition, sizeof(Transition)) ||
+          Tester.DoCAN.SetBaudrate(Link)) {
+      Failed = 1;
+    }
+  }
+
+  uint64_t End = Bus.Now() + ((uint64_t)Seconds * 1000000000ULL);
+  uint64_t NextPresent = Bus.Now();
+  while (!Failed && (Bus.Now() < End)) {
+    if (Bus.Now() >= NextPresent) {
+      Failed |= (Tester.Exchange(Present, sizeof(Present)) != 0);
+      NextPresent += (uint64_t)SimTester_TESTERPRESENT * 1000000ULL;
+      Presents++;
+    } else {
+      Failed |= (Tester.Exchange(ReadBlock, sizeof(ReadBlock)) != 0);
+      Reads++;
+    }
+    if (Gap) {
+      Tester.DoCAN.MilliDelay(Gap);
+    }
+  }
+
+  Tester.DoCAN.MilliDelay(SimTester_S3 + 1000);  // Tester Silent Past S3, Server Falls Back to Default
+  if (Link) {
+    Tester.DoCAN.SetBaudrate(KBPS);
+  }
+  uint8_t Session = Sim_ServerSession();
+  if (Tester.Exchange(ReadSession, sizeof(ReadSession)) || (Tester.MESSAGE.DATA[3] != 0x01)) {
+    Failed = 1;
+  }
+  if (Link && !Failed) {                        // Default Session Request on the Switched Link, Answered Before the Revert
+    uint8_t Fixed = (Link == 125) ? 0x10 : (Link == 250) ? 0x11 : (Link == 500) ? 0x12 : (Link == 1000) ? 0x13 : 0x00;
+    const uint8_t Verify[] = {0x87, 0x01, Fixed};
+    const uint8_t Transition[] = {0x87, 0x03};
+    const uint8_t Default[] = {0x10, 0x01};
+    if (Tester.Exchange(Extended, sizeof(Extended)) || Tester.Exchange(Verify, sizeof(Verify)) ||
+          Tester.Exchange(Transition, sizeof(Transition)) || Tester.DoCAN.SetBaudrate(Link) ||
+          Tester.Exchange(Default, sizeof(Default)) || Tester.DoCAN.SetBaudrate(KBPS) ||
+          Tester.Exchange(ReadSession, sizeof(ReadSession)) || (Tester.MESSAGE.DATA[3] != 0x01)) {
+      Failed = 1;
+    }
+  }
+
+  double Wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - WallStart).count();
+  double Virtual = (double)Bus.Now() / 1e9;
+  uint64_t Answered = Tester.STATS.REQUESTS - Tester.STATS.FAILURES;
+  printf("\n\nVirtual Time       %12.3f s\n", Virtual);
+  printf("Wall Time          %12.3f s (x%.0f)\n", Wall, (Wall > 0) ? (Virtual / Wall) : 0.0);
+  printf("Requests           %12llu (%llu Block Reads, %llu Tester Present, %llu Failed)\n",
+      (unsigned long long)Tester.STATS.REQUESTS, (unsigned long long)Reads, (unsigned long long)Presents,
+      (unsigned long long)Tester.STATS.FAILURES);
+  printf("Latency Avg / Max  %12.1f / %llu us\n",
+      Answered ? ((double)Tester.STATS.LATENCY_TOTAL / Answered) : 0.0, (unsigned long long)Tester.STATS.LATENCY_MAX);
+  printf("UDS Throughput     %12.0f Bytes/s\n", (Virtual > 0) ? (Tester.STATS.BYTES / Virtual) : 0.0);
+  printf("Frames             %12llu (Server %llu, Tester %llu)\n", (unsigned long long)Bus.STATS.FRAMES,
+      (unsigned long long)Bus.NODE[SimCAN_NODE_SERVER].FRAMES, (unsigned long long)Bus.NODE[SimCAN_NODE_TESTER].FRAMES);
+  printf("Bits               %12llu (%llu Stuff)\n", (unsigned long long)Bus.STATS.BITS,
+      (unsigned long long)Bus.STATS.STUFF);
+  printf("Bus Busy           %12.6f s\n", (double)Bus.STATS.BUSY / 1e9);
+  printf("Bus Utilization    %12.3f %%\n", Bus.Utilization());
+  printf("Bus Errors         %12llu\n", (unsigned long long)Bus.STATS.ERRORS);
+  printf("Server Session     %12s after S3\n", (Session == 0x01) ? "Default" : "NOT DEFAULT");
+  printf("Events             %12llu\n", (unsigned long long)Bus.STATS.EVENTS);
+  if (Sim_ServerDropped()) {
+    printf("Server FIFO Overflow %10u\n", Sim_ServerDropped());
+    Failed = 1;
+  }
+  printf("%s\n", Failed ? "FAILED" : "PASSED");
+  return Failed;
+}
+/* ==================================================================================================== */